@@ -5139,7 +5139,8 @@ Editor::reset_point_selection ()
 {
 	for (PointSelection::iterator i = selection->points.begin(); i != selection->points.end(); ++i) {
 		ARDOUR::AutomationList::iterator j = (*i)->model ();
-		(*j)->value = (*i)->line().the_list()->descriptor ().normal;
+		boost::shared_ptr<ARDOUR::AutomationList> al = (*i)->line().the_list();
+		al->modify (j, (*j)->when, al->descriptor ().normal);
 	}
 }
 
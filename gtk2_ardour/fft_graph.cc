@@ -33,6 +33,8 @@
 
 #include "pbd/stl_delete.h"
 
+#include "audiographer/general/fft_plan_cache.h"
+
 #include <math.h>
 
 #include "fft_graph.h"
@@ -49,6 +51,7 @@ FFTGraph::FFTGraph (int windowSize)
 {
 	_logScale = 0;
 
+	_plan     = 0;
 	_in       = 0;
 	_out      = 0;
 	_hanning  = 0;
@@ -91,14 +94,16 @@ FFTGraph::setWindowSize_internal (int windowSize)
 
 	_windowSize = windowSize;
 	_dataSize = windowSize / 2;
+	/* the plan is owned by the cache */
+	_plan = 0;
+
 	if (_in != 0) {
-		fftwf_destroy_plan (_plan);
-		free (_in);
+		fftwf_free (_in);
 		_in = 0;
 	}
 
 	if (_out != 0) {
-		free (_out);
+		fftwf_free (_out);
 		_out = 0;
 	}
 
@@ -143,7 +148,7 @@ FFTGraph::setWindowSize_internal (int windowSize)
 	for (unsigned int i = 0; i < _dataSize; i++) {
 		_logScale[i] = 0;
 	}
-	_plan = fftwf_plan_r2r_1d (_windowSize, _in, _out, FFTW_R2HC, FFTW_MEASURE);
+	_plan = AudioGrapher::FFTPlanCache::r2hc (_windowSize);
 }
 
 FFTGraph::~FFTGraph ()
@@ -68,7 +68,7 @@ FFTResult::analyzeWindow(float *window)
 		_in[i] = window[i] * _hanning[i];
 	}
 
-	fftwf_execute(_graph->_plan);
+	fftwf_execute_r2r (_graph->_plan, _in, _out);
 
 	// calculate signal power per bin
 	float b = _out[0] * _out[0];
@@ -29,6 +29,7 @@
 #include "ardour/parameter_descriptor.h"
 
 #include "canvas/container.h"
+#include "canvas/note_array.h"
 #include "canvas/polygon.h"
 #include "canvas/rectangle.h"
 #include "canvas/debug.h"
@@ -190,6 +191,7 @@ MidiGhostRegion::MidiGhostRegion(MidiRegionView& rv,
                                  double initial_unit_pos)
 	: GhostRegion(rv, tv.ghost_group(), tv, source_tv, initial_unit_pos)
 	, _note_group (new ArdourCanvas::Container (group))
+	, _dense_notes (0)
 	,  parent_mrv (rv)
 	, _optimization_iterator(events.end())
 {
@@ -213,6 +215,7 @@ MidiGhostRegion::MidiGhostRegion(MidiRegionView& rv,
 	               source_tv,
 	               initial_unit_pos)
 	, _note_group (new ArdourCanvas::Container (group))
+	, _dense_notes (0)
 	, parent_mrv (rv)
 	, _optimization_iterator(events.end())
 {
@@ -290,6 +293,10 @@ MidiGhostRegion::set_colors()
 		it->second->item->set_fill_color (UIConfiguration::instance().color_mod((*it).second->event->base_color(), "ghost track midi fill"));
 		it->second->item->set_outline_color (_outline);
 	}
+
+	if (_dense_notes) {
+		redisplay_dense ();
+	}
 }
 
 static double
@@ -320,6 +327,11 @@ MidiGhostRegion::update_contents_height ()
 		return;
 	}
 
+	if (_dense_notes) {
+		redisplay_dense ();
+		return;
+	}
+
 	double const h = note_height(trackview, mv);
 
 	for (EventList::iterator it = events.begin(); it != events.end(); ++it) {
@@ -377,6 +389,7 @@ void
 MidiGhostRegion::clear_events()
 {
 	_note_group->clear (true);
+	_dense_notes = 0;
 	events.clear ();
 	_optimization_iterator = events.end();
 }
@@ -468,6 +481,53 @@ MidiGhostRegion::redisplay_model ()
 	}
 }
 
+/** Display all notes of the parent MidiRegionView using a single NoteArray,
+ *  used while the parent does the same (see MidiRegionView::want_dense_display()).
+ */
+void
+MidiGhostRegion::redisplay_dense ()
+{
+	MidiStreamView* mv = midi_view();
+
+	if (!mv) {
+		return;
+	}
+
+	if (!_dense_notes) {
+		_dense_notes = new ArdourCanvas::NoteArray (_note_group);
+		CANVAS_DEBUG_NAME (_dense_notes, "ghost dense notes");
+	}
+
+	double const h = note_height(trackview, mv);
+	Gtkmm2ext::SVAModifier const fill_mod = UIConfiguration::instance().modifier ("ghost track midi fill");
+
+	ArdourCanvas::NoteArray::Entries entries;
+
+	{
+		MidiModel::ReadLock lock (parent_mrv._model->read_lock());
+		MidiModel::Notes& notes (parent_mrv._model->notes());
+
+		entries.reserve (notes.size());
+
+		for (MidiModel::Notes::const_iterator n = notes.begin(); n != notes.end(); ++n) {
+			bool visible;
+
+			if (!parent_mrv.note_in_region_range (*n, visible) || !visible) {
+				continue;
+			}
+
+			ArdourCanvas::Rect r (parent_mrv.sustained_rect (*n));
+			r.y0 = note_y(trackview, mv, (*n)->note());
+			r.y1 = r.y0 + h;
+
+			Gtkmm2ext::Color const fill = Gtkmm2ext::HSV (NoteBase::base_color (parent_mrv, **n)).mod (fill_mod).color ();
+			entries.push_back (ArdourCanvas::NoteArray::Entry (r, fill, _outline));
+		}
+	}
+
+	_dense_notes->set (entries);
+}
+
 /** Given a note in our parent region (ie the actual MidiRegionView), find our
  *  representation of it.
  *  @return Our Event, or 0 if not found.
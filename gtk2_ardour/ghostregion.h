@@ -33,6 +33,10 @@ namespace ArdourWaveView {
 	class WaveView;
 }
 
+namespace ArdourCanvas {
+	class NoteArray;
+}
+
 class NoteBase;
 class Note;
 class Hit;
@@ -123,10 +127,12 @@ public:
 	void remove_note (NoteBase*);
 
 	void redisplay_model();
+	void redisplay_dense();
 	void clear_events();
 
 private:
 	ArdourCanvas::Container* _note_group;
+	ArdourCanvas::NoteArray* _dense_notes;
 	Gtkmm2ext::Color _outline;
 	ArdourCanvas::Rectangle* _tmp_rect;
 	ArdourCanvas::Polygon* _tmp_poly;
@@ -56,6 +56,7 @@
 #include "evoral/midi_util.h"
 
 #include "canvas/debug.h"
+#include "canvas/note_array.h"
 #include "canvas/text.h"
 
 #include "automation_region_view.h"
@@ -115,6 +116,7 @@ MidiRegionView::MidiRegionView (ArdourCanvas::Container*      parent,
 	, _region_relative_time_converter_double(r->session().tempo_map(), r->position())
 	, _active_notes(0)
 	, _note_group (new ArdourCanvas::Container (group))
+	, _dense_notes (0)
 	, _note_diff_command (0)
 	, _ghost_note(0)
 	, _step_edit_cursor (0)
@@ -131,6 +133,7 @@ MidiRegionView::MidiRegionView (ArdourCanvas::Container*      parent,
 	, _last_event_y (0)
 	, _entered (false)
 	, _entered_note (0)
+	, _dense (false)
 	, _mouse_changed_selection (false)
 {
 	CANVAS_DEBUG_NAME (_note_group, string_compose ("note group for %1", get_item_name()));
@@ -162,6 +165,7 @@ MidiRegionView::MidiRegionView (ArdourCanvas::Container*      parent,
 	, _region_relative_time_converter_double(r->session().tempo_map(), r->position())
 	, _active_notes(0)
 	, _note_group (new ArdourCanvas::Container (group))
+	, _dense_notes (0)
 	, _note_diff_command (0)
 	, _ghost_note(0)
 	, _step_edit_cursor (0)
@@ -178,6 +182,7 @@ MidiRegionView::MidiRegionView (ArdourCanvas::Container*      parent,
 	, _last_event_y (0)
 	, _entered (false)
 	, _entered_note (0)
+	, _dense (false)
 	, _mouse_changed_selection (false)
 {
 	CANVAS_DEBUG_NAME (_note_group, string_compose ("note group for %1", get_item_name()));
@@ -203,6 +208,10 @@ MidiRegionView::parameter_changed (std::string const & p)
 		set_colors ();
 	} else if (p == "use-note-color-for-velocity") {
 		color_handler ();
+	} else if (p == "dense-midi-note-count") {
+		if (_enable_display) {
+			redisplay_model();
+		}
 	}
 }
 
@@ -216,6 +225,7 @@ MidiRegionView::MidiRegionView (const MidiRegionView& other)
 	, _region_relative_time_converter_double(other.region_relative_time_converter_double())
 	, _active_notes(0)
 	, _note_group (new ArdourCanvas::Container (get_canvas_group()))
+	, _dense_notes (0)
 	, _note_diff_command (0)
 	, _ghost_note(0)
 	, _step_edit_cursor (0)
@@ -232,6 +242,7 @@ MidiRegionView::MidiRegionView (const MidiRegionView& other)
 	, _last_event_y (0)
 	, _entered (false)
 	, _entered_note (0)
+	, _dense (false)
 	, _mouse_changed_selection (false)
 {
 	init (false);
@@ -246,6 +257,7 @@ MidiRegionView::MidiRegionView (const MidiRegionView& other, boost::shared_ptr<M
 	, _region_relative_time_converter_double(other.region_relative_time_converter_double())
 	, _active_notes(0)
 	, _note_group (new ArdourCanvas::Container (get_canvas_group()))
+	, _dense_notes (0)
 	, _note_diff_command (0)
 	, _ghost_note(0)
 	, _step_edit_cursor (0)
@@ -262,6 +274,7 @@ MidiRegionView::MidiRegionView (const MidiRegionView& other, boost::shared_ptr<M
 	, _last_event_y (0)
 	, _entered (false)
 	, _entered_note (0)
+	, _dense (false)
 	, _mouse_changed_selection (false)
 {
 	init (true);
@@ -414,6 +427,12 @@ MidiRegionView::enter_notify (GdkEventCrossing* ev)
 	enter_internal (ev->state);
 
 	_entered = true;
+
+	if (_dense && !want_dense_display ()) {
+		/* about to edit, display notes as individual items */
+		redisplay_model ();
+	}
+
 	return false;
 }
 
@@ -467,6 +486,10 @@ MidiRegionView::mouse_mode_changed ()
 			it->second->set_hide_selection (false);
 		}
 	}
+
+	if (_model && _enable_display && _dense != want_dense_display ()) {
+		redisplay_model ();
+	}
 }
 
 void
@@ -915,6 +938,10 @@ MidiRegionView::clear_events ()
 	_patch_changes.clear();
 	_sys_exes.clear();
 	_optimization_iterator = _events.end();
+
+	/* deleted along with the rest of the note group */
+	_dense_notes = 0;
+	_dense = false;
 }
 
 void
@@ -1127,6 +1154,15 @@ MidiRegionView::redisplay_model()
 		return;
 	}
 
+	if (want_dense_display ()) {
+		redisplay_dense ();
+		return;
+	}
+
+	if (_dense) {
+		drop_dense ();
+	}
+
 	for (_optimization_iterator = _events.begin(); _optimization_iterator != _events.end(); ++_optimization_iterator) {
 		_optimization_iterator->second->invalidate();
 	}
@@ -1238,6 +1274,119 @@ MidiRegionView::redisplay_model()
 
 }
 
+/** @return true if notes should be drawn by a single NoteArray item rather
+ * than one canvas item per note.
+ *
+ * This is the case for regions with many notes that are not being edited:
+ * as soon as the region is entered or selected using an internal edit tool
+ * (or has selected notes), notes are displayed as individual items again.
+ */
+bool
+MidiRegionView::want_dense_display () const
+{
+	const uint32_t threshold = UIConfiguration::instance().get_dense_midi_note_count ();
+
+	if (threshold == 0 || _active_notes || midi_view()->note_mode() != Sustained) {
+		return false;
+	}
+
+	if (!_selection.empty () || (trackview.editor().internal_editing() && (_entered || selected ()))) {
+		return false;
+	}
+
+	return _model->n_notes() >= threshold;
+}
+
+void
+MidiRegionView::redisplay_dense ()
+{
+	if (!_dense) {
+
+		/* drop per-note items. patch changes and sysexes are left as-is */
+
+		MidiGhostRegion* gr;
+		for (std::vector<GhostRegion*>::iterator g = ghosts.begin(); g != ghosts.end(); ++g) {
+			if ((gr = dynamic_cast<MidiGhostRegion*>(*g)) != 0) {
+				gr->clear_events();
+			}
+		}
+
+		for (Events::iterator i = _events.begin(); i != _events.end(); ++i) {
+			delete i->second;
+		}
+
+		_events.clear ();
+		_optimization_iterator = _events.end();
+		_entered_note = 0;
+		_channel_selection_scoped_note = 0;
+
+		_dense_notes = new ArdourCanvas::NoteArray (_note_group);
+		CANVAS_DEBUG_NAME (_dense_notes, string_compose ("dense notes for %1", get_item_name()));
+		_dense = true;
+	}
+
+	uint16_t chn_mask = get_selected_channels ();
+	if (get_channel_mode () == ForceChannel) {
+		chn_mask = 0xFFFF;
+	}
+
+	const Gtkmm2ext::Color inactive_ch = UIConfiguration::instance().color ("midi note inactive channel");
+
+	ArdourCanvas::NoteArray::Entries entries;
+
+	{
+		MidiModel::ReadLock lock(_model->read_lock());
+		MidiModel::Notes& notes (_model->notes());
+
+		entries.reserve (notes.size());
+
+		for (MidiModel::Notes::const_iterator n = notes.begin(); n != notes.end(); ++n) {
+			bool visible;
+
+			if (!note_in_region_range (*n, visible) || !visible) {
+				continue;
+			}
+
+			const Gtkmm2ext::Color fill = (chn_mask & (1 << (*n)->channel())) ? NoteBase::base_color (*this, **n) : inactive_ch;
+			entries.push_back (ArdourCanvas::NoteArray::Entry (sustained_rect (*n), fill, NoteBase::calculate_outline (fill)));
+		}
+	}
+
+	_dense_notes->set (entries);
+
+	for (vector<GhostRegion*>::iterator j = ghosts.begin(); j != ghosts.end(); ++j) {
+		MidiGhostRegion* gr = dynamic_cast<MidiGhostRegion*> (*j);
+		if (gr && !gr->trackview.hidden()) {
+			gr->redisplay_dense ();
+		}
+	}
+
+	display_sysexes();
+	display_patch_changes ();
+
+	_marked_for_selection.clear ();
+	_marked_for_velocity.clear ();
+	_pending_note_selection.clear ();
+}
+
+/** Switch back from a NoteArray to per-note items, which are (re-)created
+ * by redisplay_model().
+ */
+void
+MidiRegionView::drop_dense ()
+{
+	MidiGhostRegion* gr;
+	for (std::vector<GhostRegion*>::iterator g = ghosts.begin(); g != ghosts.end(); ++g) {
+		if ((gr = dynamic_cast<MidiGhostRegion*>(*g)) != 0) {
+			gr->clear_events();
+		}
+	}
+
+	delete _dense_notes;
+	_dense_notes = 0;
+	_dense = false;
+}
+
 void
 MidiRegionView::display_patch_changes ()
 {
@@ -1437,6 +1586,17 @@ MidiRegionView::reset_width_dependent_items (double pixel_width)
 	set_step_edit_cursor_width (_step_edit_cursor_width);
 }
 
+void
+MidiRegionView::set_selected (bool yn)
+{
+	RegionView::set_selected (yn);
+
+	/* going back to a dense display is left to the next redisplay */
+	if (yn && _dense && _enable_display && !want_dense_display ()) {
+		redisplay_model ();
+	}
+}
+
 void
 MidiRegionView::set_height (double height)
 {
@@ -1505,6 +1665,10 @@ MidiRegionView::add_ghost (TimeAxisView& tv)
 		ghost->add_note(i->second);
 	}
 
+	if (_dense) {
+		ghost->redisplay_dense ();
+	}
+
 	ghosts.push_back (ghost);
 	enable_display (true);
 	return ghost;
@@ -1655,16 +1819,12 @@ MidiRegionView::update_note (NoteBase* note, bool update_ghost_regions)
 	}
 }
 
-/** Update a canvas note's size from its model note.
- *  @param ev Canvas note to update.
- *  @param update_ghost_regions true to update the note in any ghost regions that we have, otherwise false.
- */
-void
-MidiRegionView::update_sustained (Note* ev, bool update_ghost_regions)
+/** @return the rectangle of a sustained note, in region coordinates */
+ArdourCanvas::Rect
+MidiRegionView::sustained_rect (boost::shared_ptr<NoteType> const & note) const
 {
 	TempoMap& map (trackview.session()->tempo_map());
 	const boost::shared_ptr<ARDOUR::MidiRegion> mr = midi_region();
-	boost::shared_ptr<NoteType> note = ev->note();
 
 	const double session_source_start = _region->quarter_note() - mr->start_beats();
 	const samplepos_t note_start_samples = map.sample_at_quarter_note (note->time().to_double() + session_source_start) - _region->position();
@@ -1703,7 +1863,20 @@ MidiRegionView::update_sustained (Note* ev, bool update_ghost_regions)
 
 	y1 = y0 + std::max(1., floor(note_height()) - 1);
 
-	ev->set (ArdourCanvas::Rect (x0, y0, x1, y1));
+	return ArdourCanvas::Rect (x0, y0, x1, y1);
+}
+
+/** Update a canvas note's size from its model note.
+ *  @param ev Canvas note to update.
+ *  @param update_ghost_regions true to update the note in any ghost regions that we have, otherwise false.
+ */
+void
+MidiRegionView::update_sustained (Note* ev, bool update_ghost_regions)
+{
+	boost::shared_ptr<NoteType> note = ev->note();
+	const ArdourCanvas::Rect r (sustained_rect (note));
+
+	ev->set (r);
 	ev->set_velocity (note->velocity()/127.0);
 
 	if (note->end_time() == std::numeric_limits<Temporal::Beats>::max())  {
@@ -1712,7 +1885,7 @@ MidiRegionView::update_sustained (Note* ev, bool update_ghost_regions)
 			if (old_rect) {
 				/* There is an active note on this key, so we have a stuck
 				   note.  Finish the old rectangle here. */
-				old_rect->set_x1 (x1);
+				old_rect->set_x1 (r.x1);
 				old_rect->set_outline_all ();
 			}
 			_active_notes[note->note()] = ev;
@@ -3603,6 +3776,10 @@ MidiRegionView::midi_channel_mode_changed ()
 		i->second->on_channel_selection_change (mask);
 	}
 
+	if (_dense) {
+		redisplay_dense ();
+	}
+
 	_patch_changes.clear ();
 	display_patch_changes ();
 }
@@ -4049,6 +4226,10 @@ MidiRegionView::color_handler ()
 		i->second->set_selected (i->second->selected()); // will change color
 	}
 
+	if (_dense) {
+		redisplay_dense ();
+	}
+
 	/* XXX probably more to do here */
 }
 
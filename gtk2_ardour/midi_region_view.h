@@ -47,6 +47,10 @@ namespace ARDOUR {
 	class Filter;
 };
 
+namespace ArdourCanvas {
+	class NoteArray;
+};
+
 namespace MIDI {
 	namespace Name {
 		struct PatchPrimaryKey;
@@ -108,6 +112,7 @@ public:
 	                    Temporal::Beats pos, Temporal::Beats len);
 	void step_sustain (Temporal::Beats beats);
 	void set_height (double);
+	void set_selected (bool yn);
 	void apply_note_range(uint8_t lowest, uint8_t highest, bool force=false);
 
 	inline ARDOUR::ColorMode color_mode() const { return midi_view()->color_mode(); }
@@ -491,6 +496,7 @@ public:
 	SysExes                              _sys_exes;
 	Note**                               _active_notes;
 	ArdourCanvas::Container*             _note_group;
+	ArdourCanvas::NoteArray*             _dense_notes;
 	ARDOUR::MidiModel::NoteDiffCommand*  _note_diff_command;
 	NoteBase*                            _ghost_note;
 	double                               _last_ghost_x;
@@ -532,6 +538,7 @@ public:
 	boost::shared_ptr<SysEx> find_canvas_sys_ex (ARDOUR::MidiModel::SysExPtr s);
 
 	void update_note (NoteBase*, bool update_ghost_regions = true);
+	ArdourCanvas::Rect sustained_rect (boost::shared_ptr<NoteType> const &) const;
 	void update_sustained (Note *, bool update_ghost_regions = true);
 	void update_hit (Hit *, bool update_ghost_regions = true);
 
@@ -578,6 +585,13 @@ public:
 	bool      _entered;
 	NoteBase* _entered_note;
 
+	/** true if notes are displayed by _dense_notes rather than _events */
+	bool _dense;
+
+	bool want_dense_display () const;
+	void redisplay_dense ();
+	void drop_dense ();
+
 	bool _mouse_changed_selection;
 
 	Gtkmm2ext::Color _patch_change_outline;
@@ -182,31 +182,37 @@ NoteBase::set_selected(bool selected)
 
 uint32_t
 NoteBase::base_color()
+{
+	return base_color (_region, *_note);
+}
+
+uint32_t
+NoteBase::base_color (MidiRegionView& region, NoteType const& note)
 {
 	using namespace ARDOUR;
 
-	ColorMode mode = _region.color_mode();
+	ColorMode mode = region.color_mode();
 
 	const uint8_t min_opacity = 15;
-	uint8_t       opacity = std::max(min_opacity, uint8_t(_note->velocity() + _note->velocity()));
+	uint8_t       opacity = std::max(min_opacity, uint8_t(note.velocity() + note.velocity()));
 
 	switch (mode) {
 	case TrackColor:
 	{
-		const uint32_t region_color = _region.midi_stream_view()->get_region_color();
+		const uint32_t region_color = region.midi_stream_view()->get_region_color();
 		return UINT_INTERPOLATE (UINT_RGBA_CHANGE_A (region_color, opacity), _selected_col,
 					 0.5);
 	}
 
 	case ChannelColors:
-		return UINT_INTERPOLATE (UINT_RGBA_CHANGE_A (NoteBase::midi_channel_colors[_note->channel()], opacity),
+		return UINT_INTERPOLATE (UINT_RGBA_CHANGE_A (NoteBase::midi_channel_colors[note.channel()], opacity),
 		                          _selected_col, 0.5);
 
 	default:
 		if (UIConfiguration::instance().get_use_note_color_for_velocity()) {
-			return meter_style_fill_color(_note->velocity(), selected());
+			return meter_style_fill_color(note.velocity(), false);
 		} else {
-			const uint32_t region_color = _region.midi_stream_view()->get_region_color();
+			const uint32_t region_color = region.midi_stream_view()->get_region_color();
 			return UINT_INTERPOLATE (UINT_RGBA_CHANGE_A (region_color, opacity), _selected_col,
 			                         0.5);
 		}
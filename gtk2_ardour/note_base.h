@@ -85,6 +85,9 @@ class NoteBase : public sigc::trackable
 
 	uint32_t base_color();
 
+	/** @return the fill color of an unselected note in the given region */
+	static uint32_t base_color (MidiRegionView&, NoteType const&);
+
 	void show_velocity();
 	void hide_velocity();
 
@@ -2320,6 +2320,27 @@ RCOptionEditor::RCOptionEditor ()
 		procs->set_note (string_compose (_("This setting will only take effect when %1 is restarted."), PROGRAM_NAME));
 
 		add_option (_("General"), procs);
+
+		bo = new BoolOption (
+				"graph-work-stealing",
+				_("Use per-thread work queues"),
+				sigc::mem_fun (*_rc_config, &RCConfiguration::get_graph_work_stealing),
+				sigc::mem_fun (*_rc_config, &RCConfiguration::set_graph_work_stealing)
+				);
+		add_option (_("General"), bo);
+		Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(),
+				_("When enabled, each DSP thread keeps the routes it unblocks in its own queue and idle threads steal work from busy ones. This reduces contention and improves cache locality on systems with many cores."));
+
+		SpinOption<uint32_t>* gsu = new SpinOption<uint32_t> (
+				"graph-spin-usecs",
+				_("DSP thread spin time (usec)"),
+				sigc::mem_fun (*_rc_config, &RCConfiguration::get_graph_spin_usecs),
+				sigc::mem_fun (*_rc_config, &RCConfiguration::set_graph_spin_usecs),
+				0, 500, 5, 50
+				);
+		add_option (_("General"), gsu);
+		Gtkmm2ext::UI::instance()->set_tip (gsu->tip_widget(),
+				_("With per-thread work queues, an idle DSP thread looks for work for this long before going to sleep. Larger values reduce wake-up latency at the expense of CPU load."));
 	}
 
 	/* Image cache size */
@@ -2987,6 +3008,27 @@ RCOptionEditor::RCOptionEditor ()
 
 	add_option (_("Audio"), new BufferingOptions (_rc_config));
 
+	SpinOption<uint32_t>* bdt = new SpinOption<uint32_t> (
+		"butler-disk-threads",
+		_("Disk I/O threads"),
+		sigc::mem_fun (*_rc_config, &RCConfiguration::get_butler_disk_threads),
+		sigc::mem_fun (*_rc_config, &RCConfiguration::set_butler_disk_threads),
+		1, 32, 1, 4
+		);
+	add_option (_("Audio"), bdt);
+	Gtkmm2ext::UI::instance()->set_tip (bdt->tip_widget(),
+			_("Number of threads used to refill playback buffers and write captured data. Tracks with the emptiest playback buffers are serviced first. Values larger than 1 are mainly useful with fast (solid state) storage."));
+
+	bo = new BoolOption (
+		"playback-bypass-page-cache",
+		_("Do not cache audio data read for playback"),
+		sigc::mem_fun (*_rc_config, &RCConfiguration::get_playback_bypass_page_cache),
+		sigc::mem_fun (*_rc_config, &RCConfiguration::set_playback_bypass_page_cache)
+		);
+	add_option (_("Audio"), bo);
+	Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(),
+			_("When enabled, the operating system is told to drop audio file data from its cache once it has been read for playback. This is useful for sessions that are much larger than the available memory, where caching would otherwise evict all other data. Only uncompressed files are affected."));
+
 	add_option (_("Audio"), new OptionEditorHeading (_("Denormals")));
 
 	add_option (_("Audio"),
@@ -3079,6 +3121,19 @@ RCOptionEditor::RCOptionEditor ()
 		     sigc::mem_fun (UIConfiguration::instance(), &UIConfiguration::set_sound_midi_notes)
 		     ));
 
+	add_option (_("MIDI"), new OptionEditorHeading (_("Display")));
+
+	SpinOption<uint32_t>* dmn = new SpinOption<uint32_t> (
+		"dense-midi-note-count",
+		_("Draw regions with at least this many notes as a whole"),
+		sigc::mem_fun (UIConfiguration::instance(), &UIConfiguration::get_dense_midi_note_count),
+		sigc::mem_fun (UIConfiguration::instance(), &UIConfiguration::set_dense_midi_note_count),
+		0, 1000000, 100, 1000
+		);
+	add_option (_("MIDI"), dmn);
+	Gtkmm2ext::UI::instance()->set_tip (dmn->tip_widget(),
+			_("Notes of large MIDI regions are drawn together instead of as individual canvas items, which makes scrolling and zooming faster. Individual notes are shown again when such a region is edited. Set to 0 to always use individual notes."));
+
 	add_option (_("MIDI"), new OptionEditorHeading (_("Virtual Keyboard")));
 
 	ComboOption<std::string>* vkeybdlayout = new ComboOption<std::string> (
@@ -3591,6 +3646,26 @@ RCOptionEditor::RCOptionEditor ()
 	Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(),
 					    _("<b>When enabled</b> plugins will be activated when they are added to tracks/busses. When disabled plugins will be left inactive when they are added to tracks/busses"));
 
+	bo = new BoolOption (
+		"sleep-silent-plugins",
+			_("Do not process plugins while their input is silent"),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::get_sleep_silent_plugins),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::set_sleep_silent_plugins)
+			);
+	add_option (_("Plugins"), bo);
+	Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(),
+					    _("<b>When enabled</b> effect plugins are not processed once their input has been silent for longer than the plugin's tail and their output has decayed to silence. Processing resumes as soon as there is signal again. This saves DSP load on silent tracks, but may cut off effects that report a shorter tail than they produce (e.g. freeze or infinite reverb modes)."));
+
+	bo = new BoolOption (
+		"parallel-plugin-load",
+			_("Instantiate plugins in background threads when loading a session"),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::get_parallel_plugin_load),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::set_parallel_plugin_load)
+			);
+	add_option (_("Plugins"), bo);
+	Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(),
+					    _("<b>When enabled</b> LADSPA and LV2 plugins used by a session are instantiated by a pool of worker threads while the rest of the session is being loaded. Other plugin formats are always instantiated by the GUI thread."));
+
 	ComboOption<uint32_t>* lna = new ComboOption<uint32_t> (
 		     "limit-n-automatables",
 		     _("Limit automatable parameters per plugin"),
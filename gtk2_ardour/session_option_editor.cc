@@ -207,6 +207,16 @@ SessionOptionEditor::SessionOptionEditor (Session* s)
 
 	add_option (_("Media"), hf);
 
+	BoolOption* ilc = new BoolOption (
+		"interleaved-capture",
+		_("Record all channels of a track into a single file"),
+		sigc::mem_fun (*_session_config, &SessionConfiguration::get_interleaved_capture),
+		sigc::mem_fun (*_session_config, &SessionConfiguration::set_interleaved_capture)
+		);
+	add_option (_("Media"), ilc);
+	Gtkmm2ext::UI::instance()->set_tip (ilc->tip_widget(),
+			_("When enabled, multi-channel tracks record into one interleaved file instead of one file per channel. This reduces the number of files written concurrently, which helps when recording many channels to spinning disks."));
+
 	add_option (S_("Files|Locations"), new OptionEditorHeading (_("File Locations")));
 
 	SearchPathOption* spo = new SearchPathOption ("audio-search-path", _("Search for audio files in:"),
@@ -38,6 +38,7 @@
 
 #include "pbd/signals.h"
 #include "pbd/pthread_utils.h"
+#include "pbd/semutils.h"
 #include "pbd/stacktrace.h"
 
 #include "ardour/ardour.h"
@@ -307,6 +308,9 @@ class LIBARDOUR_API AudioEngine : public PortManager, public SessionHandlePtr
 	Glib::Threads::Cond       _hw_devicelist_update_condition;
 	Glib::Threads::Mutex      _devicelist_update_lock;
 	gint                      _stop_hw_devicelist_processing;
+	Glib::Threads::Thread*    _resampled_inputs_thread;
+	PBD::Semaphore            _resampled_inputs_sem;
+	gint                      _stop_resampled_inputs_processing;
 	uint32_t                  _start_cnt;
 	uint32_t                  _init_countdown;
 	volatile gint             _pending_playback_latency_callback;
@@ -316,6 +320,9 @@ class LIBARDOUR_API AudioEngine : public PortManager, public SessionHandlePtr
 	void stop_hw_event_processing();
 	void do_reset_backend();
 	void do_devicelist_update();
+	void do_resampled_inputs_update ();
+
+	void request_resampled_inputs_update ();
 
 	typedef std::map<std::string,AudioBackendInfo*> BackendMap;
 	BackendMap _backends;
@@ -45,6 +45,9 @@ public:
 
 	samplecnt_t read (Sample *dst, Sample *mixdown, float *gain_buffer, samplepos_t start, samplecnt_t cnt, uint32_t chan_n=0);
 
+	/** Hint that the given range will be read soon, for all channels */
+	void prefetch (samplepos_t start, samplecnt_t cnt);
+
 	bool destroy_region (boost::shared_ptr<Region>);
 
 protected:
@@ -124,6 +124,9 @@ class LIBARDOUR_API AudioRegion : public Region
 
 	virtual samplecnt_t read_raw_internal (Sample*, samplepos_t, samplecnt_t, int channel) const;
 
+	/** Pass a read-ahead hint for the given range (in session samples) to all sources */
+	void prefetch (samplepos_t position, samplecnt_t cnt) const;
+
 	XMLNode& state ();
 	XMLNode& get_basic_state ();
 	int set_state (const XMLNode&, int version);
@@ -61,6 +61,11 @@ class LIBARDOUR_API AudioSource : virtual public Source,
 	virtual samplecnt_t read (Sample *dst, samplepos_t start, samplecnt_t cnt, int channel=0) const;
 	virtual samplecnt_t write (Sample *src, samplecnt_t cnt);
 
+	/** Hint that the given range will be read soon, so that I/O for it can
+	 * be started asynchronously.
+	 */
+	void prefetch (samplepos_t start, samplecnt_t cnt) const;
+
 	virtual float sample_rate () const = 0;
 
 	virtual void mark_streaming_write_completed (const Lock& lock);
@@ -120,6 +125,7 @@ class LIBARDOUR_API AudioSource : virtual public Source,
 
 	virtual samplecnt_t read_unlocked (Sample *dst, samplepos_t start, samplecnt_t cnt) const = 0;
 	virtual samplecnt_t write_unlocked (Sample *dst, samplecnt_t cnt) = 0;
+	virtual void prefetch_unlocked (samplepos_t /*start*/, samplecnt_t /*cnt*/) const {}
 	virtual std::string construct_peak_filepath (const std::string& audio_path, const bool in_session = false, const bool old_peak_name = false) const = 0;
 
 	virtual int read_peaks_with_fpp (PeakData *peaks,
@@ -149,9 +155,32 @@ class LIBARDOUR_API AudioSource : virtual public Source,
 
 	mutable bool _first_run;
 	mutable double _last_scale;
+	mutable samplecnt_t _last_fpp;
 	mutable off_t _last_map_off;
 	mutable size_t  _last_raw_map_length;
 	mutable boost::scoped_array<PeakData> peak_cache;
+
+	/* Decimated copies of the peakfile (a mipmap pyramid) which are
+	 * used when zoomed out far, so that only a fraction of the peak
+	 * data needs to be mapped and reduced. Level N has
+	 * _FPP * peak_level_factor^N samples per peak.
+	 */
+	static const uint32_t peak_level_factor = 16;
+	static const uint32_t n_peak_levels     = 2;
+
+	enum PeakLevelState {
+		PeakLevelsUnknown,
+		PeakLevelsReady,
+		PeakLevelsUnavailable
+	};
+
+	std::string peak_level_path (std::string const& peakpath, samplecnt_t fpp) const;
+	samplecnt_t peak_level_fpp (double samples_per_visual_peak) const;
+	int         build_peak_levels () const;
+	void        remove_peak_levels () const;
+
+	mutable gint                 _peak_levels_state;
+	mutable Glib::Threads::Mutex _peak_levels_lock;
 };
 
 }
@@ -141,6 +141,13 @@ private:
 	bool operator== (const AutomationList&) const { /* not called */ abort(); return false; }
 	XMLNode* _before; //used for undo of touch start/stop pairs.
 
+	/* serialize_events() re-uses the string as long as the
+	 * modification_count() of the events is unchanged.
+	 */
+	Glib::Threads::Mutex _serialized_lock;
+	std::string          _serialized_events;
+	uint32_t             _serialized_count;
+	bool                 _serialized_valid;
 };
 
 } // namespace
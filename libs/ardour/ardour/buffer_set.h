@@ -89,6 +89,11 @@ public:
 	ChanCount&       count()       { return _count; }
 
 	void silence (samplecnt_t nframes, samplecnt_t offset);
+
+	/** @return true if no buffer carries a signal in [offset, offset + nframes):
+	 * all audio is known silent or below \p threshold and there are no MIDI events.
+	 */
+	bool silent (samplecnt_t nframes, samplecnt_t offset, Sample threshold = 0) const;
 	bool is_mirror() const { return _is_mirror; }
 
 	void set_count(const ChanCount& count) { assert(count <= _available); _count = count; }
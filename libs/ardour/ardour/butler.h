@@ -24,12 +24,14 @@
 #define __ardour_butler_h__
 
 #include <pthread.h>
+#include <vector>
 
 #include <glibmm/threads.h>
 
 #include "pbd/crossthread.h"
 #include "pbd/ringbuffer.h"
 #include "pbd/pool.h"
+#include "pbd/semutils.h"
 #include "ardour/libardour_visibility.h"
 #include "ardour/types.h"
 #include "ardour/session_handle.h"
@@ -38,6 +40,8 @@
 
 namespace ARDOUR {
 
+class Track;
+
 /**
  *  One of the Butler's functions is to clean up (ie delete) unused CrossThreadPools.
  *  When a thread with a CrossThreadPool terminates, its CTP is added to pool_trash.
@@ -68,6 +72,18 @@ class LIBARDOUR_API Butler : public SessionHandleRef
 
 	bool flush_tracks_to_disk_after_locate (boost::shared_ptr<RouteList>, uint32_t& errors);
 
+	/** Cumulative disk I/O statistics, updated by the butler thread */
+	struct DiskStats {
+		DiskStats () : passes (0), tracks (0), usecs (0) {}
+		uint64_t passes; ///< number of refill or flush passes
+		uint64_t tracks; ///< number of tracks serviced
+		uint64_t usecs;  ///< wall-clock time spent in disk passes
+	};
+
+	/** @return disk I/O statistics (approximate while the butler is running) */
+	DiskStats disk_stats () const { return _disk_stats; }
+	void reset_disk_stats () { _disk_stats = DiskStats (); }
+
 	static void* _thread_work(void *arg);
 	void*         thread_work();
 
@@ -94,8 +110,42 @@ private:
 	void empty_pool_trash ();
 	void config_changed (std::string);
 
+	bool refill_tracks (RouteList const&);
 	bool flush_tracks_to_disk_normal (boost::shared_ptr<RouteList>, uint32_t& errors);
 
+	/* Disk I/O worker pool.
+	 *
+	 * Tracks that need servicing are collected into _disk_work, sorted
+	 * by urgency (emptiest playback buffer, or fullest capture buffer first),
+	 * and then processed concurrently by the butler thread itself plus
+	 * (Config->get_butler_disk_threads() - 1) worker threads.
+	 */
+	enum DiskWorkType {
+		DiskRefill,
+		DiskFlush
+	};
+
+	bool run_disk_work (DiskWorkType, uint32_t& errors);
+	void process_disk_work (Sample* sum_buffer, Sample* mixdown_buffer, gain_t* gain_buffer);
+
+	void reset_disk_workers ();
+	void drop_disk_workers ();
+
+	static void* _disk_worker_thread (void*);
+	void disk_worker ();
+
+	std::vector<pthread_t>                  _disk_workers;
+	std::vector<boost::shared_ptr<Track> >  _disk_work;
+	DiskWorkType                            _disk_work_type;
+	gint                                    _disk_workers_active;
+	gint                                    _disk_workers_dirty;
+	gint                                    _disk_work_next;
+	gint                                    _disk_work_outstanding;
+	gint                                    _disk_work_errors;
+	PBD::Semaphore                          _disk_work_sem;
+	PBD::Semaphore                          _disk_done_sem;
+	DiskStats                               _disk_stats;
+
 	/**
 	 * Add request to butler thread request queue
 	 */
@@ -79,6 +79,11 @@ public:
 	 */
 	int do_refill ();
 
+	/** As do_refill(), but using caller-provided working buffers
+	 * (for butler disk worker threads, which cannot share the static ones)
+	 */
+	int do_refill (Sample* sum_buffer, Sample* mixdown_buffer, gain_t* gain_buffer);
+
 	/** For contexts outside the normal butler refill loop (allocates temporary working buffers) */
 	int do_refill_with_alloc (bool partial_fill, bool reverse);
 
@@ -87,6 +92,7 @@ public:
 	/* Working buffers for do_refill (butler thread) */
 	static void allocate_working_buffers ();
 	static void free_working_buffers ();
+	static samplecnt_t working_buffer_size ();
 
 	void adjust_buffering ();
 
@@ -171,7 +177,6 @@ protected:
 
 	private:
 		float _a;
-		float _l;
 		float _g;
 	};
 
@@ -78,6 +78,7 @@ public:
 
 	std::string steal_write_source_name ();
 	int use_new_write_source (DataType, uint32_t n = 0);
+	int use_new_interleaved_write_sources ();
 	void reset_write_sources (bool, bool force = false);
 
 	AlignStyle alignment_style () const { return _alignment_style; }
@@ -0,0 +1,102 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef __ardour_dsp_stats_h__
+#define __ardour_dsp_stats_h__
+
+#include <glib.h>
+#include <stdint.h>
+
+#include "ardour/libardour_visibility.h"
+
+namespace ARDOUR {
+
+/** Lock-free DSP timing statistics.
+ *
+ * Measurements [usec] are added by a single (process) thread and
+ * accumulated over a window of DSPStats::window() updates. When a window
+ * is complete, its min/max/avg and a histogram with 4 buckets per octave
+ * are published to readers via a sequence lock. The writer never blocks.
+ *
+ * Collection is globally disabled by default; callers are expected to
+ * check DSPStats::enabled() before taking timestamps.
+ */
+class LIBARDOUR_API DSPStats
+{
+public:
+	DSPStats ();
+
+	static bool enabled () { return g_atomic_int_get (&_enabled) != 0; }
+	static void set_enabled (bool);
+
+	/** number of updates per published window */
+	static uint32_t window () { return g_atomic_int_get (&_window); }
+	static void set_window (uint32_t);
+
+	static uint64_t now () { return g_get_monotonic_time (); }
+
+	/** add a measurement, process thread only */
+	void update (uint64_t elapsed);
+
+	/** convenience: update (now () - start) */
+	void update_since (uint64_t start) { update (now () - start); }
+
+	/** clear statistics; takes effect with the next update () */
+	void reset () { g_atomic_int_set (&_reset, 1); }
+
+	/** Query the most recently completed window.
+	 * Percentiles are accurate to 1/4 octave (bucket upper bound).
+	 * @return false if no window has been completed since the last reset.
+	 */
+	bool get_stats (uint64_t& min, uint64_t& max, double& avg, uint64_t& p50, uint64_t& p95, uint64_t& p99) const;
+
+	/** @return the value below which \p pct percent of the measurements
+	 * of the last completed window are, or 0 if there is none.
+	 */
+	uint64_t percentile (double pct) const;
+
+private:
+	enum { n_buckets = 100 };
+
+	struct Window {
+		uint64_t cnt;
+		uint64_t min;
+		uint64_t max;
+		uint64_t sum;
+		uint32_t hist[n_buckets];
+	};
+
+	static void     clear (Window&);
+	static int      bucket (uint64_t);
+	static uint64_t bucket_limit (int);
+	static uint64_t percentile (Window const&, double);
+
+	bool snapshot (Window&) const;
+	void publish ();
+
+	Window _cur;       ///< accumulating, writer only
+	Window _published; ///< protected by _seq
+
+	volatile gint _seq;
+	volatile gint _reset;
+
+	static volatile gint _enabled;
+	static volatile gint _window;
+};
+
+} // namespace ARDOUR
+
+#endif /* __ardour_dsp_stats_h__ */
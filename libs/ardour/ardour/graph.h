@@ -30,8 +30,11 @@
 
 #include <boost/shared_ptr.hpp>
 
+#include <glibmm/threads.h>
+
 #include "pbd/mpmc_queue.h"
 #include "pbd/semutils.h"
+#include "pbd/work_stealing_deque.h"
 
 #include "ardour/audio_backend.h"
 #include "ardour/libardour_visibility.h"
@@ -76,6 +79,22 @@ public:
 
 	bool in_process_thread () const;
 
+	/** Per process-thread scheduling statistics (see graph-work-stealing) */
+	struct WorkerStats {
+		WorkerStats () : nodes_run (0), nodes_stolen (0), sleeps (0), busy_usecs (0) {}
+		uint64_t nodes_run;    ///< graph-nodes processed by this thread
+		uint64_t nodes_stolen; ///< of which were taken from another thread's queue
+		uint64_t sleeps;       ///< number of times the thread went idle
+		uint64_t busy_usecs;   ///< time spent processing routes, only while DSPStats::enabled()
+	};
+
+	/** Retrieve statistics of all process threads, index 0 is the main thread.
+	 * Counters are updated without synchronization by each thread and are
+	 * only approximate while the engine is running.
+	 */
+	void worker_stats (std::vector<WorkerStats>&) const;
+	void reset_worker_stats ();
+
 protected:
 	virtual void session_going_away ();
 
@@ -87,11 +106,29 @@ private:
 	void prep ();
 	void dump (int chain) const;
 
+	struct Worker {
+		Worker (size_t i) : id (i), deque (256) {}
+		size_t                            id;
+		PBD::WorkStealingDeque<GraphNode> deque;
+		WorkerStats                       stats;
+	};
+
+	bool find_work (Worker*, GraphNode*&);
+	bool spin_for_work (Worker*, GraphNode*&);
+
 	node_list_t _nodes_rt[2];
 	node_list_t _init_trigger_list[2];
 
 	PBD::MPMCQueue<GraphNode*> _trigger_queue;      ///< nodes that can be processed
-	volatile guint             _trigger_queue_size; ///< number of entries in trigger-queue
+	volatile guint             _trigger_queue_size; ///< number of entries in trigger-queue and all worker deques
+
+	/** Per thread state, index 0 is the main thread */
+	std::vector<Worker*>                 _workers;
+	static Glib::Threads::Private<Worker> _thread_worker;
+
+	/* work-stealing parameters, latched at the start of each cycle */
+	bool   _work_stealing;
+	gint64 _spin_usecs;
 
 	/** Start worker threads */
 	PBD::Semaphore _execution_sem;
@@ -125,6 +162,7 @@ private:
 	volatile int _setup_chain;
 
 	/* parameter caches */
+	uint64_t    _process_cycle_start; ///< DSPStats timestamp, 0 if disabled
 	pframes_t   _process_nframes;
 	samplepos_t _process_start_sample;
 	samplepos_t _process_end_sample;
@@ -25,9 +25,15 @@
 
 #include <vector>
 #include <list>
+#include <map>
+#include <set>
 
 #include <boost/utility.hpp>
 
+#include <glibmm/threads.h>
+
+#include "pbd/id.h"
+
 #include "evoral/Parameter.h"
 
 #include "ardour/ardour.h"
@@ -71,6 +77,12 @@ public:
 
 	~MidiPlaylist ();
 
+	/** Update rendered() to reflect the current state of the playlist.
+	 *
+	 * Only the time ranges affected by region changes since the previous
+	 * call are re-rendered and spliced in; a complete render is done
+	 * when the note mode, channel filter or solo-selection changed.
+	 */
 	void render (MidiChannelFilter*);
 	RTMidiBuffer* rendered();
 
@@ -79,13 +91,16 @@ public:
 	bool destroy_region (boost::shared_ptr<Region>);
 	void _split_region (boost::shared_ptr<Region>, const MusicSample& position, ThawList& thawlist);
 
-	void set_note_mode (NoteMode m) { _note_mode = m; }
+	void set_note_mode (NoteMode m);
+
+	void update_after_tempo_map_change ();
 
 	std::set<Evoral::Parameter> contained_automation();
 
   protected:
 	void remove_dependents (boost::shared_ptr<Region> region);
 	void region_going_away (boost::weak_ptr<Region> region);
+	bool region_changed (const PBD::PropertyChange&, boost::shared_ptr<Region>);
 
   private:
 	void dump () const;
@@ -94,6 +109,33 @@ public:
 	samplepos_t  _read_end;
 
 	RTMidiBuffer _rendered;
+
+	/** state of a region at the time it was last rendered */
+	struct RenderedRegion {
+		boost::weak_ptr<Region> region;
+		samplepos_t             position;
+		samplecnt_t             length;
+		samplepos_t             start;
+		bool                    muted;
+	};
+
+	typedef std::map<PBD::ID, RenderedRegion>      RenderedRegions;
+	typedef std::list<Evoral::Range<samplepos_t> > RenderRanges;
+
+	void merge_rendered (RenderRanges const&, std::vector<RTMidiBuffer*> const&, RTMidiBuffer&);
+
+	RenderedRegions _rendered_regions;
+
+	/* protected by _render_dirty_lock, written by the GUI thread,
+	 * consumed by render() in the butler thread.
+	 */
+	Glib::Threads::Mutex      _render_dirty_lock;
+	std::set<PBD::ID>         _render_dirty_regions;
+	bool                      _render_all_dirty;
+
+	bool      _rendered_solo_selection;
+	int       _rendered_filter_mode;
+	uint16_t  _rendered_filter_mask;
 };
 
 } /* namespace ARDOUR */
@@ -50,9 +50,19 @@ extern "C" {
 LIBARDOUR_API void x86_sse_avx_find_peaks               (float const* buf, uint32_t nsamples, float* min, float* max);
 #endif
 
+LIBARDOUR_API float x86_sse_avx_apply_gain_ramp           (float* buf, uint32_t nframes, float initial, float target, float coeff);
+LIBARDOUR_API void  x86_sse_avx_apply_gain_curve          (float* buf, float const* gain, uint32_t nframes);
+LIBARDOUR_API void  x86_sse_avx_apply_inverse_gain_curve  (float* buf, float const* gain, uint32_t nframes);
+LIBARDOUR_API void  x86_sse_avx_mix_buffers_with_curve    (float* dst, float const* src, float const* gain, uint32_t nframes);
+LIBARDOUR_API void  x86_sse_avx_interleave                (float* dst, float const* src, uint32_t stride, uint32_t nframes);
+LIBARDOUR_API void  x86_sse_avx_deinterleave              (float* dst, float const* src, uint32_t stride, uint32_t nframes, float gain);
+LIBARDOUR_API void  x86_sse_avx_clip_buffer               (float* buf, uint32_t nframes, float limit);
+
 /* FMA functions */
 #ifdef FPU_AVX_FMA_SUPPORT
 LIBARDOUR_API void  x86_fma_mix_buffers_with_gain       (float* dst, float const* src, uint32_t nframes, float gain);
+LIBARDOUR_API float x86_fma_apply_gain_ramp             (float* buf, uint32_t nframes, float initial, float target, float coeff);
+LIBARDOUR_API void  x86_fma_mix_buffers_with_curve      (float* dst, float const* src, float const* gain, uint32_t nframes);
 #endif
 
 /* debug wrappers for SSE functions */
@@ -85,6 +95,14 @@ extern "C" {
 	LIBARDOUR_API void  arm_neon_mix_buffers_no_gain   (float* dst, float const* src, uint32_t nframes);
 	LIBARDOUR_API void  arm_neon_mix_buffers_with_gain (float* dst, float const* src, uint32_t nframes, float gain);
 }
+
+LIBARDOUR_API float arm_neon_apply_gain_ramp           (float* buf, uint32_t nframes, float initial, float target, float coeff);
+LIBARDOUR_API void  arm_neon_apply_gain_curve          (float* buf, float const* gain, uint32_t nframes);
+LIBARDOUR_API void  arm_neon_apply_inverse_gain_curve  (float* buf, float const* gain, uint32_t nframes);
+LIBARDOUR_API void  arm_neon_mix_buffers_with_curve    (float* dst, float const* src, float const* gain, uint32_t nframes);
+LIBARDOUR_API void  arm_neon_interleave                (float* dst, float const* src, uint32_t stride, uint32_t nframes);
+LIBARDOUR_API void  arm_neon_deinterleave              (float* dst, float const* src, uint32_t stride, uint32_t nframes, float gain);
+LIBARDOUR_API void  arm_neon_clip_buffer               (float* buf, uint32_t nframes, float limit);
 #endif
 
 /* non-optimized functions */
@@ -95,5 +113,12 @@ LIBARDOUR_API void  default_apply_gain_to_buffer      (ARDOUR::Sample* buf, ARDO
 LIBARDOUR_API void  default_mix_buffers_with_gain     (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes, float gain);
 LIBARDOUR_API void  default_mix_buffers_no_gain       (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes);
 LIBARDOUR_API void  default_copy_vector               (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes);
+LIBARDOUR_API float default_apply_gain_ramp           (ARDOUR::Sample* buf, ARDOUR::pframes_t nframes, float initial, float target, float coeff);
+LIBARDOUR_API void  default_apply_gain_curve          (ARDOUR::Sample* buf, ARDOUR::gain_t const* gain, ARDOUR::pframes_t nframes);
+LIBARDOUR_API void  default_apply_inverse_gain_curve  (ARDOUR::Sample* buf, ARDOUR::gain_t const* gain, ARDOUR::pframes_t nframes);
+LIBARDOUR_API void  default_mix_buffers_with_curve    (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::gain_t const* gain, ARDOUR::pframes_t nframes);
+LIBARDOUR_API void  default_interleave                (ARDOUR::Sample* dst, ARDOUR::Sample const* src, uint32_t stride, ARDOUR::pframes_t nframes);
+LIBARDOUR_API void  default_deinterleave              (ARDOUR::Sample* dst, ARDOUR::Sample const* src, uint32_t stride, ARDOUR::pframes_t nframes, float gain);
+LIBARDOUR_API void  default_clip_buffer               (ARDOUR::Sample* buf, ARDOUR::pframes_t nframes, float limit);
 
 #endif /* __ardour_mix_h__ */
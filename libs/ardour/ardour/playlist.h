@@ -51,6 +51,7 @@
 #include "ardour/ardour.h"
 #include "ardour/data_type.h"
 #include "ardour/region.h"
+#include "ardour/region_index.h"
 #include "ardour/session_object.h"
 
 namespace ARDOUR {
@@ -177,7 +178,7 @@ public:
 		ripple (at, distance, &el);
 	}
 
-	void update_after_tempo_map_change ();
+	virtual void update_after_tempo_map_change ();
 
 	boost::shared_ptr<Playlist> cut (std::list<AudioRange>&, bool result_is_hidden = true);
 	boost::shared_ptr<Playlist> copy (std::list<AudioRange>&, bool result_is_hidden = true);
@@ -325,6 +326,7 @@ protected:
 
 		~RegionWriteLock ()
 		{
+			playlist->invalidate_region_index ();
 			Glib::Threads::RWLock::WriterLock::release ();
 			if (block_notify) {
 				playlist->release_notifications ();
@@ -398,6 +400,14 @@ protected:
 
 	boost::shared_ptr<RegionList> regions_touched_locked (samplepos_t start, samplepos_t end);
 
+	/** Find regions which have some part within [start, end], in playlist order.
+	 * The caller must hold the region lock. @param rv is cleared first,
+	 * no allocation takes place if it has sufficient capacity.
+	 */
+	void regions_touched_locked (samplepos_t start, samplepos_t end, RegionIndex::RegionVector& rv) const;
+
+	void invalidate_region_index () const;
+
 	void notify_region_removed (boost::shared_ptr<Region>);
 	void notify_region_added (boost::shared_ptr<Region>);
 	void notify_layering_changed ();
@@ -476,6 +486,11 @@ private:
 
 	mutable boost::optional<std::pair<samplepos_t, samplepos_t> > _cached_extent;
 
+	/* lazily rebuilt after regions are added, removed or moved */
+	mutable RegionIndex           _region_index;
+	mutable Glib::Threads::RWLock _region_index_lock;
+	mutable gint                  _region_index_dirty;
+
 	samplepos_t _end_space; //this is used when we are pasting a range with extra space at the end
 	bool        _playlist_shift_active;
 };
@@ -160,6 +160,11 @@ public:
 	/** the max possible latency a plugin will have */
 	virtual samplecnt_t max_latency () const { return 0; }
 
+	/** number of samples the plugin may still produce output for after
+	 * its input became silent, 0 if unknown.
+	 */
+	virtual samplecnt_t signal_tail () const { return 0; }
+
 	virtual int  set_block_size (pframes_t nframes) = 0;
 	virtual bool requires_fixed_sized_buffers () const { return false; }
 	virtual bool inplace_broken () const { return false; }
@@ -442,6 +442,11 @@ private:
 	volatile gint _stat_reset;
 
 	volatile gint _flush;
+
+	/* see ::connect_and_run () */
+	samplecnt_t _silent_input_samples;
+	samplecnt_t _silent_output_samples;
+	bool        _sleeping;
 };
 
 } // namespace ARDOUR
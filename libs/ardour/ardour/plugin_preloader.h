@@ -0,0 +1,102 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef __ardour_plugin_preloader_h__
+#define __ardour_plugin_preloader_h__
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <glib.h>
+#include <glibmm/threads.h>
+
+#include "pbd/id.h"
+
+#include "ardour/libardour_visibility.h"
+#include "ardour/plugin.h"
+#include "ardour/types.h"
+
+class XMLNode;
+
+namespace ARDOUR {
+
+class Session;
+
+/** Instantiate the plugins of a session in background threads.
+ *
+ * While a session is loaded, the plugins referenced by the Routes' state
+ * are instantiated by worker threads, so that this overlaps with loading
+ * sources, regions and playlists. PluginInsert::set_state() later picks up
+ * the instances via Session::preloaded_plugin(); plugin state is restored
+ * there, in the GUI thread, as before.
+ *
+ * LADSPA plugins are instantiated concurrently. LV2 instantiation
+ * accesses the shared lilv world, so all LV2 plugins are instantiated by a
+ * single thread. Other plugin formats require instantiation in the GUI
+ * thread and are not handled here.
+ */
+class LIBARDOUR_API PluginPreloader
+{
+public:
+	PluginPreloader (Session&);
+	~PluginPreloader ();
+
+	/** queue plugins found in the given "Routes" node and start worker threads */
+	void start (XMLNode const& routes);
+
+	/** wait for all workers to complete, reporting progress via BootMessage */
+	void join ();
+
+	/** @return the instance that was prepared for the given plugin-insert
+	 * node, or an empty pointer. The instance is handed out only once.
+	 */
+	PluginPtr take (XMLNode const& processor);
+
+private:
+	struct Job {
+		Job (std::string const& u, PluginType t) : unique_id (u), type (t) {}
+		std::string unique_id;
+		PluginType  type;
+		PluginPtr   plugin;
+	};
+
+	typedef std::vector<Job> Jobs;
+
+	void queue (XMLNode const& processor);
+	void run_parallel ();
+	void run_serial ();
+	void load (Job&);
+
+	Session& _session;
+
+	Jobs _parallel; ///< LADSPA, shared by all parallel workers
+	Jobs _serial;   ///< LV2, one worker
+
+	std::map<PBD::ID, std::pair<Jobs*, size_t> > _by_id;
+
+	std::vector<Glib::Threads::Thread*> _threads;
+
+	volatile gint _next;
+	volatile gint _done;
+
+	Glib::Threads::Mutex _progress_lock;
+	Glib::Threads::Cond  _progress_cond;
+};
+
+} // namespace ARDOUR
+
+#endif /* __ardour_plugin_preloader_h__ */
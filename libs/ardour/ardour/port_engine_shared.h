@@ -105,6 +105,17 @@ class LIBARDOUR_API BackendPort : public ProtoPort
 	void update_connected_latency (bool for_playback);
 
 protected:
+	/** Flat copy of the port's connections for use by the process thread.
+	 * A given table is never modified, connection changes replace it.
+	 */
+	typedef std::vector<BackendPortPtr> ConnectionTable;
+
+	/** Collect the data of an audio input port: silence if the port is not
+	 * connected, the buffer of the source port itself if there is a single
+	 * connection, else the sum of all sources, mixed into \p buf.
+	 */
+	Sample* get_audio_input_buffer (Sample* buf, pframes_t n_samples);
+
 	PortEngineSharedImpl& _backend;
 
 private:
@@ -116,8 +127,12 @@ private:
 	LatencyRange           _playback_latency_range;
 	std::set<BackendPortPtr> _connections;
 
+	SerializedRCUManager<ConnectionTable> _connection_table;
+
 	void store_connection (BackendPortHandle);
 	void remove_connection (BackendPortHandle);
+	void update_connection_table ();
+	Sample* mix_connections (ConnectionTable const&, Sample* buf, pframes_t n_samples);
 
 }; // class BackendPort
 
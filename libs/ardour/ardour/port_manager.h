@@ -28,6 +28,9 @@
 #include <stdint.h>
 
 #include <boost/shared_ptr.hpp>
+#include <boost/utility.hpp>
+
+#include "zita-resampler/vmresampler.h"
 
 #include "pbd/natsort.h"
 #include "pbd/rcu.h"
@@ -41,6 +44,7 @@ namespace ARDOUR {
 
 class PortEngine;
 class AudioBackend;
+class AudioPort;
 class Session;
 
 class CircularSampleBuffer;
@@ -262,8 +266,20 @@ protected:
 	boost::shared_ptr<Port> register_port (DataType type, const std::string& portname, bool input, bool async = false, PortFlags extra_flags = PortFlags (0));
 	void                    port_registration_failure (const std::string& portname);
 
-	/** List of ports to be used between \ref cycle_start() and \ref cycle_end() */
-	boost::shared_ptr<Ports> _cycle_ports;
+	/** List of ports to be used between \ref cycle_start() and \ref cycle_end(),
+	 * valid for the current cycle only (see RCUCycle)
+	 */
+	Ports* _cycle_ports;
+
+	/** Ask for update_resampled_inputs() to be called from a non-realtime
+	 * thread. Called from connect_callback(), must be realtime safe.
+	 */
+	virtual void request_resampled_inputs_update () = 0;
+
+	/** Re-discover the external sources of all audio input ports.
+	 * Not realtime safe.
+	 */
+	void update_resampled_inputs ();
 
 	void silence (pframes_t nframes, Session* s = 0);
 	void silence_outputs (pframes_t nframes);
@@ -298,6 +314,47 @@ private:
 	void save_port_info ();
 	void update_input_ports (bool);
 
+	/** An external (usually physical) audio source port.
+	 *
+	 * During vari-speed every input needs to be resampled. Rather than
+	 * resampling the data once for each Ardour input port, this is done once
+	 * per external source in ::cycle_start(), and shared by all Ardour
+	 * input ports that are exclusively connected to external sources.
+	 */
+	struct ResampledInput : public boost::noncopyable {
+		ResampledInput (PortEngine::PortHandle, pframes_t);
+		~ResampledInput ();
+
+		void set_buffer_size (pframes_t);
+		void cycle_start (pframes_t);
+
+		PortEngine::PortPtr     port;
+		ArdourZita::VMResampler src;
+		Sample*                 data;
+	};
+
+	typedef std::map<PortEngine::PortPtr, boost::shared_ptr<ResampledInput> > ResampledSources;
+	typedef std::map<Port const*, std::vector<ResampledInput*> >             ResampledPorts;
+
+	struct ResampledInputs {
+		ResampledInputs () : generation (0) {}
+
+		ResampledSources sources; ///< keyed by backend port handle
+		ResampledPorts   ports;   ///< sources of each Ardour input port
+		gint             generation; ///< _resampled_inputs_generation the connections were looked up at
+	};
+
+	void drop_resampled_input (boost::shared_ptr<Port>);
+	void resampled_port_cycle_start (AudioPort*, std::vector<ResampledInput*> const&, pframes_t);
+
+	SerializedRCUManager<ResampledInputs> _resampled_inputs;
+	ResampledInputs*                      _cycle_resampled_inputs;
+	ResampledInputs                       _no_resampled_inputs;
+	/** incremented with every connection change, while it differs from
+	 * the published ResampledInputs::generation, nothing is shared.
+	 */
+	gint                                  _resampled_inputs_generation;
+
 	struct PortID {
 		PortID (boost::shared_ptr<AudioBackend>, DataType, bool, std::string const&);
 		PortID (XMLNode const&, bool old_midi_format = false);
@@ -30,6 +30,7 @@
 
 #include "ardour/ardour.h"
 #include "ardour/buffer_set.h"
+#include "ardour/dsp_stats.h"
 #include "ardour/latent.h"
 #include "ardour/session_object.h"
 #include "ardour/libardour_visibility.h"
@@ -157,6 +158,13 @@ class LIBARDOUR_API Processor : public SessionObject, public Automatable, public
 	virtual void set_owner (SessionObject*);
 	SessionObject* owner() const;
 
+	/** time spent in run(), updated by the owning route when DSPStats::enabled() */
+	DSPStats& dsp_stats () { return _dsp_stats; }
+
+	bool get_dsp_stats (uint64_t& min, uint64_t& max, double& avg, uint64_t& p50, uint64_t& p95, uint64_t& p99) const {
+		return _dsp_stats.get_stats (min, max, avg, p50, p95, p99);
+	}
+
 protected:
 	virtual XMLNode& state ();
 	virtual int set_state_2X (const XMLNode&, int version);
@@ -182,6 +190,7 @@ protected:
 	samplecnt_t _capture_offset;
 	samplecnt_t _playback_offset;
 	Location*   _loop_location;
+	DSPStats    _dsp_stats;
 };
 
 } // namespace ARDOUR
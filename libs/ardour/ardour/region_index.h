@@ -0,0 +1,87 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef __libardour_region_index_h__
+#define __libardour_region_index_h__
+
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include "ardour/libardour_visibility.h"
+#include "ardour/types.h"
+
+namespace ARDOUR {
+
+class Region;
+
+/** An interval index over the extent of a list of regions.
+ *
+ * Entries are kept in a vector sorted by position which is treated as an
+ * implicit balanced binary tree (the root of [lo, hi) is at the middle),
+ * and every node is annotated with the largest last sample in its subtree.
+ * Finding the regions that touch a range is logarithmic in the number of
+ * regions per result, and does not allocate if the result vector has
+ * sufficient capacity.
+ *
+ * The index is not updated in place, Playlist rebuilds it lazily after
+ * its regions changed.
+ */
+class LIBARDOUR_API RegionIndex
+{
+public:
+	typedef std::vector<boost::shared_ptr<Region> > RegionVector;
+
+	void clear ();
+	void rebuild (RegionList const&);
+
+	/** Append all regions that overlap [start, end] (inclusive) to @param result.
+	 * Regions are appended in the order of the RegionList that the index was
+	 * built from (for a position-sorted list, ordered by position).
+	 */
+	void find_touched (samplepos_t start, samplepos_t end, RegionVector& result) const;
+
+	size_t size () const { return _entries.size (); }
+
+private:
+	struct Entry {
+		Entry (boost::shared_ptr<Region> const&, uint32_t order);
+
+		samplepos_t               first;
+		samplepos_t               last;
+		samplepos_t               max_last; ///< largest last sample in the subtree rooted here
+		uint32_t                  order;    ///< index in the RegionList
+		boost::shared_ptr<Region> region;
+	};
+
+	struct EntrySorter {
+		bool operator() (Entry const& a, Entry const& b) const {
+			if (a.first != b.first) {
+				return a.first < b.first;
+			}
+			return a.order < b.order;
+		}
+	};
+
+	samplepos_t build (size_t lo, size_t hi);
+	void query (size_t lo, size_t hi, samplepos_t start, samplepos_t end, RegionVector& result) const;
+
+	std::vector<Entry> _entries;
+};
+
+} /* namespace */
+
+#endif /* __libardour_region_index_h__ */
@@ -43,6 +43,7 @@
 #include "pbd/destructible.h"
 
 #include "ardour/ardour.h"
+#include "ardour/dsp_stats.h"
 #include "ardour/gain_control.h"
 #include "ardour/instrument_info.h"
 #include "ardour/io.h"
@@ -246,6 +247,23 @@ public:
 
 	boost::shared_ptr<AutomationControl> automation_control_recurse (PBD::ID const & id) const;
 
+	/* DSP timing, collected when DSPStats::enabled() */
+
+	/** time spent in process_output_buffers() */
+	DSPStats& dsp_stats () { return _dsp_stats; }
+	/** time from the start of the process-graph cycle until this route is processed */
+	DSPStats& graph_wait_stats () { return _graph_wait_stats; }
+
+	bool get_dsp_stats (uint64_t& min, uint64_t& max, double& avg, uint64_t& p50, uint64_t& p95, uint64_t& p99) const {
+		return _dsp_stats.get_stats (min, max, avg, p50, p95, p99);
+	}
+	bool get_graph_wait_stats (uint64_t& min, uint64_t& max, double& avg, uint64_t& p50, uint64_t& p95, uint64_t& p99) const {
+		return _graph_wait_stats.get_stats (min, max, avg, p50, p95, p99);
+	}
+
+	/** reset route, graph-wait and processor statistics */
+	void reset_dsp_stats ();
+
 	/* special processors */
 
 	boost::shared_ptr<InternalSend>     monitor_send() const { return _monitor_send; }
@@ -656,6 +674,9 @@ protected:
 
 	bool           _denormal_protection;
 
+	DSPStats       _dsp_stats;
+	DSPStats       _graph_wait_stats;
+
 	bool _recordable : 1;
 
 	boost::shared_ptr<SoloControl> _solo_control;
@@ -56,6 +56,26 @@ class LIBARDOUR_API RTMidiBuffer : public Evoral::EventSink<samplepos_t>
 	void reverse ();
 	bool reversed() const;
 
+	/* Random access, used to merge and splice rendered data. None of
+	 * these take the lock, callers are expected to own the buffer.
+	 */
+
+	TimeType timestamp (size_t n) const { return _data[n].timestamp; }
+	uint8_t const* event (size_t n, uint32_t& size) const;
+
+	/** @return index of the first event at or after \p time */
+	size_t lower_bound (TimeType time) const;
+	/** @return index of the first event after \p time */
+	size_t upper_bound (TimeType time) const;
+
+	/** append events [from, to) of \p other */
+	void append (RTMidiBuffer const& other, size_t from, size_t to);
+
+	/** exchange contents with \p other. The caller must hold
+	 * a WriteProtectRender for this buffer.
+	 */
+	void swap (RTMidiBuffer& other);
+
 	struct Item {
 		samplepos_t timestamp;
 		union {
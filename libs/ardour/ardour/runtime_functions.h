@@ -31,6 +31,12 @@ namespace ARDOUR {
 	typedef void  (*mix_buffers_with_gain_t) (ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t, float);
 	typedef void  (*mix_buffers_no_gain_t)   (ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t);
 	typedef void  (*copy_vector_t)           (ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t);
+	typedef float (*apply_gain_ramp_t)       (ARDOUR::Sample *, pframes_t, float, float, float);
+	typedef void  (*apply_gain_curve_t)      (ARDOUR::Sample *, const ARDOUR::gain_t *, pframes_t);
+	typedef void  (*mix_buffers_with_curve_t)(ARDOUR::Sample *, const ARDOUR::Sample *, const ARDOUR::gain_t *, pframes_t);
+	typedef void  (*interleave_t)            (ARDOUR::Sample *, const ARDOUR::Sample *, uint32_t, pframes_t);
+	typedef void  (*deinterleave_t)          (ARDOUR::Sample *, const ARDOUR::Sample *, uint32_t, pframes_t, float);
+	typedef void  (*clip_buffer_t)           (ARDOUR::Sample *, pframes_t, float);
 
 	LIBARDOUR_API extern compute_peak_t          compute_peak;
 	LIBARDOUR_API extern find_peaks_t            find_peaks;
@@ -38,6 +44,21 @@ namespace ARDOUR {
 	LIBARDOUR_API extern mix_buffers_with_gain_t mix_buffers_with_gain;
 	LIBARDOUR_API extern mix_buffers_no_gain_t   mix_buffers_no_gain;
 	LIBARDOUR_API extern copy_vector_t           copy_vector;
+
+	/** dst[i] *= g; g += coeff * (target - g); @return the gain reached after the last sample */
+	LIBARDOUR_API extern apply_gain_ramp_t        apply_gain_ramp;
+	/** dst[i] *= gain[i] */
+	LIBARDOUR_API extern apply_gain_curve_t       apply_gain_curve;
+	/** dst[i] *= 1 - gain[i] */
+	LIBARDOUR_API extern apply_gain_curve_t       apply_inverse_gain_curve;
+	/** dst[i] += src[i] * gain[i] */
+	LIBARDOUR_API extern mix_buffers_with_curve_t mix_buffers_with_curve;
+	/** dst[i * stride] = src[i] -- dst points to the first sample of the channel */
+	LIBARDOUR_API extern interleave_t             interleave;
+	/** dst[i] = src[i * stride] * gain -- src points to the first sample of the channel */
+	LIBARDOUR_API extern deinterleave_t           deinterleave;
+	/** clamp samples to [-limit, +limit] */
+	LIBARDOUR_API extern clip_buffer_t            clip_buffer;
 }
 
 #endif /* __ardour_runtime_functions_h__ */
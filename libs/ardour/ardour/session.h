@@ -146,8 +146,10 @@ class MidiRegion;
 class MidiSource;
 class MidiTrack;
 class Playlist;
+class Plugin;
 class PluginInsert;
 class PluginInfo;
+class PluginPreloader;
 class Port;
 class PortInsert;
 class ProcessThread;
@@ -309,6 +311,11 @@ public:
 	void refresh_disk_space ();
 
 	int load_routes (const XMLNode&, int);
+
+	/** @return a plugin instance that was prepared in the background
+	 * for the given plugin-insert state while loading the session, if any.
+	 */
+	boost::shared_ptr<Plugin> preloaded_plugin (XMLNode const&);
 	boost::shared_ptr<RouteList> get_routes() const {
 		return routes.reader ();
 	}
@@ -341,6 +348,8 @@ public:
 	uint32_t nbusses () const;
 
 	bool plot_process_graph (std::string const& file_name) const;
+	/** @return the parallel process graph, or null if processing is single threaded */
+	boost::shared_ptr<Graph> process_graph () const { return _process_graph; }
 
 	boost::shared_ptr<BundleList> bundles () {
 		return _bundles.reader ();
@@ -879,6 +888,8 @@ public:
 	boost::shared_ptr<AudioFileSource> create_audio_source_for_session (
 		size_t, std::string const &, uint32_t);
 
+	SourceList create_interleaved_audio_sources_for_session (size_t, std::string const &);
+
 	boost::shared_ptr<MidiSource> create_midi_source_for_session (std::string const &);
 	boost::shared_ptr<MidiSource> create_midi_source_by_stealing_name (boost::shared_ptr<Track>);
 
@@ -1510,6 +1521,16 @@ private:
 
 	Glib::Threads::Mutex save_state_lock;
 	Glib::Threads::Mutex save_source_lock;
+
+	/* the file of a pending save is written in the background,
+	 * its state is still captured by the caller of save_state() */
+	Glib::Threads::Mutex   _state_writer_lock;
+	Glib::Threads::Thread* _state_writer;
+
+	static int write_state_file (XMLTree&, std::string const& tmp_path, std::string const& xml_path, std::string const& backup_path);
+	void state_writer_thread (XMLTree*, std::string, std::string, std::string);
+	void wait_for_state_writer ();
+
 	Glib::Threads::Mutex peak_cleanup_lock;
 
 	int        load_options (const XMLNode&);
@@ -2002,6 +2023,8 @@ private:
 	XMLNode* _bundle_xml_node;
 	int load_bundles (XMLNode const &);
 
+	PluginPreloader* _plugin_preloader;
+
 	UndoHistory      _history;
 	/** current undo transaction, or 0 */
 	UndoTransaction* _current_trans;
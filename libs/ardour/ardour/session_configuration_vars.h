@@ -33,6 +33,7 @@ CONFIG_VARIABLE (bool, use_transport_fades, "use-transport-fades", true)
 CONFIG_VARIABLE (bool, use_monitor_fades, "use-monitor-fades", true)
 CONFIG_VARIABLE (SampleFormat, native_file_data_format,  "native-file-data-format", ARDOUR::FormatFloat)
 CONFIG_VARIABLE (HeaderFormat, native_file_header_format,  "native-file-header-format", ARDOUR::WAVE)
+CONFIG_VARIABLE (bool, interleaved_capture, "interleaved-capture", false)
 CONFIG_VARIABLE (bool, auto_play, "auto-play", false)
 CONFIG_VARIABLE (bool, auto_return, "auto-return", false)
 CONFIG_VARIABLE (bool, auto_input, "auto-input", true)
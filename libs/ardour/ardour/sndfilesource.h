@@ -33,6 +33,9 @@
 
 namespace ARDOUR {
 
+class SndFileReadCache;
+class SndFileInterleavedWriter;
+
 class LIBARDOUR_API SndFileSource : public AudioFileSource {
   public:
 	/** Constructor to be called for existing external-to-session files */
@@ -41,7 +44,12 @@ class LIBARDOUR_API SndFileSource : public AudioFileSource {
 	/* Constructor to be called for new in-session files */
 	SndFileSource (Session&, const std::string& path, const std::string& origin,
 	               SampleFormat samp_format, HeaderFormat hdr_format, samplecnt_t rate,
-	               Flag flags = SndFileSource::default_writable_flags);
+	               Flag flags = SndFileSource::default_writable_flags, uint32_t n_channels = 1);
+
+	/** Constructor for further channels of a new in-session file that
+	 * records several channels, see SourceFactory::createWritableInterleaved()
+	 */
+	SndFileSource (SndFileSource const& first_channel, int chn);
 
 	/* Constructor to be called for recovering files being used for
 	 * capture. They are in-session, they already exist, they should not
@@ -82,6 +90,7 @@ class LIBARDOUR_API SndFileSource : public AudioFileSource {
 
 	samplecnt_t read_unlocked (Sample *dst, samplepos_t start, samplecnt_t cnt) const;
 	samplecnt_t write_unlocked (Sample *dst, samplecnt_t cnt);
+	void prefetch_unlocked (samplepos_t start, samplecnt_t cnt) const;
 	samplecnt_t write_float (Sample* data, samplepos_t pos, samplecnt_t cnt);
 
   private:
@@ -97,6 +106,21 @@ class LIBARDOUR_API SndFileSource : public AudioFileSource {
 	void set_natural_position (samplepos_t);
 	samplecnt_t nondestructive_write_unlocked (Sample *dst, samplecnt_t cnt);
 	PBD::ScopedConnection header_position_connection;
+
+	/* interleaved data shared by all sources reading channels of the same file */
+	samplecnt_t read_shared (Sample *dst, samplepos_t start, samplecnt_t cnt) const;
+	mutable boost::shared_ptr<SndFileReadCache> _read_cache;
+
+	/* raw access to uncompressed files, for read-ahead and cache hints */
+	int     _fd;
+	int64_t _data_offset;
+	int     _bytes_per_frame;
+
+	void init_io_hints (int fd);
+	void drop_cached (samplepos_t start, samplecnt_t cnt) const;
+
+	/* shared by all channels of a new interleaved file, until it is closed */
+	boost::shared_ptr<SndFileInterleavedWriter> _writer;
 };
 
 } // namespace ARDOUR
@@ -56,6 +56,12 @@ class LIBARDOUR_API SourceFactory {
 		 const std::string& path,
 		 samplecnt_t rate, bool announce = true, bool async = false);
 
+	/** Create one writable audio source per channel, all writing to
+	 * the same interleaved file.
+	 */
+	static SourceList createWritableInterleaved
+		(Session&, const std::string& path, uint32_t n_channels,
+		 samplecnt_t rate, bool announce = true, bool async = false);
 
 	static boost::shared_ptr<Source> createForRecovery
 		(DataType type, Session&, const std::string& path, int chn);
@@ -31,10 +31,12 @@
 #include <vector>
 #include <cmath>
 #include <glibmm/threads.h>
+#include <boost/shared_ptr.hpp>
 
 #include "pbd/undo.h"
 #include "pbd/enum_convert.h"
 
+#include "pbd/rcu.h"
 #include "pbd/stateful.h"
 #include "pbd/statefuldestructible.h"
 
@@ -292,6 +294,73 @@ class LIBARDOUR_API TempoSection : public MetricSection, public Tempo {
 
 typedef std::list<MetricSection*> Metrics;
 
+/** Sorted view of the sections of a tempo map, for O(log n) lookups.
+ *
+ * Every lookup returns the section that a walk over the Metrics list would
+ * stop at: the last one before the first section (after the initial one)
+ * whose position exceeds the requested one. Positions are stored as running
+ * maxima, so this holds even if a section is out of order.
+ *
+ * An index built with @p copy_sections owns private copies of the sections
+ * and stays valid after the map is changed. TempoMap publishes such an index
+ * via RCU for realtime readers.
+ */
+class LIBARDOUR_API TempoMapIndex {
+  public:
+	TempoMapIndex () {}
+
+	void build (Metrics const& metrics, bool copy_sections);
+	void clear ();
+
+	bool valid () const { return !_tempos.empty () && !_meters.empty (); }
+
+	TempoSection* tempo_at_minute (double minute, TempoSection** next = 0) const;
+	TempoSection* tempo_at_pulse (double pulse, TempoSection** next = 0) const;
+	TempoSection* tempo_at_beat (double beat, MeterSection const& prev_m) const;
+
+	MeterSection* meter_at_minute (double minute, MeterSection** next = 0) const;
+	MeterSection* meter_at_pulse (double pulse) const;
+	MeterSection* meter_at_beat (double beat) const;
+	/* meter containing @p bbt, by its beat (beat_at_bbt) or its bar (pulse_at_bbt) */
+	MeterSection* meter_at_bbt_beat (Timecode::BBT_Time const& bbt) const;
+	MeterSection* meter_at_bbt_bar (Timecode::BBT_Time const& bbt) const;
+	/* meter used by bbt_at_pulse */
+	MeterSection* meter_at_bbt_pulse (double pulse) const;
+
+	/** @return the number of sections (of any type) at or before @p sample,
+	 * with the tempo and meter in effect at the last of them.
+	 */
+	size_t sections_at_sample (samplepos_t sample, TempoSection const** tempo, MeterSection const** meter) const;
+	MetricSection const* section (size_t n) const { return _sections[n]; }
+	Metrics::const_iterator position (size_t n) const { return _positions[n]; }
+
+	/* the conversions needed by TempoMap::*_rt () */
+	double pulse_at_minute (double minute) const;
+	Timecode::BBT_Time bbt_at_minute (double minute) const;
+	double pulse_at_bbt (Timecode::BBT_Time const& bbt) const;
+
+  private:
+	std::vector<TempoSection*> _tempos;      /* active tempi */
+	std::vector<double>        _tempo_minute;
+	std::vector<double>        _tempo_pulse;
+
+	std::vector<MeterSection*> _meters;
+	std::vector<double>        _meter_minute;
+	std::vector<double>        _meter_pulse;
+	std::vector<double>        _meter_beat;
+	std::vector<double>        _meter_bbt_beat;
+	std::vector<double>        _meter_bbt_bar;
+	std::vector<double>        _meter_bbt_pulse;
+
+	std::vector<MetricSection*>          _sections;
+	std::vector<samplepos_t>             _section_sample;
+	std::vector<TempoSection*>           _section_tempo;
+	std::vector<MeterSection*>           _section_meter;
+	std::vector<Metrics::const_iterator> _positions;
+
+	std::vector<boost::shared_ptr<MetricSection> > _copies;
+};
+
 /** Helper class to keep track of the Meter *AND* Tempo in effect
     at a given point in time.
 */
@@ -602,8 +671,21 @@ private:
 	samplecnt_t                   _sample_rate;
 	mutable Glib::Threads::RWLock lock;
 
-	void recompute_tempi (Metrics& metrics);
-	void recompute_meters (Metrics& metrics);
+	/* index of _metrics, valid while the map is solved (see recompute_map()).
+	 * _rt_index holds a copy of the map for lock-free realtime readers.
+	 */
+	TempoMapIndex                       _index;
+	SerializedRCUManager<TempoMapIndex> _rt_index;
+
+	void rebuild_index ();
+	void invalidate_index (Metrics const& metrics);
+	TempoMapIndex const* index_for (Metrics const& metrics) const;
+
+	/* update_index: rebuild the index when solving _metrics,
+	 * recompute_map() does so once after solving both.
+	 */
+	void recompute_tempi (Metrics& metrics, bool update_index = true);
+	void recompute_meters (Metrics& metrics, bool update_index = true);
 	void recompute_map (Metrics& metrics, samplepos_t end = -1);
 
 	MusicSample round_to_type (samplepos_t fr, RoundMode dir, BBTPointType);
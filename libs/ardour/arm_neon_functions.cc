@@ -515,4 +515,139 @@ arm_neon_copy_vector(
 	}
 }
 
+/* see x86_sse_avx_apply_gain_ramp() */
+float
+arm_neon_apply_gain_ramp(float *buf, uint32_t nframes, float initial, float target, float coeff)
+{
+	if (nframes < 8) {
+		return default_apply_gain_ramp(buf, nframes, initial, target, coeff);
+	}
+
+	float  pwr[4];
+	double k = 1.0;
+	for (int i = 0; i < 4; ++i) {
+		pwr[i] = k;
+		k *= 1.0 - coeff;
+	}
+
+	const float32x4_t vp = vld1q_f32(pwr);
+	const float32x4_t vt = vdupq_n_f32(target);
+	const float       k4 = k;
+	float             d  = initial - target;
+
+	while (nframes >= 4) {
+		// gain = target + delta * (1 - coeff)^n
+		float32x4_t g = vmlaq_n_f32(vt, vp, d);
+		vst1q_f32(buf, vmulq_f32(vld1q_f32(buf), g));
+		d *= k4;
+		buf += 4;
+		nframes -= 4;
+	}
+
+	return default_apply_gain_ramp(buf, nframes, target + d, target, coeff);
+}
+
+void
+arm_neon_apply_gain_curve(float *buf, const float *gain, uint32_t nframes)
+{
+	while (nframes >= 4) {
+		vst1q_f32(buf, vmulq_f32(vld1q_f32(buf), vld1q_f32(gain)));
+		buf += 4;
+		gain += 4;
+		nframes -= 4;
+	}
+
+	while (nframes > 0) {
+		*buf++ *= *gain++;
+		--nframes;
+	}
+}
+
+void
+arm_neon_apply_inverse_gain_curve(float *buf, const float *gain, uint32_t nframes)
+{
+	const float32x4_t one = vdupq_n_f32(1.f);
+
+	while (nframes >= 4) {
+		float32x4_t g = vsubq_f32(one, vld1q_f32(gain));
+		vst1q_f32(buf, vmulq_f32(vld1q_f32(buf), g));
+		buf += 4;
+		gain += 4;
+		nframes -= 4;
+	}
+
+	while (nframes > 0) {
+		*buf++ *= 1.f - *gain++;
+		--nframes;
+	}
+}
+
+void
+arm_neon_mix_buffers_with_curve(float *dst, const float *src, const float *gain, uint32_t nframes)
+{
+	while (nframes >= 4) {
+		vst1q_f32(dst, vmlaq_f32(vld1q_f32(dst), vld1q_f32(src), vld1q_f32(gain)));
+		dst += 4;
+		src += 4;
+		gain += 4;
+		nframes -= 4;
+	}
+
+	while (nframes > 0) {
+		*dst++ += *src++ * *gain++;
+		--nframes;
+	}
+}
+
+/* Only stereo is vectorized. The last vector touches one sample past
+ * the end of the channel, which is only valid if another frame follows.
+ */
+void
+arm_neon_interleave(float *dst, const float *src, uint32_t stride, uint32_t nframes)
+{
+	if (stride == 2) {
+		while (nframes > 4) {
+			float32x4x2_t x = vld2q_f32(dst);
+			x.val[0] = vld1q_f32(src);
+			vst2q_f32(dst, x);
+			src += 4;
+			dst += 8;
+			nframes -= 4;
+		}
+	}
+
+	default_interleave(dst, src, stride, nframes);
+}
+
+void
+arm_neon_deinterleave(float *dst, const float *src, uint32_t stride, uint32_t nframes, float gain)
+{
+	if (stride == 2) {
+		while (nframes > 4) {
+			float32x4x2_t x = vld2q_f32(src);
+			vst1q_f32(dst, vmulq_n_f32(x.val[0], gain));
+			src += 8;
+			dst += 4;
+			nframes -= 4;
+		}
+	}
+
+	default_deinterleave(dst, src, stride, nframes, gain);
+}
+
+void
+arm_neon_clip_buffer(float *buf, uint32_t nframes, float limit)
+{
+	const float32x4_t vmax = vdupq_n_f32(limit);
+	const float32x4_t vmin = vdupq_n_f32(-limit);
+
+	while (nframes >= 4) {
+		vst1q_f32(buf, vminq_f32(vmax, vmaxq_f32(vmin, vld1q_f32(buf))));
+		buf += 4;
+		nframes -= 4;
+	}
+
+	default_clip_buffer(buf, nframes, limit);
+}
+
 #endif
@@ -25,6 +25,8 @@
 
 #include <cstdlib>
 
+#include <glibmm/threads.h>
+
 #include "ardour/types.h"
 #include "ardour/debug.h"
 #include "ardour/audioplaylist.h"
@@ -38,6 +40,47 @@ using namespace ARDOUR;
 using namespace std;
 using namespace PBD;
 
+static Glib::Threads::Private<RegionIndex::RegionVector> thread_touched_regions;
+
+/** Per-thread list of the regions touched by a read, reused so that the
+ *  disk-reader does not allocate one for every chunk. A nested read (of a
+ *  compound region's playlist) finds the slot empty while the outer read
+ *  holds the vector, and hands its own back when it is done.
+ */
+class TouchedRegions
+{
+public:
+	TouchedRegions ()
+	{
+		RegionIndex::RegionVector* rv = thread_touched_regions.get ();
+		if (rv) {
+			_rv.swap (*rv);
+		} else {
+			_rv.reserve (64);
+		}
+	}
+
+	~TouchedRegions ()
+	{
+		/* drop the region references, keep the storage */
+		_rv.clear ();
+
+		RegionIndex::RegionVector* rv = thread_touched_regions.get ();
+		if (!rv) {
+			rv = new RegionIndex::RegionVector;
+			thread_touched_regions.set (rv);
+		}
+		if (rv->capacity () < _rv.capacity ()) {
+			rv->swap (_rv);
+		}
+	}
+
+	RegionIndex::RegionVector& regions () { return _rv; }
+
+private:
+	RegionIndex::RegionVector _rv;
+};
+
 AudioPlaylist::AudioPlaylist (Session& session, const XMLNode& node, bool hidden)
 	: Playlist (session, node, DataType::AUDIO, hidden)
 {
@@ -194,8 +237,11 @@ AudioPlaylist::read (Sample *buf, Sample *mixdown_buffer, float *gain_buffer, sa
 	/* Find all the regions that are involved in the bit we are reading,
 	   and sort them by descending layer and ascending position.
 	*/
-	boost::shared_ptr<RegionList> all = regions_touched_locked (start, start + cnt - 1);
-	all->sort (ReadSorter ());
+	TouchedRegions touched;
+	RegionIndex::RegionVector& all (touched.regions ());
+	all.clear ();
+	regions_touched_locked (start, start + cnt - 1, all);
+	std::stable_sort (all.begin(), all.end(), ReadSorter ());
 
 	/* This will be a list of the bits of our read range that we have
 	   handled completely (ie for which no more regions need to be read).
@@ -207,7 +253,7 @@ AudioPlaylist::read (Sample *buf, Sample *mixdown_buffer, float *gain_buffer, sa
 	list<Segment> to_do;
 
 	/* Now go through the `all' list filling in `to_do' and `done' */
-	for (RegionList::iterator i = all->begin(); i != all->end(); ++i) {
+	for (RegionIndex::RegionVector::const_iterator i = all.begin(); i != all.end(); ++i) {
 		boost::shared_ptr<AudioRegion> ar = boost::dynamic_pointer_cast<AudioRegion> (*i);
 
 		/* muted regions don't figure into it at all */
@@ -266,6 +312,31 @@ AudioPlaylist::read (Sample *buf, Sample *mixdown_buffer, float *gain_buffer, sa
 	return cnt;
 }
 
+/** Tell the sources of all regions in the given range that it will be read.
+ *  This does not consider layering, regions that are obscured may be hinted, too.
+ */
+void
+AudioPlaylist::prefetch (samplepos_t start, samplecnt_t cnt)
+{
+	if (cnt <= 0) {
+		return;
+	}
+
+	Playlist::RegionReadLock rl (this);
+
+	TouchedRegions touched;
+	RegionIndex::RegionVector& all (touched.regions ());
+	all.clear ();
+	regions_touched_locked (start, start + cnt - 1, all);
+
+	for (RegionIndex::RegionVector::const_iterator i = all.begin(); i != all.end(); ++i) {
+		boost::shared_ptr<AudioRegion> ar = boost::dynamic_pointer_cast<AudioRegion> (*i);
+		if (ar && !ar->muted ()) {
+			ar->prefetch (start, cnt);
+		}
+	}
+}
+
 void
 AudioPlaylist::dump () const
 {
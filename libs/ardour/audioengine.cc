@@ -104,6 +104,9 @@ AudioEngine::AudioEngine ()
 	, _hw_devicelist_update_thread(0)
 	, _hw_devicelist_update_count(0)
 	, _stop_hw_devicelist_processing(0)
+	, _resampled_inputs_thread (0)
+	, _resampled_inputs_sem ("resampled_inputs", 0)
+	, _stop_resampled_inputs_processing (0)
 	, _start_cnt (0)
 	, _init_countdown (0)
 	, _pending_playback_latency_callback (0)
@@ -228,6 +231,9 @@ __attribute__((annotate("realtime")))
 int
 AudioEngine::process_callback (pframes_t nframes)
 {
+	/* allow RCU rt_reader() use for the duration of the cycle */
+	RCUCycle::Scope rcu_cycle;
+
 	Glib::Threads::Mutex::Lock tm (_process_lock, Glib::Threads::TRY_LOCK);
 	Port::set_speed_ratio (1.0);
 
@@ -705,6 +711,31 @@ AudioEngine::do_devicelist_update()
 	}
 }
 
+/** Realtime safe, connect_callback() may be called from the process thread */
+void
+AudioEngine::request_resampled_inputs_update ()
+{
+	_resampled_inputs_sem.signal ();
+}
+
+void
+AudioEngine::do_resampled_inputs_update ()
+{
+	pthread_set_name ("PortResampler");
+
+	while (true) {
+		_resampled_inputs_sem.wait ();
+
+		if (g_atomic_int_get (&_stop_resampled_inputs_processing)) {
+			break;
+		}
+
+		/* a single update covers all connection changes so far */
+		_resampled_inputs_sem.reset ();
+
+		update_resampled_inputs ();
+	}
+}
 
 void
 AudioEngine::start_hw_event_processing()
@@ -720,6 +751,11 @@ AudioEngine::start_hw_event_processing()
 		g_atomic_int_set(&_stop_hw_devicelist_processing, 0);
 		_hw_devicelist_update_thread = Glib::Threads::Thread::create (boost::bind (&AudioEngine::do_devicelist_update, this));
 	}
+
+	if (_resampled_inputs_thread == 0) {
+		g_atomic_int_set (&_stop_resampled_inputs_processing, 0);
+		_resampled_inputs_thread = Glib::Threads::Thread::create (boost::bind (&AudioEngine::do_resampled_inputs_update, this));
+	}
 }
 
 
@@ -741,6 +777,13 @@ AudioEngine::stop_hw_event_processing()
 		_hw_devicelist_update_thread->join ();
 		_hw_devicelist_update_thread = 0;
 	}
+
+	if (_resampled_inputs_thread) {
+		g_atomic_int_set (&_stop_resampled_inputs_processing, 1);
+		_resampled_inputs_sem.signal ();
+		_resampled_inputs_thread->join ();
+		_resampled_inputs_thread = 0;
+	}
 }
 
 void
@@ -594,14 +594,9 @@ AudioRegion::read_at (Sample *buf, Sample *mixdown_buffer, float *gain_buffer,
 		_envelope->curve().get_vector (internal_offset, internal_offset + to_read, gain_buffer, to_read);
 
 		if (_scale_amplitude != 1.0f) {
-			for (samplecnt_t n = 0; n < to_read; ++n) {
-				mixdown_buffer[n] *= gain_buffer[n] * _scale_amplitude;
-			}
-		} else {
-			for (samplecnt_t n = 0; n < to_read; ++n) {
-				mixdown_buffer[n] *= gain_buffer[n];
-			}
+			apply_gain_to_buffer (gain_buffer, to_read, _scale_amplitude);
 		}
+		apply_gain_curve (mixdown_buffer, gain_buffer, to_read);
 	} else if (_scale_amplitude != 1.0f) {
 		apply_gain_to_buffer (mixdown_buffer, to_read, _scale_amplitude);
 	}
@@ -627,9 +622,7 @@ AudioRegion::read_at (Sample *buf, Sample *mixdown_buffer, float *gain_buffer,
 				_inverse_fade_in->curve().get_vector (internal_offset, internal_offset + fade_in_limit, gain_buffer, fade_in_limit);
 
 				/* Fade the data from lower layers out */
-				for (samplecnt_t n = 0; n < fade_in_limit; ++n) {
-					buf[n] *= gain_buffer[n];
-				}
+				apply_gain_curve (buf, gain_buffer, fade_in_limit);
 
 				/* refill gain buffer with the fade in */
 
@@ -643,18 +636,14 @@ AudioRegion::read_at (Sample *buf, Sample *mixdown_buffer, float *gain_buffer,
 
 				_fade_in->curve().get_vector (internal_offset, internal_offset + fade_in_limit, gain_buffer, fade_in_limit);
 
-				for (samplecnt_t n = 0; n < fade_in_limit; ++n) {
-					buf[n] *= 1 - gain_buffer[n];
-				}
+				apply_inverse_gain_curve (buf, gain_buffer, fade_in_limit);
 			}
 		} else {
 			_fade_in->curve().get_vector (internal_offset, internal_offset + fade_in_limit, gain_buffer, fade_in_limit);
 		}
 
 		/* Mix our newly-read data in, with the fade */
-		for (samplecnt_t n = 0; n < fade_in_limit; ++n) {
-			buf[n] += mixdown_buffer[n] * gain_buffer[n];
-		}
+		mix_buffers_with_curve (buf, mixdown_buffer, gain_buffer, fade_in_limit);
 	}
 
 	if (fade_out_limit != 0) {
@@ -667,9 +656,7 @@ AudioRegion::read_at (Sample *buf, Sample *mixdown_buffer, float *gain_buffer,
 				_inverse_fade_out->curve().get_vector (curve_offset, curve_offset + fade_out_limit, gain_buffer, fade_out_limit);
 
 				/* Fade the data from lower levels in */
-				for (samplecnt_t n = 0, m = fade_out_offset; n < fade_out_limit; ++n, ++m) {
-					buf[m] *= gain_buffer[n];
-				}
+				apply_gain_curve (buf + fade_out_offset, gain_buffer, fade_out_limit);
 
 				/* fetch the actual fade out */
 
@@ -684,9 +671,7 @@ AudioRegion::read_at (Sample *buf, Sample *mixdown_buffer, float *gain_buffer,
 
 				_fade_out->curve().get_vector (curve_offset, curve_offset + fade_out_limit, gain_buffer, fade_out_limit);
 
-				for (samplecnt_t n = 0, m = fade_out_offset; n < fade_out_limit; ++n, ++m) {
-					buf[m] *= 1 - gain_buffer[n];
-				}
+				apply_inverse_gain_curve (buf + fade_out_offset, gain_buffer, fade_out_limit);
 			}
 		} else {
 			_fade_out->curve().get_vector (curve_offset, curve_offset + fade_out_limit, gain_buffer, fade_out_limit);
@@ -695,9 +680,7 @@ AudioRegion::read_at (Sample *buf, Sample *mixdown_buffer, float *gain_buffer,
 		/* Mix our newly-read data with whatever was already there,
 		   with the fade out applied to our data.
 		*/
-		for (samplecnt_t n = 0, m = fade_out_offset; n < fade_out_limit; ++n, ++m) {
-			buf[m] += mixdown_buffer[m] * gain_buffer[n];
-		}
+		mix_buffers_with_curve (buf + fade_out_offset, mixdown_buffer + fade_out_offset, gain_buffer, fade_out_limit);
 	}
 
 	/* MIX OR COPY THE REGION BODY FROM mixdown_buffer INTO buf */
@@ -775,6 +758,24 @@ AudioRegion::read_from_sources (SourceList const & srcs, samplecnt_t limit, Samp
 	return to_read;
 }
 
+void
+AudioRegion::prefetch (samplepos_t position, samplecnt_t cnt) const
+{
+	samplepos_t const s = max (position, _position.val ());
+	samplepos_t const e = min (position + cnt, _position.val () + _length.val ());
+
+	if (s >= e) {
+		return;
+	}
+
+	for (SourceList::const_iterator i = _sources.begin (); i != _sources.end (); ++i) {
+		boost::shared_ptr<AudioSource> src = boost::dynamic_pointer_cast<AudioSource> (*i);
+		if (src) {
+			src->prefetch (_start + (s - _position), e - s);
+		}
+	}
+}
+
 XMLNode&
 AudioRegion::get_basic_state ()
 {
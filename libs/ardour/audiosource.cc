@@ -60,6 +60,7 @@
 #include "pbd/xml++.h"
 
 #include "ardour/audiosource.h"
+#include "ardour/filename_extensions.h"
 #include "ardour/rc_configuration.h"
 #include "ardour/runtime_functions.h"
 #include "ardour/session.h"
@@ -91,8 +92,10 @@ AudioSource::AudioSource (Session& s, const string& name)
 	, peak_leftover_sample (0)
 	, _first_run (true)
 	, _last_scale (0.0)
+	, _last_fpp (0)
 	, _last_map_off (0)
 	, _last_raw_map_length (0)
+	, _peak_levels_state (PeakLevelsUnknown)
 {
 }
 
@@ -108,8 +111,10 @@ AudioSource::AudioSource (Session& s, const XMLNode& node)
 	, peak_leftover_sample (0)
 	, _first_run (true)
 	, _last_scale (0.0)
+	, _last_fpp (0)
 	, _last_map_off (0)
 	, _last_raw_map_length (0)
+	, _peak_levels_state (PeakLevelsUnknown)
 {
 	if (set_state (node, Stateful::loading_state_version)) {
 		throw failed_constructor();
@@ -168,6 +173,7 @@ AudioSource::update_length (samplecnt_t len)
 {
 	if (len > _length) {
 		_length = len;
+		g_atomic_int_set (&_peak_levels_state, PeakLevelsUnknown);
 	}
 }
 
@@ -223,6 +229,9 @@ AudioSource::rename_peakfile (string newpath)
 
 	string oldpath = _peakpath;
 
+	/* decimated levels are rebuilt on demand */
+	remove_peak_levels ();
+
 	if (Glib::file_test (oldpath, Glib::FILE_TEST_EXISTS)) {
 		if (g_rename (oldpath.c_str(), newpath.c_str()) != 0) {
 			error << string_compose (_("cannot rename peakfile for %1 from %2 to %3 (%4)"), _name, oldpath, newpath, strerror (errno)) << endmsg;
@@ -322,6 +331,13 @@ AudioSource::read (Sample *dst, samplepos_t start, samplecnt_t cnt, int /*channe
 	return read_unlocked (dst, start, cnt);
 }
 
+void
+AudioSource::prefetch (samplepos_t start, samplecnt_t cnt) const
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	prefetch_unlocked (start, cnt);
+}
+
 samplecnt_t
 AudioSource::write (Sample *dst, samplecnt_t cnt)
 {
@@ -334,7 +350,182 @@ AudioSource::write (Sample *dst, samplecnt_t cnt)
 int
 AudioSource::read_peaks (PeakData *peaks, samplecnt_t npeaks, samplepos_t start, samplecnt_t cnt, double samples_per_visual_peak) const
 {
-	return read_peaks_with_fpp (peaks, npeaks, start, cnt, samples_per_visual_peak, _FPP);
+	return read_peaks_with_fpp (peaks, npeaks, start, cnt, samples_per_visual_peak, peak_level_fpp (samples_per_visual_peak));
+}
+
+/** @return the samples-per-peak of the coarsest peakfile level that
+ * still has at least the requested resolution.
+ */
+samplecnt_t
+AudioSource::peak_level_fpp (double samples_per_visual_peak) const
+{
+	if (samples_per_visual_peak < _FPP * peak_level_factor) {
+		return _FPP;
+	}
+
+	if (g_atomic_int_get (&_peak_levels_state) != PeakLevelsReady) {
+		if (g_atomic_int_get (&_peak_levels_state) == PeakLevelsUnavailable) {
+			return _FPP;
+		}
+		/* peakfile from an older session, or levels were invalidated */
+		if (build_peak_levels ()) {
+			return _FPP;
+		}
+	}
+
+	samplecnt_t fpp = _FPP;
+	for (uint32_t l = 0; l < n_peak_levels; ++l) {
+		if (fpp * peak_level_factor > samples_per_visual_peak) {
+			break;
+		}
+		fpp *= peak_level_factor;
+	}
+	return fpp;
+}
+
+std::string
+AudioSource::peak_level_path (std::string const& peakpath, samplecnt_t fpp) const
+{
+	std::string base = peakpath;
+	const size_t sl = strlen (peakfile_suffix);
+	if (base.size () > sl && base.compare (base.size () - sl, sl, peakfile_suffix) == 0) {
+		base = base.substr (0, base.size () - sl);
+	}
+	return string_compose ("%1-%2%3", base, fpp, peakfile_suffix);
+}
+
+void
+AudioSource::remove_peak_levels () const
+{
+	g_atomic_int_set (&_peak_levels_state, PeakLevelsUnknown);
+
+	if (_peakpath.empty ()) {
+		return;
+	}
+
+	samplecnt_t fpp = _FPP;
+	for (uint32_t l = 0; l < n_peak_levels; ++l) {
+		fpp *= peak_level_factor;
+		::g_unlink (peak_level_path (_peakpath, fpp).c_str ());
+	}
+}
+
+/** Create (or validate existing) decimated peak files from the full
+ * resolution peakfile. Each level reduces the previous one by peak_level_factor.
+ * @return 0 on success, in which case levels are ready for use.
+ */
+int
+AudioSource::build_peak_levels () const
+{
+	Glib::Threads::Mutex::Lock lp (_peak_levels_lock);
+
+	if (g_atomic_int_get (&_peak_levels_state) == PeakLevelsReady) {
+		return 0;
+	}
+
+	{
+		Glib::Threads::Mutex::Lock lm (_peaks_ready_lock);
+		if (!_peaks_built || _peakfile_fd >= 0) {
+			/* peaks are not (completely) written yet */
+			return -1;
+		}
+	}
+
+	GStatBuf statbuf;
+
+	if (_peakpath.empty () || g_stat (_peakpath.c_str (), &statbuf) != 0) {
+		return -1;
+	}
+
+	const off_t   base_peaks = statbuf.st_size / sizeof (PeakData);
+	const time_t  base_mtime = statbuf.st_mtime;
+
+	if (base_peaks < (off_t) (_length / _FPP)) {
+		/* peakfile is incomplete, levels would not cover the source */
+		return -1;
+	}
+
+	std::string src_path = _peakpath;
+	off_t       src_peaks = base_peaks;
+	samplecnt_t fpp = _FPP;
+
+	std::vector<PeakData> inbuf (peak_level_factor * 4096);
+	std::vector<PeakData> outbuf (4096);
+
+	for (uint32_t l = 0; l < n_peak_levels; ++l) {
+
+		fpp *= peak_level_factor;
+
+		const std::string dst_path  = peak_level_path (_peakpath, fpp);
+		const off_t       dst_peaks = (src_peaks + peak_level_factor - 1) / peak_level_factor;
+
+		GStatBuf dststat;
+		if (g_stat (dst_path.c_str (), &dststat) == 0 && dststat.st_mtime >= base_mtime && dststat.st_size == (off_t) (dst_peaks * sizeof (PeakData))) {
+			/* up to date */
+			src_path  = dst_path;
+			src_peaks = dst_peaks;
+			continue;
+		}
+
+		DEBUG_TRACE (DEBUG::Peaks, string_compose ("Building peak level %1 at %2 samples/peak\n", dst_path, fpp));
+
+		const std::string tmp_path = dst_path + X_(".tmp");
+
+		ScopedFileDescriptor in (g_open (src_path.c_str (), O_RDONLY, 0444));
+		ScopedFileDescriptor out (g_open (tmp_path.c_str (), O_CREAT|O_TRUNC|O_WRONLY, 0664));
+
+		if (in < 0 || out < 0) {
+			error << string_compose (_("AudioSource: cannot create peakfile level \"%1\" (%2)"), dst_path, strerror (errno)) << endmsg;
+			::g_unlink (tmp_path.c_str ());
+			g_atomic_int_set (&_peak_levels_state, PeakLevelsUnavailable);
+			return -1;
+		}
+
+		off_t remain = src_peaks;
+		bool  failed = false;
+
+		while (remain > 0 && !failed) {
+			const size_t to_read = std::min ((off_t) inbuf.size (), remain);
+			const size_t bytes   = to_read * sizeof (PeakData);
+
+			if (::read (in, &inbuf[0], bytes) != (ssize_t) bytes) {
+				failed = true;
+				break;
+			}
+
+			size_t n_out = 0;
+			for (size_t i = 0; i < to_read; i += peak_level_factor, ++n_out) {
+				const size_t e = std::min (to_read, i + peak_level_factor);
+				PeakData::PeakDatum xmin = inbuf[i].min;
+				PeakData::PeakDatum xmax = inbuf[i].max;
+				for (size_t j = i + 1; j < e; ++j) {
+					xmin = min (xmin, inbuf[j].min);
+					xmax = max (xmax, inbuf[j].max);
+				}
+				outbuf[n_out].min = xmin;
+				outbuf[n_out].max = xmax;
+			}
+
+			if (::write (out, &outbuf[0], n_out * sizeof (PeakData)) != (ssize_t) (n_out * sizeof (PeakData))) {
+				failed = true;
+			}
+
+			remain -= to_read;
+		}
+
+		if (failed || ::g_rename (tmp_path.c_str (), dst_path.c_str ()) != 0) {
+			error << string_compose (_("AudioSource: cannot write peakfile level \"%1\" (%2)"), dst_path, strerror (errno)) << endmsg;
+			::g_unlink (tmp_path.c_str ());
+			g_atomic_int_set (&_peak_levels_state, PeakLevelsUnavailable);
+			return -1;
+		}
+
+		src_path  = dst_path;
+		src_peaks = dst_peaks;
+	}
+
+	g_atomic_int_set (&_peak_levels_state, PeakLevelsReady);
+	return 0;
 }
 
 /** @param peaks Buffer to write peak data.
@@ -403,15 +594,27 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, samplecnt_t npeaks, samplepos
 	samplecnt_t read_npeaks = npeaks;
 	samplecnt_t zero_fill = 0;
 
+	/* full resolution, or one of the decimated levels */
+	const std::string peakpath = (samples_per_file_peak == _FPP) ? _peakpath : peak_level_path (_peakpath, samples_per_file_peak);
+
 	GStatBuf statbuf;
 
 	expected_peaks = (cnt / (double) samples_per_file_peak);
-	if (g_stat (_peakpath.c_str(), &statbuf) != 0) {
-		error << string_compose (_("Cannot open peakfile @ %1 for size check (%2)"), _peakpath, strerror (errno)) << endmsg;
+	if (g_stat (peakpath.c_str(), &statbuf) != 0) {
+		error << string_compose (_("Cannot open peakfile @ %1 for size check (%2)"), peakpath, strerror (errno)) << endmsg;
 		return -1;
 	}
 
-	if (!_captured_for.empty()) {
+	if (samples_per_file_peak != _FPP) {
+		const samplepos_t end = std::min (_length, start + cnt);
+		if (statbuf.st_size < (off_t) (ceil (end / (double) samples_per_file_peak) * sizeof (PeakData))) {
+			/* level does not cover the requested range, use full resolution */
+			lm.release ();
+			return read_peaks_with_fpp (peaks, npeaks, start, cnt, samples_per_visual_peak, _FPP);
+		}
+	}
+
+	if (!_captured_for.empty() && samples_per_file_peak == _FPP) {
 
 		/* _captured_for is only set after a capture pass is
 		 * complete. so we know that capturing is finished for this
@@ -442,10 +645,10 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, samplecnt_t npeaks, samplepos
 		}
 	}
 
-	ScopedFileDescriptor sfd (g_open (_peakpath.c_str(), O_RDONLY, 0444));
+	ScopedFileDescriptor sfd (g_open (peakpath.c_str(), O_RDONLY, 0444));
 
 	if (sfd < 0) {
-		error << string_compose (_("Cannot open peakfile @ %1 for reading (%2)"), _peakpath, strerror (errno)) << endmsg;
+		error << string_compose (_("Cannot open peakfile @ %1 for reading (%2)"), peakpath, strerror (errno)) << endmsg;
 		return -1;
 	}
 
@@ -505,7 +708,7 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, samplecnt_t npeaks, samplepos
 		off_t  map_delta = map_off - read_map_off;
 		size_t map_length = bytes_to_read + map_delta;
 
-		if (_first_run  || (_last_scale != samples_per_visual_peak) || (_last_map_off != map_off) || (_last_raw_map_length  < bytes_to_read)) {
+		if (_first_run  || (_last_scale != samples_per_visual_peak) || (_last_fpp != samples_per_file_peak) || (_last_map_off != map_off) || (_last_raw_map_length  < bytes_to_read)) {
 			peak_cache.reset (new PeakData[npeaks]);
 			char* addr;
 #ifdef PLATFORM_WINDOWS
@@ -552,6 +755,7 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, samplecnt_t npeaks, samplepos
 
 			_first_run = false;
 			_last_scale = samples_per_visual_peak;
+			_last_fpp = samples_per_file_peak;
 			_last_map_off = map_off;
 			_last_raw_map_length = bytes_to_read;
 		}
@@ -598,7 +802,7 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, samplecnt_t npeaks, samplepos
 		size_t raw_map_length = chunksize * sizeof(PeakData);
 		size_t map_length = (chunksize * sizeof(PeakData)) + map_delta;
 
-		if (_first_run || (_last_scale != samples_per_visual_peak) || (_last_map_off != map_off) || (_last_raw_map_length < raw_map_length)) {
+		if (_first_run || (_last_scale != samples_per_visual_peak) || (_last_fpp != samples_per_file_peak) || (_last_map_off != map_off) || (_last_raw_map_length < raw_map_length)) {
 			peak_cache.reset (new PeakData[npeaks]);
 			boost::scoped_array<PeakData> staging (new PeakData[chunksize]);
 
@@ -668,6 +872,7 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, samplecnt_t npeaks, samplepos
 
 			_first_run = false;
 			_last_scale = samples_per_visual_peak;
+			_last_fpp = samples_per_file_peak;
 			_last_map_off = map_off;
 			_last_raw_map_length = raw_map_length;
 		}
@@ -845,6 +1050,7 @@ AudioSource::close_peakfile ()
 	if (!_peakpath.empty()) {
 		::g_unlink (_peakpath.c_str());
 	}
+	remove_peak_levels ();
 	_peaks_built = false;
 	return 0;
 }
@@ -856,6 +1062,8 @@ AudioSource::prepare_for_peakfile_writes ()
 		return -1;
 	}
 
+	g_atomic_int_set (&_peak_levels_state, PeakLevelsUnknown);
+
 	if ((_peakfile_fd = g_open (_peakpath.c_str(), O_CREAT|O_RDWR, 0664)) < 0) {
 		error << string_compose(_("AudioSource: cannot open _peakpath (c) \"%1\" (%2)"), _peakpath, strerror (errno)) << endmsg;
 		return -1;
@@ -882,8 +1090,14 @@ AudioSource::done_with_peakfile_writes (bool done)
 	_peakfile_fd = -1;
 
 	if (done) {
+		{
+			Glib::Threads::Mutex::Lock lm (_peaks_ready_lock);
+			_peaks_built = true;
+		}
+		/* write decimated levels while the peakfile is still hot in the page cache */
+		build_peak_levels ();
+
 		Glib::Threads::Mutex::Lock lm (_peaks_ready_lock);
-		_peaks_built = true;
 		PeaksReady (); /* EMIT SIGNAL */
 	}
 }
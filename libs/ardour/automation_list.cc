@@ -61,6 +61,8 @@ static void dumpit (const AutomationList& al, string prefix = "")
 AutomationList::AutomationList (const Evoral::Parameter& id, const Evoral::ParameterDescriptor& desc)
 	: ControlList(id, desc)
 	, _before (0)
+	, _serialized_count (0)
+	, _serialized_valid (false)
 {
 	_state = Off;
 	g_atomic_int_set (&_touching, 0);
@@ -75,6 +77,8 @@ AutomationList::AutomationList (const Evoral::Parameter& id, const Evoral::Param
 AutomationList::AutomationList (const Evoral::Parameter& id)
 	: ControlList(id, ARDOUR::ParameterDescriptor(id))
 	, _before (0)
+	, _serialized_count (0)
+	, _serialized_valid (false)
 {
 	_state = Off;
 	g_atomic_int_set (&_touching, 0);
@@ -90,6 +94,8 @@ AutomationList::AutomationList (const AutomationList& other)
 	: ControlList(other)
 	, StatefulDestructible()
 	, _before (0)
+	, _serialized_count (0)
+	, _serialized_valid (false)
 {
 	_state = other._state;
 	g_atomic_int_set (&_touching, other.touching());
@@ -103,6 +109,8 @@ AutomationList::AutomationList (const AutomationList& other)
 AutomationList::AutomationList (const AutomationList& other, double start, double end)
 	: ControlList(other, start, end)
 	, _before (0)
+	, _serialized_count (0)
+	, _serialized_valid (false)
 {
 	_state = other._state;
 	g_atomic_int_set (&_touching, other.touching());
@@ -119,6 +127,8 @@ AutomationList::AutomationList (const AutomationList& other, double start, doubl
 AutomationList::AutomationList (const XMLNode& node, Evoral::Parameter id)
 	: ControlList(id, ARDOUR::ParameterDescriptor(id))
 	, _before (0)
+	, _serialized_count (0)
+	, _serialized_valid (false)
 {
 	g_atomic_int_set (&_touching, 0);
 	_interpolation = default_interpolation ();
@@ -387,23 +397,31 @@ XMLNode&
 AutomationList::serialize_events (bool need_lock)
 {
 	XMLNode* node = new XMLNode (X_("events"));
-	stringstream str;
 
 	Glib::Threads::RWLock::ReaderLock lm (Evoral::ControlList::_lock, Glib::Threads::NOT_LOCK);
 	if (need_lock) {
 		lm.acquire ();
 	}
-	for (iterator xx = _events.begin(); xx != _events.end(); ++xx) {
-		str << PBD::to_string ((*xx)->when);
-		str << ' ';
-		str << PBD::to_string ((*xx)->value);
-		str << '\n';
+
+	Glib::Threads::Mutex::Lock sl (_serialized_lock);
+
+	if (!_serialized_valid || modification_count () != _serialized_count) {
+		stringstream str;
+		for (iterator xx = _events.begin(); xx != _events.end(); ++xx) {
+			str << PBD::to_string ((*xx)->when);
+			str << ' ';
+			str << PBD::to_string ((*xx)->value);
+			str << '\n';
+		}
+		_serialized_events = str.str ();
+		_serialized_count  = modification_count ();
+		_serialized_valid  = true;
 	}
 
 	/* XML is a bit wierd */
 
 	XMLNode* content_node = new XMLNode (X_("foo")); /* it gets renamed by libxml when we set content */
-	content_node->set_content (str.str());
+	content_node->set_content (_serialized_events);
 
 	node->add_child_nocopy (*content_node);
 
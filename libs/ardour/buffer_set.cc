@@ -31,12 +31,14 @@
 #include "pbd/compose.h"
 #include "pbd/failed_constructor.h"
 
+#include "ardour/audio_buffer.h"
 #include "ardour/buffer.h"
 #include "ardour/buffer_set.h"
 #include "ardour/debug.h"
 #include "ardour/midi_buffer.h"
 #include "ardour/port.h"
 #include "ardour/port_set.h"
+#include "ardour/runtime_functions.h"
 #include "ardour/lv2_plugin.h"
 #include "lv2_evbuf.h"
 #include "ardour/uri_map.h"
@@ -481,5 +483,30 @@ BufferSet::silence (samplecnt_t nframes, samplecnt_t offset)
 	}
 }
 
+bool
+BufferSet::silent (samplecnt_t nframes, samplecnt_t offset, Sample threshold) const
+{
+	for (uint32_t i = 0; i < _count.n_audio (); ++i) {
+		AudioBuffer const& ab (get_audio (i));
+		if (ab.silent ()) {
+			continue;
+		}
+		if (compute_peak (ab.data (offset), nframes, 0) > threshold) {
+			return false;
+		}
+	}
+
+	for (uint32_t i = 0; i < _count.n_midi (); ++i) {
+		MidiBuffer const& mb (get_midi (i));
+		for (MidiBuffer::const_iterator e = mb.begin (); e != mb.end (); ++e) {
+			if ((*e).time () >= offset && (*e).time () < offset + nframes) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
 } // namespace ARDOUR
 
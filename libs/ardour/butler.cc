@@ -20,10 +20,13 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
 #include <errno.h>
 #include <fcntl.h>
 #include <unistd.h>
 
+#include <boost/scoped_array.hpp>
+
 #ifndef PLATFORM_WINDOWS
 #include <poll.h>
 #endif
@@ -36,6 +39,7 @@
 #include "ardour/disk_io.h"
 #include "ardour/disk_reader.h"
 #include "ardour/io.h"
+#include "ardour/rc_configuration.h"
 #include "ardour/session.h"
 #include "ardour/track.h"
 #include "ardour/auditioner.h"
@@ -55,8 +59,16 @@ Butler::Butler(Session& s)
 	, _midi_buffer_size(0)
 	, pool_trash(16)
 	, _xthread (true)
+	, _disk_work_type (DiskRefill)
+	, _disk_work_sem ("butler_disk_work", 0)
+	, _disk_done_sem ("butler_disk_done", 0)
 {
 	g_atomic_int_set(&should_do_transport_work, 0);
+	g_atomic_int_set (&_disk_workers_active, 0);
+	g_atomic_int_set (&_disk_workers_dirty, 1);
+	g_atomic_int_set (&_disk_work_next, 0);
+	g_atomic_int_set (&_disk_work_outstanding, 0);
+	g_atomic_int_set (&_disk_work_errors, 0);
 	SessionEvent::pool->set_trash (&pool_trash);
 
         /* catch future changes to parameters */
@@ -97,6 +109,11 @@ Butler::config_changed (std::string p)
 		_audio_playback_buffer_size = (uint32_t) floor (Config->get_audio_playback_buffer_seconds() * _session.sample_rate());
 		_session.adjust_capture_buffering ();
 		_session.adjust_playback_buffering ();
+	} else if (p == "butler-disk-threads") {
+		/* worker threads are owned by the butler thread, it will
+		 * re-create them before the next refill pass.
+		 */
+		g_atomic_int_set (&_disk_workers_dirty, 1);
 	}
 }
 
@@ -142,7 +159,9 @@ Butler::terminate_thread ()
                 DEBUG_TRACE (DEBUG::Butler, string_compose ("%1: ask butler to quit @ %2\n", DEBUG_THREAD_SELF, g_get_monotonic_time()));
 		queue_request (Request::Quit);
 		pthread_join (thread, &status);
+		have_thread = false;
 	}
+	drop_disk_workers ();
 }
 
 void *
@@ -159,7 +178,6 @@ Butler::thread_work ()
 	uint32_t err = 0;
 
 	bool disk_work_outstanding = false;
-	RouteList::iterator i;
 
 	while (true) {
 		DEBUG_TRACE (DEBUG::Butler, string_compose ("%1 butler main loop, disk work outstanding ? %2 @ %3\n", DEBUG_THREAD_SELF, disk_work_outstanding, g_get_monotonic_time()));
@@ -227,6 +245,10 @@ Butler::thread_work ()
 			_session.the_auditioner()->seek_response(audition_seek);
 		}
 
+		if (g_atomic_int_compare_and_exchange (&_disk_workers_dirty, 1, 0)) {
+			reset_disk_workers ();
+		}
+
 		boost::shared_ptr<RouteList> rl = _session.get_routes();
 
 		RouteList rl_with_auditioner = *rl;
@@ -234,43 +256,8 @@ Butler::thread_work ()
 
 		DEBUG_TRACE (DEBUG::Butler, string_compose ("butler starts refill loop, twr = %1\n", transport_work_requested()));
 
-		for (i = rl_with_auditioner.begin(); !transport_work_requested() && should_run && i != rl_with_auditioner.end(); ++i) {
-
-			boost::shared_ptr<Track> tr = boost::dynamic_pointer_cast<Track> (*i);
-
-			if (!tr) {
-				continue;
-			}
-
-			boost::shared_ptr<IO> io = tr->input ();
-
-			if (io && !io->active()) {
-				/* don't read inactive tracks */
-				// DEBUG_TRACE (DEBUG::Butler, string_compose ("butler skips inactive track %1\n", tr->name()));
-				continue;
-			}
-			// DEBUG_TRACE (DEBUG::Butler, string_compose ("butler refills %1, playback load = %2\n", tr->name(), tr->playback_buffer_load()));
-			switch (tr->do_refill ()) {
-			case 0:
-				//DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill done %1\n", tr->name()));
-				break;
-
-			case 1:
-				DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill unfinished %1\n", tr->name()));
-				disk_work_outstanding = true;
-				break;
-
-			default:
-				error << string_compose(_("Butler read ahead failure on dstream %1"), (*i)->name()) << endmsg;
-                                std::cerr << string_compose(_("Butler read ahead failure on dstream %1"), (*i)->name()) << std::endl;
-				break;
-			}
-
-		}
-
-		if (i != rl_with_auditioner.begin() && i != rl_with_auditioner.end()) {
-			/* we didn't get to all the streams */
-			disk_work_outstanding = true;
+		if (should_run && !transport_work_requested()) {
+			disk_work_outstanding = refill_tracks (rl_with_auditioner);
 		}
 
 		if (!err && transport_work_requested()) {
@@ -317,14 +304,58 @@ Butler::thread_work ()
 	return (0);
 }
 
+namespace {
+	typedef std::pair<float, boost::shared_ptr<Track> > TrackLoad;
+
+	struct TrackLoadSorter {
+		bool operator() (TrackLoad const& a, TrackLoad const& b) const {
+			return a.first < b.first;
+		}
+	};
+}
+
 bool
-Butler::flush_tracks_to_disk_normal (boost::shared_ptr<RouteList> rl, uint32_t& errors)
+Butler::refill_tracks (RouteList const& rl)
 {
-	bool disk_work_outstanding = false;
+	std::vector<TrackLoad> tl;
 
-	for (RouteList::iterator i = rl->begin(); !transport_work_requested() && should_run && i != rl->end(); ++i) {
+	for (RouteList::const_iterator i = rl.begin(); i != rl.end(); ++i) {
 
-		// cerr << "write behind for " << (*i)->name () << endl;
+		boost::shared_ptr<Track> tr = boost::dynamic_pointer_cast<Track> (*i);
+
+		if (!tr) {
+			continue;
+		}
+
+		boost::shared_ptr<IO> io = tr->input ();
+
+		if (io && !io->active()) {
+			/* don't read inactive tracks */
+			continue;
+		}
+
+		/* snapshot the load, it keeps changing while the process thread runs */
+		tl.push_back (TrackLoad (tr->playback_buffer_load (), tr));
+	}
+
+	/* service the emptiest playback buffers first */
+	std::stable_sort (tl.begin (), tl.end (), TrackLoadSorter ());
+
+	_disk_work.clear ();
+	for (std::vector<TrackLoad>::const_iterator i = tl.begin (); i != tl.end (); ++i) {
+		_disk_work.push_back (i->second);
+	}
+
+	uint32_t errors = 0; /* read errors are reported, but not fatal */
+	return run_disk_work (DiskRefill, errors);
+}
+
+bool
+Butler::flush_tracks_to_disk_normal (boost::shared_ptr<RouteList> rl, uint32_t& errors)
+{
+	std::vector<TrackLoad> tl;
+
+	for (RouteList::iterator i = rl->begin(); i != rl->end(); ++i) {
 
 		boost::shared_ptr<Track> tr = boost::dynamic_pointer_cast<Track> (*i);
 
@@ -335,31 +366,212 @@ Butler::flush_tracks_to_disk_normal (boost::shared_ptr<RouteList> rl, uint32_t&
 		/* note that we still try to flush diskstreams attached to inactive routes
 		 */
 
-		int ret;
+		tl.push_back (TrackLoad (tr->capture_buffer_load (), tr));
+	}
 
-		// DEBUG_TRACE (DEBUG::Butler, string_compose ("butler flushes track %1 capture load %2\n", tr->name(), tr->capture_buffer_load()));
-		ret = tr->do_flush (ButlerContext, false);
-		switch (ret) {
-		case 0:
-			//DEBUG_TRACE (DEBUG::Butler, string_compose ("\tflush complete for %1\n", tr->name()));
+	/* capture load is the free space, so this services the fullest buffers first */
+	std::stable_sort (tl.begin (), tl.end (), TrackLoadSorter ());
+
+	_disk_work.clear ();
+	for (std::vector<TrackLoad>::const_iterator i = tl.begin (); i != tl.end (); ++i) {
+		_disk_work.push_back (i->second);
+	}
+
+	return run_disk_work (DiskFlush, errors);
+}
+
+bool
+Butler::run_disk_work (DiskWorkType type, uint32_t& errors)
+{
+	if (_disk_work.empty ()) {
+		return false;
+	}
+
+	const int64_t t0 = g_get_monotonic_time ();
+
+	_disk_work_type = type;
+	g_atomic_int_set (&_disk_work_next, 0);
+	g_atomic_int_set (&_disk_work_outstanding, 0);
+	g_atomic_int_set (&_disk_work_errors, 0);
+
+	/* the butler thread itself always participates, so only wake
+	 * as many workers as there are remaining tracks.
+	 */
+	const size_t nw = std::min (_disk_workers.size (), _disk_work.size () - 1);
+
+	DEBUG_TRACE (DEBUG::Butler, string_compose ("butler disk work (%1) for %2 tracks using %3 additional threads\n",
+	                                            type == DiskRefill ? "refill" : "flush", _disk_work.size (), nw));
+
+	for (size_t i = 0; i < nw; ++i) {
+		_disk_work_sem.signal ();
+	}
+
+	process_disk_work (0, 0, 0);
+
+	for (size_t i = 0; i < nw; ++i) {
+		_disk_done_sem.wait ();
+	}
+
+	_disk_stats.passes += 1;
+	_disk_stats.tracks += std::min<size_t> (g_atomic_int_get (&_disk_work_next), _disk_work.size ());
+	_disk_stats.usecs  += g_get_monotonic_time () - t0;
+
+	/* drop references */
+	_disk_work.clear ();
+
+	errors += g_atomic_int_get (&_disk_work_errors);
+	return g_atomic_int_get (&_disk_work_outstanding) != 0;
+}
+
+/** Process tracks from _disk_work until none are left. Called concurrently
+ * by the butler thread and the disk worker threads. The butler thread passes
+ * null buffers and uses the DiskReader's static working buffers.
+ */
+void
+Butler::process_disk_work (Sample* sum_buffer, Sample* mixdown_buffer, gain_t* gain_buffer)
+{
+	const gint n_work = _disk_work.size ();
+
+	while (true) {
+
+		const gint n = g_atomic_int_add (&_disk_work_next, 1);
+
+		if (n >= n_work) {
 			break;
+		}
 
-		case 1:
-			//DEBUG_TRACE (DEBUG::Butler, string_compose ("\tflush not finished for %1\n", tr->name()));
-			disk_work_outstanding = true;
+		if (!should_run) {
 			break;
+		}
 
-		default:
-			errors++;
-			error << string_compose(_("Butler write-behind failure on dstream %1"), (*i)->name()) << endmsg;
-			std::cerr << string_compose(_("Butler write-behind failure on dstream %1"), (*i)->name()) << std::endl;
-			/* don't break - try to flush all streams in case they
-			   are split across disks.
-			*/
+		if (transport_work_requested ()) {
+			/* we didn't get to all the streams */
+			g_atomic_int_set (&_disk_work_outstanding, 1);
+			break;
+		}
+
+		boost::shared_ptr<Track> tr = _disk_work[n];
+		int ret;
+
+		if (_disk_work_type == DiskRefill) {
+			// DEBUG_TRACE (DEBUG::Butler, string_compose ("butler refills %1, playback load = %2\n", tr->name(), tr->playback_buffer_load()));
+			if (sum_buffer) {
+				ret = tr->do_refill (sum_buffer, mixdown_buffer, gain_buffer);
+			} else {
+				ret = tr->do_refill ();
+			}
+			switch (ret) {
+			case 0:
+				//DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill done %1\n", tr->name()));
+				break;
+
+			case 1:
+				DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill unfinished %1\n", tr->name()));
+				g_atomic_int_set (&_disk_work_outstanding, 1);
+				break;
+
+			default:
+				error << string_compose(_("Butler read ahead failure on dstream %1"), tr->name()) << endmsg;
+				std::cerr << string_compose(_("Butler read ahead failure on dstream %1"), tr->name()) << std::endl;
+				break;
+			}
+		} else {
+			// DEBUG_TRACE (DEBUG::Butler, string_compose ("butler flushes track %1 capture load %2\n", tr->name(), tr->capture_buffer_load()));
+			ret = tr->do_flush (ButlerContext, false);
+			switch (ret) {
+			case 0:
+				//DEBUG_TRACE (DEBUG::Butler, string_compose ("\tflush complete for %1\n", tr->name()));
+				break;
+
+			case 1:
+				//DEBUG_TRACE (DEBUG::Butler, string_compose ("\tflush not finished for %1\n", tr->name()));
+				g_atomic_int_set (&_disk_work_outstanding, 1);
+				break;
+
+			default:
+				g_atomic_int_inc (&_disk_work_errors);
+				error << string_compose(_("Butler write-behind failure on dstream %1"), tr->name()) << endmsg;
+				std::cerr << string_compose(_("Butler write-behind failure on dstream %1"), tr->name()) << std::endl;
+				/* don't break - try to flush all streams in case they
+				   are split across disks.
+				*/
+			}
 		}
 	}
+}
 
-	return disk_work_outstanding;
+void
+Butler::drop_disk_workers ()
+{
+	g_atomic_int_set (&_disk_workers_active, 0);
+
+	for (size_t i = 0; i < _disk_workers.size (); ++i) {
+		_disk_work_sem.signal ();
+	}
+	for (std::vector<pthread_t>::const_iterator i = _disk_workers.begin (); i != _disk_workers.end (); ++i) {
+		pthread_join (*i, NULL);
+	}
+
+	_disk_workers.clear ();
+	_disk_work_sem.reset ();
+	_disk_done_sem.reset ();
+}
+
+/* must only be called from the butler thread, outside of run_disk_work() */
+void
+Butler::reset_disk_workers ()
+{
+	drop_disk_workers ();
+
+	const uint32_t n_threads = std::max ((uint32_t) 1, Config->get_butler_disk_threads ());
+
+	if (n_threads < 2) {
+		return;
+	}
+
+	g_atomic_int_set (&_disk_workers_active, 1);
+
+	/* the butler thread is the first worker */
+	for (uint32_t i = 1; i < n_threads; ++i) {
+		pthread_t thread_id;
+		if (pthread_create_and_store ("disk worker", &thread_id, _disk_worker_thread, this)) {
+			error << _("Butler: could not create disk worker thread") << endmsg;
+			break;
+		}
+		_disk_workers.push_back (thread_id);
+	}
+
+	DEBUG_TRACE (DEBUG::Butler, string_compose ("butler uses %1 disk worker threads\n", _disk_workers.size ()));
+}
+
+void*
+Butler::_disk_worker_thread (void* arg)
+{
+	pthread_set_name (X_("butler disk io"));
+	((Butler*) arg)->disk_worker ();
+	return 0;
+}
+
+void
+Butler::disk_worker ()
+{
+	/* DiskReader's static working buffers are reserved for the butler thread */
+	const samplecnt_t bufsize = DiskReader::working_buffer_size ();
+	boost::scoped_array<Sample> sum_buf (new Sample[bufsize]);
+	boost::scoped_array<Sample> mix_buf (new Sample[bufsize]);
+	boost::scoped_array<gain_t> gain_buf (new gain_t[bufsize]);
+
+	while (true) {
+		_disk_work_sem.wait ();
+
+		if (0 == g_atomic_int_get (&_disk_workers_active)) {
+			break;
+		}
+
+		process_disk_work (sum_buf.get (), mix_buf.get (), gain_buf.get ());
+
+		_disk_done_sem.signal ();
+	}
 }
 
 bool
@@ -38,6 +38,7 @@
 #include "ardour/pannable.h"
 #include "ardour/playlist.h"
 #include "ardour/playlist_factory.h"
+#include "ardour/runtime_functions.h"
 #include "ardour/session.h"
 #include "ardour/session_playlists.h"
 
@@ -130,9 +131,15 @@ DiskReader::allocate_working_buffers ()
 	   need to reflect the maximum size we could use, which is 4MB reads, or 2M samples
 	   using 16 bit samples.
 	*/
-	_sum_buffer     = new Sample[2 * 1048576];
-	_mixdown_buffer = new Sample[2 * 1048576];
-	_gain_buffer    = new gain_t[2 * 1048576];
+	_sum_buffer     = new Sample[working_buffer_size ()];
+	_mixdown_buffer = new Sample[working_buffer_size ()];
+	_gain_buffer    = new gain_t[working_buffer_size ()];
+}
+
+samplecnt_t
+DiskReader::working_buffer_size ()
+{
+	return 2 * 1048576;
 }
 
 void
@@ -1098,9 +1105,15 @@ DiskReader::audio_read (Sample*            sum_buffer,
 
 int
 DiskReader::do_refill ()
+{
+	return do_refill (_sum_buffer, _mixdown_buffer, _gain_buffer);
+}
+
+int
+DiskReader::do_refill (Sample* sum_buffer, Sample* mixdown_buffer, gain_t* gain_buffer)
 {
 	const bool reversed = !_session.transport_will_roll_forwards ();
-	return refill (_sum_buffer, _mixdown_buffer, _gain_buffer, 0, reversed);
+	return refill (sum_buffer, mixdown_buffer, gain_buffer, 0, reversed);
 }
 
 int
@@ -1273,6 +1286,14 @@ DiskReader::refill_audio (Sample* sum_buffer, Sample* mixdown_buffer, float* gai
 
 	samplepos_t file_sample_tmp = fsa;
 
+	if (!reversed && _playlists[DataType::AUDIO]) {
+		/* let the OS start reading all sources that this and the next
+		 * refill will need, rather than having it handle one blocking read
+		 * at a time for each channel and region.
+		 */
+		audio_playlist ()->prefetch (fsa, min (total_space, 2 * samples_to_read));
+	}
+
 #if 0
 	int64_t before = g_get_monotonic_time ();
 	int64_t elapsed;
@@ -1578,8 +1599,11 @@ DiskReader::dec_no_disk_output ()
 
 DiskReader::DeclickAmp::DeclickAmp (samplecnt_t sample_rate)
 {
-	_a = 800.f / (gain_t)sample_rate; // ~ 1/50Hz to fade by 40dB
-	_l = -log1p (_a);
+	/* ~ 1/50Hz to fade by 40dB. This used to be applied in steps of 4 samples,
+	 * use the equivalent per-sample coefficient.
+	 */
+	const double a4 = 800.0 / (double)sample_rate;
+	_a = 1.0 - pow (1.0 - a4, 0.25);
 	_g = 0;
 }
 
@@ -1597,30 +1621,7 @@ DiskReader::DeclickAmp::apply_gain (AudioBuffer& buf, samplecnt_t n_samples, con
 		return;
 	}
 
-	const float   a      = _a;
-	Sample* const buffer = buf.data ();
-
-	const int max_nproc = 4;
-	uint32_t  remain    = n_samples;
-	uint32_t  offset    = buffer_offset;
-
-	while (remain > 0) {
-		uint32_t n_proc = remain > max_nproc ? max_nproc : remain;
-		for (uint32_t i = 0; i < n_proc; ++i) {
-			buffer[offset + i] *= g;
-		}
-#if 1
-		g += a * (target - g);
-#else /* accurate exponential fade */
-		if (n_proc == max_nproc) {
-			g += a * (target - g);
-		} else {
-			g = target - (target - g) * expf (_l * n_proc / max_nproc);
-		}
-#endif
-		remain -= n_proc;
-		offset += n_proc;
-	}
+	g = apply_gain_ramp (buf.data (buffer_offset), n_samples, g, target, _a);
 
 	if (fabsf (g - target) < GAIN_COEFF_DELTA) {
 		_g = target;
@@ -1788,12 +1789,7 @@ DiskReader::Declicker::run (Sample* buf, samplepos_t read_start, samplepos_t rea
 			return;
 	}
 
-	Sample* b = &buf[bo];
-	gain_t* g = &vec[vo];
-
-	for (sampleoffset_t i = 0; i < n; ++i) {
-		b[i] *= g[i];
-	}
+	apply_gain_curve (&buf[bo], &vec[vo], n);
 }
 
 void
@@ -1872,9 +1868,8 @@ DiskReader::maybe_xfade_loop (Sample* buf, samplepos_t read_start, samplepos_t r
 	gain_t* og   = &loop_declick_out.vec[vo];  /* fade out gain vector */
 	gain_t* ig   = &loop_declick_in.vec[vo];   /* fade in gain vector */
 
-	for (sampleoffset_t i = 0; i < n; ++i) {
-		b[i] = (b[i] * og[i]) + (sbuf[i] * ig[i]);
-	}
+	apply_gain_curve (b, og, n);
+	mix_buffers_with_curve (b, sbuf, ig, n);
 }
 
 RTMidiBuffer*
@@ -964,6 +964,8 @@ DiskWriter::reset_write_sources (bool mark_write_complete, bool /*force*/)
 
 	capturing_sources.clear ();
 
+	const bool interleaved = _session.config.get_interleaved_capture () && c->size () > 1;
+
 	for (chan = c->begin(), n = 0; chan != c->end(); ++chan, ++n) {
 
 		if ((*chan)->write_source) {
@@ -982,9 +984,17 @@ DiskWriter::reset_write_sources (bool mark_write_complete, bool /*force*/)
 			(*chan)->write_source.reset ();
 		}
 
-		use_new_write_source (DataType::AUDIO, n);
+		if (!interleaved) {
+			use_new_write_source (DataType::AUDIO, n);
+		}
+	}
+
+	if (interleaved) {
+		use_new_interleaved_write_sources ();
+	}
 
-		if (record_enabled()) {
+	if (record_enabled()) {
+		for (chan = c->begin(); chan != c->end(); ++chan) {
 			capturing_sources.push_back ((*chan)->write_source);
 		}
 	}
@@ -1056,6 +1066,39 @@ DiskWriter::use_new_write_source (DataType dt, uint32_t n)
 	return 0;
 }
 
+/** Set up the write sources of all audio channels to record into a single
+ * interleaved file, with one write per flush.
+ */
+int
+DiskWriter::use_new_interleaved_write_sources ()
+{
+	_accumulated_capture_offset = 0;
+
+	if (!recordable()) {
+		return 1;
+	}
+
+	boost::shared_ptr<ChannelList> c = channels.reader();
+	SourceList srcs;
+
+	try {
+		srcs = _session.create_interleaved_audio_sources_for_session (c->size(), write_source_name());
+	}
+
+	catch (failed_constructor &err) {
+		error << string_compose (_("%1: new capture file not initialized correctly"), _name) << endmsg;
+		return -1;
+	}
+
+	SourceList::const_iterator s = srcs.begin ();
+	for (ChannelList::iterator chan = c->begin(); chan != c->end(); ++chan, ++s) {
+		(*chan)->write_source = boost::dynamic_pointer_cast<AudioFileSource> (*s);
+		(*chan)->write_source->set_allow_remove_if_empty (true);
+	}
+
+	return 0;
+}
+
 void
 DiskWriter::transport_stopped_wallclock (struct tm& when, time_t twhen, bool abort_capture)
 {
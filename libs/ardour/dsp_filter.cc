@@ -20,6 +20,9 @@
 #include <algorithm>
 #include <stdlib.h>
 #include <cmath>
+
+#include "audiographer/general/fft_plan_cache.h"
+
 #include "ardour/dB.h"
 #include "ardour/buffer.h"
 #include "ardour/dsp_filter.h"
@@ -328,8 +331,6 @@ Biquad::dB_at_freq (float freq) const
 }
 
 
-Glib::Threads::Mutex FFTSpectrum::fft_planner_lock;
-
 FFTSpectrum::FFTSpectrum (uint32_t window_size, double rate)
 	: hann_window (0)
 {
@@ -338,10 +339,6 @@ FFTSpectrum::FFTSpectrum (uint32_t window_size, double rate)
 
 FFTSpectrum::~FFTSpectrum ()
 {
-	{
-		Glib::Threads::Mutex::Lock lk (fft_planner_lock);
-		fftwf_destroy_plan (_fftplan);
-	}
 	fftwf_free (_fft_data_in);
 	fftwf_free (_fft_data_out);
 	free (_fft_power);
@@ -352,7 +349,6 @@ void
 FFTSpectrum::init (uint32_t window_size, double rate)
 {
 	assert (window_size > 0);
-	Glib::Threads::Mutex::Lock lk (fft_planner_lock);
 
 	_fft_window_size = window_size;
 	_fft_data_size   = window_size / 2;
@@ -364,7 +360,7 @@ FFTSpectrum::init (uint32_t window_size, double rate)
 
 	reset ();
 
-	_fftplan = fftwf_plan_r2r_1d (_fft_window_size, _fft_data_in, _fft_data_out, FFTW_R2HC, FFTW_MEASURE);
+	_fftplan = AudioGrapher::FFTPlanCache::r2hc (_fft_window_size);
 
 	hann_window  = (float *) malloc(sizeof(float) * window_size);
 	double sum = 0.0;
@@ -402,7 +398,7 @@ FFTSpectrum::set_data_hann (float const * const data, uint32_t n_samples, uint32
 void
 FFTSpectrum::execute ()
 {
-	fftwf_execute (_fftplan);
+	fftwf_execute_r2r (_fftplan, _fft_data_in, _fft_data_out);
 
 	_fft_power[0] = _fft_data_out[0] * _fft_data_out[0];
 
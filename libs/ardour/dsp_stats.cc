@@ -0,0 +1,172 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "ardour/dsp_stats.h"
+
+using namespace ARDOUR;
+
+volatile gint DSPStats::_enabled = 0;
+volatile gint DSPStats::_window  = 1000;
+
+DSPStats::DSPStats ()
+{
+	clear (_cur);
+	clear (_published);
+	g_atomic_int_set (&_seq, 0);
+	g_atomic_int_set (&_reset, 0);
+}
+
+void
+DSPStats::set_enabled (bool yn)
+{
+	g_atomic_int_set (&_enabled, yn ? 1 : 0);
+}
+
+void
+DSPStats::set_window (uint32_t n)
+{
+	g_atomic_int_set (&_window, std::max<uint32_t> (1, n));
+}
+
+void
+DSPStats::clear (Window& w)
+{
+	w.cnt = 0;
+	w.min = std::numeric_limits<uint64_t>::max ();
+	w.max = 0;
+	w.sum = 0;
+	memset (w.hist, 0, sizeof (w.hist));
+}
+
+/* buckets 0..3 hold the values 0..3, above that each octave
+ * [2^o, 2^(o+1)) is split into 4 equally sized buckets.
+ */
+int
+DSPStats::bucket (uint64_t v)
+{
+	if (v < 4) {
+		return v;
+	}
+	int o = 2;
+	while (v >> (o + 1)) {
+		++o;
+	}
+	int b = 4 * (o - 1) + ((v >> (o - 2)) & 3);
+	return std::min<int> (b, n_buckets - 1);
+}
+
+/** largest value that falls into bucket \p b */
+uint64_t
+DSPStats::bucket_limit (int b)
+{
+	if (b < 4) {
+		return b;
+	}
+	int const o = b / 4 + 1;
+	return ((uint64_t)(5 + (b & 3)) << (o - 2)) - 1;
+}
+
+void
+DSPStats::update (uint64_t elapsed)
+{
+	if (g_atomic_int_compare_and_exchange (&_reset, 1, 0)) {
+		clear (_cur);
+		g_atomic_int_inc (&_seq);
+		clear (_published);
+		g_atomic_int_inc (&_seq);
+	}
+
+	++_cur.cnt;
+	_cur.sum += elapsed;
+	_cur.min = std::min (_cur.min, elapsed);
+	_cur.max = std::max (_cur.max, elapsed);
+	++_cur.hist[bucket (elapsed)];
+
+	if (_cur.cnt >= (uint64_t)window ()) {
+		publish ();
+		clear (_cur);
+	}
+}
+
+void
+DSPStats::publish ()
+{
+	/* odd sequence number: write in progress */
+	g_atomic_int_inc (&_seq);
+	_published = _cur;
+	g_atomic_int_inc (&_seq);
+}
+
+bool
+DSPStats::snapshot (Window& w) const
+{
+	for (int retry = 0; retry < 16; ++retry) {
+		gint s0 = g_atomic_int_get (&_seq);
+		if (s0 & 1) {
+			continue;
+		}
+		w = _published;
+		if (g_atomic_int_get (&_seq) == s0) {
+			return w.cnt > 0;
+		}
+	}
+	return false;
+}
+
+uint64_t
+DSPStats::percentile (Window const& w, double pct)
+{
+	uint64_t const thresh = ceil (w.cnt * std::max (0.0, std::min (100.0, pct)) / 100.0);
+	uint64_t       acc    = 0;
+	for (int b = 0; b < n_buckets; ++b) {
+		acc += w.hist[b];
+		if (acc >= thresh && acc > 0) {
+			return std::max (w.min, std::min (w.max, bucket_limit (b)));
+		}
+	}
+	return w.max;
+}
+
+uint64_t
+DSPStats::percentile (double pct) const
+{
+	Window w;
+	if (!snapshot (w)) {
+		return 0;
+	}
+	return percentile (w, pct);
+}
+
+bool
+DSPStats::get_stats (uint64_t& min, uint64_t& max, double& avg, uint64_t& p50, uint64_t& p95, uint64_t& p99) const
+{
+	Window w;
+	if (!snapshot (w)) {
+		return false;
+	}
+	min = w.min;
+	max = w.max;
+	avg = w.sum / (double)w.cnt;
+	p50 = percentile (w, 50);
+	p95 = percentile (w, 95);
+	p99 = percentile (w, 99);
+	return true;
+}
@@ -130,6 +130,7 @@
 #include "ardour/transport_master_manager.h"
 #include "ardour/uri_map.h"
 
+#include "audiographer/general/fft_plan_cache.h"
 #include "audiographer/routines.h"
 
 #if defined(__APPLE__)
@@ -154,6 +155,13 @@ apply_gain_to_buffer_t  ARDOUR::apply_gain_to_buffer  = 0;
 mix_buffers_with_gain_t ARDOUR::mix_buffers_with_gain = 0;
 mix_buffers_no_gain_t   ARDOUR::mix_buffers_no_gain   = 0;
 copy_vector_t           ARDOUR::copy_vector           = 0;
+apply_gain_ramp_t        ARDOUR::apply_gain_ramp          = 0;
+apply_gain_curve_t       ARDOUR::apply_gain_curve         = 0;
+apply_gain_curve_t       ARDOUR::apply_inverse_gain_curve = 0;
+mix_buffers_with_curve_t ARDOUR::mix_buffers_with_curve   = 0;
+interleave_t             ARDOUR::interleave               = 0;
+deinterleave_t           ARDOUR::deinterleave             = 0;
+clip_buffer_t            ARDOUR::clip_buffer              = 0;
 
 PBD::Signal1<void, std::string>                    ARDOUR::BootMessage;
 PBD::Signal3<void, std::string, std::string, bool> ARDOUR::PluginScanMessage;
@@ -200,6 +208,14 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_no_gain   = x86_sse_avx_mix_buffers_no_gain;
 			copy_vector           = x86_sse_avx_copy_vector;
 
+			apply_gain_ramp          = x86_fma_apply_gain_ramp;
+			apply_gain_curve         = x86_sse_avx_apply_gain_curve;
+			apply_inverse_gain_curve = x86_sse_avx_apply_inverse_gain_curve;
+			mix_buffers_with_curve   = x86_fma_mix_buffers_with_curve;
+			interleave               = x86_sse_avx_interleave;
+			deinterleave             = x86_sse_avx_deinterleave;
+			clip_buffer              = x86_sse_avx_clip_buffer;
+
 			generic_mix_functions = false;
 
 		} else
@@ -215,6 +231,14 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_no_gain   = x86_sse_avx_mix_buffers_no_gain;
 			copy_vector           = x86_sse_avx_copy_vector;
 
+			apply_gain_ramp          = x86_sse_avx_apply_gain_ramp;
+			apply_gain_curve         = x86_sse_avx_apply_gain_curve;
+			apply_inverse_gain_curve = x86_sse_avx_apply_inverse_gain_curve;
+			mix_buffers_with_curve   = x86_sse_avx_mix_buffers_with_curve;
+			interleave               = x86_sse_avx_interleave;
+			deinterleave             = x86_sse_avx_deinterleave;
+			clip_buffer              = x86_sse_avx_clip_buffer;
+
 			generic_mix_functions = false;
 
 		} else if (fpu->has_sse ()) {
@@ -228,6 +252,14 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_no_gain   = x86_sse_mix_buffers_no_gain;
 			copy_vector           = default_copy_vector;
 
+			apply_gain_ramp          = default_apply_gain_ramp;
+			apply_gain_curve         = default_apply_gain_curve;
+			apply_inverse_gain_curve = default_apply_inverse_gain_curve;
+			mix_buffers_with_curve   = default_mix_buffers_with_curve;
+			interleave               = default_interleave;
+			deinterleave             = default_deinterleave;
+			clip_buffer              = default_clip_buffer;
+
 			generic_mix_functions = false;
 		}
 
@@ -243,6 +275,14 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_no_gain   = arm_neon_mix_buffers_no_gain;
 			copy_vector           = arm_neon_copy_vector;
 
+			apply_gain_ramp          = arm_neon_apply_gain_ramp;
+			apply_gain_curve         = arm_neon_apply_gain_curve;
+			apply_inverse_gain_curve = arm_neon_apply_inverse_gain_curve;
+			mix_buffers_with_curve   = arm_neon_mix_buffers_with_curve;
+			interleave               = arm_neon_interleave;
+			deinterleave             = arm_neon_deinterleave;
+			clip_buffer              = arm_neon_clip_buffer;
+
 			generic_mix_functions = false;
 		}
 
@@ -256,6 +296,14 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_no_gain   = veclib_mix_buffers_no_gain;
 			copy_vector           = default_copy_vector;
 
+			apply_gain_ramp          = default_apply_gain_ramp;
+			apply_gain_curve         = default_apply_gain_curve;
+			apply_inverse_gain_curve = default_apply_inverse_gain_curve;
+			mix_buffers_with_curve   = default_mix_buffers_with_curve;
+			interleave               = default_interleave;
+			deinterleave             = default_deinterleave;
+			clip_buffer              = default_clip_buffer;
+
 			generic_mix_functions = false;
 
 			info << "Apple VecLib H/W specific optimizations in use" << endmsg;
@@ -275,11 +323,20 @@ setup_hardware_optimization (bool try_optimization)
 		mix_buffers_no_gain   = default_mix_buffers_no_gain;
 		copy_vector           = default_copy_vector;
 
+		apply_gain_ramp          = default_apply_gain_ramp;
+		apply_gain_curve         = default_apply_gain_curve;
+		apply_inverse_gain_curve = default_apply_inverse_gain_curve;
+		mix_buffers_with_curve   = default_mix_buffers_with_curve;
+		interleave               = default_interleave;
+		deinterleave             = default_deinterleave;
+		clip_buffer              = default_clip_buffer;
+
 		info << "No H/W specific optimizations in use" << endmsg;
 	}
 
 	AudioGrapher::Routines::override_compute_peak (compute_peak);
 	AudioGrapher::Routines::override_apply_gain_to_buffer (apply_gain_to_buffer);
+	AudioGrapher::Routines::override_clip_buffer (clip_buffer);
 }
 
 static void
@@ -490,6 +547,9 @@ ARDOUR::init (bool use_windows_vst, bool try_optimization, const char* localedir
 	(void)bind_textdomain_codeset (PACKAGE, "UTF-8");
 #endif
 
+	/* FFTW_MEASURE plans of previous runs */
+	AudioGrapher::FFTPlanCache::load_wisdom (Glib::build_filename (user_cache_directory (), X_("fftwf_wisdom")));
+
 	SessionEvent::init_event_pool ();
 	TransportFSM::Event::init_pool ();
 
@@ -685,6 +745,7 @@ ARDOUR::cleanup ()
 #endif
 	delete &PluginManager::instance ();
 	delete Config;
+	AudioGrapher::FFTPlanCache::clear ();
 	PBD::cleanup ();
 
 	return;
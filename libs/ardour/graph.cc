@@ -31,6 +31,7 @@
 #include "ardour/debug.h"
 #include "ardour/graph.h"
 #include "ardour/process_thread.h"
+#include "ardour/rc_configuration.h"
 #include "ardour/route.h"
 #include "ardour/session.h"
 #include "ardour/types.h"
@@ -56,8 +57,18 @@ alloc_allowed ()
 
 #define g_atomic_uint_get(x) static_cast<guint> (g_atomic_int_get (x))
 
+static void
+release_graph_worker (void*)
+{
+	/* owned by Graph::_workers */
+}
+
+Glib::Threads::Private<Graph::Worker> Graph::_thread_worker (release_graph_worker);
+
 Graph::Graph (Session& session)
 	: SessionHandleRef (session)
+	, _work_stealing (false)
+	, _spin_usecs (0)
 	, _execution_sem ("graph_execution", 0)
 	, _callback_start_sem ("graph_start", 0)
 	, _callback_done_sem ("graph_done", 0)
@@ -65,6 +76,7 @@ Graph::Graph (Session& session)
 	, _current_chain (0)
 	, _pending_chain (0)
 	, _setup_chain (1)
+	, _process_cycle_start (0)
 {
 	g_atomic_int_set (&_terminal_refcnt, 0);
 	g_atomic_int_set (&_terminate, 0);
@@ -125,6 +137,18 @@ Graph::reset_thread_list ()
 		drop_threads ();
 	}
 
+	/* Allocate per-thread state, before any thread can use it */
+	{
+		Glib::Threads::Mutex::Lock ls (_swap_mutex);
+		for (std::vector<Worker*>::iterator i = _workers.begin (); i != _workers.end (); ++i) {
+			delete *i;
+		}
+		_workers.clear ();
+		for (uint32_t i = 0; i < num_threads; ++i) {
+			_workers.push_back (new Worker (i));
+		}
+	}
+
 	/* Allow threads to run */
 	g_atomic_int_set (&_terminate, 0);
 
@@ -181,6 +205,11 @@ Graph::drop_threads ()
 	g_atomic_int_set (&_n_workers, 0);
 	g_atomic_int_set (&_idle_thread_cnt, 0);
 
+	for (std::vector<Worker*>::iterator i = _workers.begin (); i != _workers.end (); ++i) {
+		delete *i;
+	}
+	_workers.clear ();
+
 	/* signal main process thread if it's waiting for an already terminated thread */
 	_callback_done_sem.signal ();
 
@@ -240,6 +269,19 @@ Graph::prep ()
 		_swap_mutex.unlock ();
 	}
 
+	_process_cycle_start = DSPStats::enabled () ? DSPStats::now () : 0;
+
+	/* All workers are idle at this point, latch settings for this cycle */
+	_work_stealing = Config->get_graph_work_stealing ();
+	_spin_usecs    = _work_stealing ? Config->get_graph_spin_usecs () : 0;
+
+	if (_work_stealing) {
+		for (std::vector<Worker*>::const_iterator w = _workers.begin (); w != _workers.end (); ++w) {
+			assert ((*w)->deque.size () == 0);
+			(*w)->deque.clear ();
+		}
+	}
+
 	_graph_empty = true;
 
 	int chain = _current_chain;
@@ -265,6 +307,15 @@ void
 Graph::trigger (GraphNode* n)
 {
 	g_atomic_int_inc (&_trigger_queue_size);
+
+	if (_work_stealing) {
+		/* keep the node local to the thread that unblocked it */
+		Worker* w = _thread_worker.get ();
+		if (w && w->deque.push (n)) {
+			return;
+		}
+	}
+
 	_trigger_queue.push_back (n);
 }
 
@@ -391,6 +442,63 @@ Graph::rechain (boost::shared_ptr<RouteList> routelist, GraphEdges const& edges)
 	dump (chain);
 }
 
+/** Look for a node to process: first in the thread's own deque,
+ * then in the shared trigger-queue, and finally try to steal from
+ * other threads.
+ */
+bool
+Graph::find_work (Worker* w, GraphNode*& to_run)
+{
+	if (!_work_stealing || !w) {
+		return _trigger_queue.pop_front (to_run);
+	}
+
+	if (w->deque.pop (to_run)) {
+		return true;
+	}
+
+	if (_trigger_queue.pop_front (to_run)) {
+		return true;
+	}
+
+	/* start with the next thread, to spread the load */
+	size_t n_workers = _workers.size ();
+	for (size_t i = 1; i < n_workers; ++i) {
+		Worker* victim = _workers[(w->id + i) % n_workers];
+		if (victim->deque.steal (to_run)) {
+			++w->stats.nodes_stolen;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/** Busy-wait for up to graph-spin-usecs before going to sleep,
+ * this avoids the wakeup latency of the semaphore when work
+ * becomes available shortly after.
+ */
+bool
+Graph::spin_for_work (Worker* w, GraphNode*& to_run)
+{
+	if (_spin_usecs <= 0) {
+		return false;
+	}
+
+	gint64 until = g_get_monotonic_time () + _spin_usecs;
+
+	/* stop spinning once the cycle is complete */
+	while (g_atomic_uint_get (&_terminal_refcnt) > 0 && !g_atomic_int_get (&_terminate)) {
+		if (g_atomic_uint_get (&_trigger_queue_size) > 0 && find_work (w, to_run)) {
+			return true;
+		}
+		if (g_get_monotonic_time () > until) {
+			break;
+		}
+	}
+	return false;
+}
+
 /** Called by both the main thread and all helpers. */
 void
 Graph::run_one ()
@@ -401,7 +509,9 @@ Graph::run_one ()
 		return;
 	}
 
-	if (_trigger_queue.pop_front (to_run)) {
+	Worker* w = _thread_worker.get ();
+
+	if (find_work (w, to_run) || spin_for_work (w, to_run)) {
 		/* Wake up idle threads, but at most as many as there's
 		 * work in the trigger queue that can be processed by
 		 * other threads.
@@ -422,6 +532,10 @@ Graph::run_one ()
 		g_atomic_int_inc (&_idle_thread_cnt);
 		assert (g_atomic_uint_get (&_idle_thread_cnt) <= _n_workers);
 
+		if (w) {
+			++w->stats.sleeps;
+		}
+
 		DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 goes to sleep\n", pthread_name ()));
 		_execution_sem.wait ();
 
@@ -434,21 +548,27 @@ Graph::run_one ()
 		g_atomic_int_dec_and_test (&_idle_thread_cnt);
 
 		/* Try to find some work to do */
-		_trigger_queue.pop_front (to_run);
+		find_work (w, to_run);
 	}
 
 	/* Process the graph-node */
 	g_atomic_int_dec_and_test (&_trigger_queue_size);
 	to_run->run (_current_chain);
 
+	if (w) {
+		++w->stats.nodes_run;
+	}
+
 	DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 has finished run_one()\n", pthread_name ()));
 }
 
 void
 Graph::helper_thread ()
 {
-	g_atomic_int_inc (&_n_workers);
-	guint id = g_atomic_uint_get (&_n_workers);
+	guint id = g_atomic_int_add (&_n_workers, 1) + 1;
+
+	assert (id < _workers.size ());
+	_thread_worker.set (_workers[id]);
 
 	/* This is needed for ARDOUR::Session requests called from rt-processors
 	 * in particular Lua scripts may do cross-thread calls */
@@ -480,6 +600,9 @@ Graph::main_thread ()
 {
 	/* first time setup */
 
+	assert (!_workers.empty ());
+	_thread_worker.set (_workers[0]);
+
 	suspend_rt_malloc_checks ();
 	ProcessThread* pt = new ProcessThread ();
 
@@ -666,6 +789,14 @@ Graph::process_one_route (Route* route)
 
 	DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 runs route %2\n", pthread_name (), route->name ()));
 
+	const bool     collect_dsp_stats = _process_cycle_start > 0 && DSPStats::enabled ();
+	const uint64_t t0                = collect_dsp_stats ? DSPStats::now () : 0;
+
+	if (collect_dsp_stats) {
+		/* time spent waiting for upstream routes and a free thread */
+		route->graph_wait_stats ().update (t0 - _process_cycle_start);
+	}
+
 	if (_process_noroll) {
 		retval = route->no_roll (_process_nframes, _process_start_sample, _process_end_sample, _process_non_rt_pending);
 	} else {
@@ -679,6 +810,32 @@ Graph::process_one_route (Route* route)
 	if (need_butler) {
 		_process_need_butler = true;
 	}
+
+	if (collect_dsp_stats) {
+		Worker* w = _thread_worker.get ();
+		if (w) {
+			w->stats.busy_usecs += DSPStats::now () - t0;
+		}
+	}
+}
+
+void
+Graph::worker_stats (std::vector<WorkerStats>& stats) const
+{
+	Glib::Threads::Mutex::Lock ls (_swap_mutex);
+	stats.clear ();
+	for (std::vector<Worker*>::const_iterator w = _workers.begin (); w != _workers.end (); ++w) {
+		stats.push_back ((*w)->stats);
+	}
+}
+
+void
+Graph::reset_worker_stats ()
+{
+	Glib::Threads::Mutex::Lock ls (_swap_mutex);
+	for (std::vector<Worker*>::const_iterator w = _workers.begin (); w != _workers.end (); ++w) {
+		(*w)->stats = WorkerStats ();
+	}
 }
 
 bool
@@ -51,6 +51,7 @@
 #include "ardour/disk_reader.h"
 #include "ardour/disk_writer.h"
 #include "ardour/dsp_filter.h"
+#include "ardour/dsp_stats.h"
 #include "ardour/file_source.h"
 #include "ardour/filesystem_paths.h"
 #include "ardour/fluid_synth.h"
@@ -1095,6 +1096,9 @@ LuaBindings::common (lua_State* L)
 		.addFunction ("nth_processor", &Route::nth_processor)
 		.addFunction ("nth_send", &Route::nth_send)
 		.addFunction ("add_foldback_send", &Route::add_foldback_send)
+		.addRefFunction ("get_dsp_stats", &Route::get_dsp_stats)
+		.addRefFunction ("get_graph_wait_stats", &Route::get_graph_wait_stats)
+		.addFunction ("reset_dsp_stats", &Route::reset_dsp_stats)
 		.addFunction ("add_processor_by_index", &Route::add_processor_by_index)
 		.addFunction ("remove_processor", &Route::remove_processor)
 		.addFunction ("remove_processors", &Route::remove_processors)
@@ -1371,6 +1375,13 @@ LuaBindings::common (lua_State* L)
 		.addStaticFunction ("force_zero_latency", &Latent::force_zero_latency)
 		.endClass ()
 
+		.beginClass <DSPStats> ("DSPStats")
+		.addStaticFunction ("enabled", &DSPStats::enabled)
+		.addStaticFunction ("set_enabled", &DSPStats::set_enabled)
+		.addStaticFunction ("window", &DSPStats::window)
+		.addStaticFunction ("set_window", &DSPStats::set_window)
+		.endClass ()
+
 		.deriveWSPtrClass <Automatable, Evoral::ControlSet> ("Automatable")
 		.addCast<Slavable> ("to_slavable")
 		.addFunction ("automation_control", (boost::shared_ptr<AutomationControl>(Automatable::*)(const Evoral::Parameter&, bool))&Automatable::automation_control)
@@ -1459,6 +1470,7 @@ LuaBindings::common (lua_State* L)
 		.addFunction ("output_streams", &Processor::output_streams)
 		.addFunction ("input_streams", &Processor::input_streams)
 		.addFunction ("signal_latency", &Processor::signal_latency)
+		.addRefFunction ("get_dsp_stats", &Processor::get_dsp_stats)
 		.endClass ()
 
 		.deriveWSPtrClass <DiskIOProcessor, Processor> ("DiskIOProcessor")
@@ -249,19 +249,22 @@ MidiModel::NoteDiffCommand::operator() ()
 			_model->remove_note_unlocked(*i);
 		}
 
-		/* notes we modify in a way that requires remove-then-add to maintain ordering */
-		set<NotePtr> temporary_removals;
-
+		/* note not found during deserialization, so try again now that
+		 * the model state is different. Do this before any of the changes
+		 * below remove notes, so that all lookups can use the same index.
+		 */
 		for (ChangeList::iterator i = _changes.begin(); i != _changes.end(); ++i) {
-			Property prop = i->property;
-
 			if (!i->note) {
-				/* note found during deserialization, so try
-				   again now that the model state is different.
-				*/
 				i->note = _model->find_note (i->note_id);
 				assert (i->note);
 			}
+		}
+
+		/* notes we modify in a way that requires remove-then-add to maintain ordering */
+		set<NotePtr> temporary_removals;
+
+		for (ChangeList::iterator i = _changes.begin(); i != _changes.end(); ++i) {
+			Property prop = i->property;
 
 			switch (prop) {
 			case NoteNumber:
@@ -1382,17 +1385,11 @@ MidiModel::find_note (NotePtr other)
 Evoral::Sequence<MidiModel::TimeType>::NotePtr
 MidiModel::find_note (gint note_id)
 {
-	/* used only for looking up notes when reloading history from disk,
-	   so we don't care about performance *too* much.
+	/* used for looking up notes when reloading history from disk,
+	   once per change, so avoid a linear search.
 	*/
 
-	for (Notes::iterator l = notes().begin(); l != notes().end(); ++l) {
-		if ((*l)->id() == note_id) {
-			return *l;
-		}
-	}
-
-	return NotePtr();
+	return note_index()->find (note_id);
 }
 
 MidiModel::PatchChangePtr
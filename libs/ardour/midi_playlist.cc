@@ -23,13 +23,16 @@
 #include <cassert>
 #include <cstdlib>
 #include <iostream>
+#include <limits>
+#include <queue>
 #include <utility>
 
-#include "evoral/EventList.h"
 #include "evoral/Control.h"
 
 #include "ardour/beats_samples_converter.h"
 #include "ardour/debug.h"
+#include "ardour/midi_buffer.h"
+#include "ardour/midi_channel_filter.h"
 #include "ardour/midi_model.h"
 #include "ardour/midi_playlist.h"
 #include "ardour/midi_region.h"
@@ -51,6 +54,10 @@ MidiPlaylist::MidiPlaylist (Session& session, const XMLNode& node, bool hidden)
 	: Playlist (session, node, DataType::MIDI, hidden)
 	, _note_mode(Sustained)
 	, _read_end(0)
+	, _render_all_dirty (true)
+	, _rendered_solo_selection (false)
+	, _rendered_filter_mode (-1)
+	, _rendered_filter_mask (0)
 {
 #ifndef NDEBUG
 	XMLProperty const * prop = node.property("type");
@@ -70,6 +77,10 @@ MidiPlaylist::MidiPlaylist (Session& session, string name, bool hidden)
 	: Playlist (session, name, DataType::MIDI, hidden)
 	, _note_mode(Sustained)
 	, _read_end(0)
+	, _render_all_dirty (true)
+	, _rendered_solo_selection (false)
+	, _rendered_filter_mode (-1)
+	, _rendered_filter_mask (0)
 {
 }
 
@@ -77,6 +88,10 @@ MidiPlaylist::MidiPlaylist (boost::shared_ptr<const MidiPlaylist> other, string
 	: Playlist (other, name, hidden)
 	, _note_mode(other->_note_mode)
 	, _read_end(0)
+	, _render_all_dirty (true)
+	, _rendered_solo_selection (false)
+	, _rendered_filter_mode (-1)
+	, _rendered_filter_mask (0)
 {
 }
 
@@ -88,6 +103,10 @@ MidiPlaylist::MidiPlaylist (boost::shared_ptr<const MidiPlaylist> other,
 	: Playlist (other, start, dur, name, hidden)
 	, _note_mode(other->_note_mode)
 	, _read_end(0)
+	, _render_all_dirty (true)
+	, _rendered_solo_selection (false)
+	, _rendered_filter_mode (-1)
+	, _rendered_filter_mask (0)
 {
 }
 
@@ -95,22 +114,57 @@ MidiPlaylist::~MidiPlaylist ()
 {
 }
 
-template<typename Time>
-struct EventsSortByTimeAndType {
-    bool operator() (const Evoral::Event<Time>* a, const Evoral::Event<Time>* b) {
-	    if (a->time() == b->time()) {
-		    if (parameter_is_midi ((AutomationType)a->event_type()) &&
-		        parameter_is_midi ((AutomationType)b->event_type())) {
-			    /* negate return value since we must return whether
-			     * or not a should sort before b, not b before a
-			     */
-			    return !MidiBuffer::second_simultaneous_midi_byte_is_first (a->buffer()[0], b->buffer()[0]);
-		    }
-	    }
-	    return a->time() < b->time();
-    }
+namespace {
+
+/** next pending event of a region, while merging rendered regions */
+struct MergeHead {
+	MergeHead (size_t b, size_t n, samplepos_t t, uint8_t s)
+		: buf (b), idx (n), time (t), status (s) {}
+
+	size_t      buf;
+	size_t      idx;
+	samplepos_t time;
+	uint8_t     status;
+};
+
+/* std::priority_queue returns the largest element, so this sorts the
+ * head that should be written next last. Simultaneous events are
+ * ordered by type, and by region otherwise.
+ */
+struct MergeHeadLater {
+	bool operator() (MergeHead const& a, MergeHead const& b) const {
+		if (a.time != b.time) {
+			return a.time > b.time;
+		}
+		if (a.status != b.status) {
+			if (MidiBuffer::second_simultaneous_midi_byte_is_first (a.status, b.status)) {
+				return true;
+			}
+			if (MidiBuffer::second_simultaneous_midi_byte_is_first (b.status, a.status)) {
+				return false;
+			}
+		}
+		return a.buf > b.buf;
+	}
 };
 
+/* A region renders its events in [position, position + length], any notes
+ * still active at the end are resolved one sample past the region's end.
+ */
+Evoral::Range<samplepos_t>
+render_range (samplepos_t position, samplecnt_t length)
+{
+	return Evoral::Range<samplepos_t> (position, position + length);
+}
+
+bool
+range_before (Evoral::Range<samplepos_t> const& a, Evoral::Range<samplepos_t> const& b)
+{
+	return a.from < b.from;
+}
+
+}
+
 void
 MidiPlaylist::remove_dependents (boost::shared_ptr<Region> region)
 {
@@ -301,84 +355,266 @@ MidiPlaylist::contained_automation()
 void
 MidiPlaylist::render (MidiChannelFilter* filter)
 {
-	typedef pair<MidiStateTracker*,samplepos_t> TrackerInfo;
-
 	Playlist::RegionReadLock rl (this);
 
 	DEBUG_TRACE (DEBUG::MidiPlaylistIO, string_compose ("---- MidiPlaylist::render (regions: %1)-----\n", regions.size()));
 
-	std::vector< boost::shared_ptr<Region> > regs;
+	const bool solo_selection = _session.solo_selection_active() && SoloSelectedActive();
+
+	std::vector< boost::shared_ptr<MidiRegion> > regs;
 
 	for (RegionList::iterator i = regions.begin(); i != regions.end(); ++i) {
 
 		/* check for the case of solo_selection */
 
-		if (_session.solo_selection_active() && SoloSelectedActive() && !SoloSelectedListIncludes ((const Region*) &(**i))) {
+		if (solo_selection && !SoloSelectedListIncludes ((const Region*) &(**i))) {
 			continue;
 		}
 
-		regs.push_back (*i);
+		boost::shared_ptr<MidiRegion> mr = boost::dynamic_pointer_cast<MidiRegion>(*i);
+
+		if (mr) {
+			regs.push_back (mr);
+		}
 	}
 
-	/* If we are reading from a single region, we can read directly into _rendered.  Otherwise,
-	   we read into a temporarily list, sort it, then write that to _rendered.
-	*/
-	Evoral::EventList<samplepos_t>  evlist;
-	Evoral::EventSink<samplepos_t>* tgt;
+	const int      filter_mode = filter ? (int) filter->get_channel_mode () : -1;
+	const uint16_t filter_mask = filter ? filter->get_channel_mask () : 0;
 
-	/* RAII */
-	RTMidiBuffer::WriteProtectRender wpr (_rendered);
+	std::set<PBD::ID> dirty;
+	bool              full;
 
-	if (regs.empty()) {
-		wpr.acquire ();
-		_rendered.clear ();
-	} else {
+	{
+		Glib::Threads::Mutex::Lock lm (_render_dirty_lock);
+		dirty.swap (_render_dirty_regions);
+		full = _render_all_dirty;
+		_render_all_dirty = false;
+	}
+
+	/* anything that potentially affects every region requires a
+	 * complete render, as does a buffer that is currently reversed.
+	 */
+	full = full
+		|| solo_selection || _rendered_solo_selection
+		|| filter_mode != _rendered_filter_mode || filter_mask != _rendered_filter_mask
+		|| _rendered.reversed ();
+
+	_rendered_solo_selection = solo_selection;
+	_rendered_filter_mode    = filter_mode;
+	_rendered_filter_mask    = filter_mask;
+
+	/* compare the regions to their state when they were last rendered,
+	 * and collect the time ranges that need to be re-rendered.
+	 */
+
+	RenderedRegions rendered_regions;
+	RenderRanges    ranges;
+
+	for (vector<boost::shared_ptr<MidiRegion> >::const_iterator i = regs.begin(); i != regs.end(); ++i) {
+
+		RenderedRegion rr;
 
-		if (regs.size() == 1) {
-			tgt = &_rendered;
-			wpr.acquire ();
-			_rendered.clear ();
-		} else {
-			tgt = &evlist;
+		rr.region   = *i;
+		rr.position = (*i)->position ();
+		rr.length   = (*i)->length ();
+		rr.start    = (*i)->start ();
+		rr.muted    = (*i)->muted ();
+
+		rendered_regions.insert (make_pair ((*i)->id (), rr));
+
+		if (full) {
+			continue;
 		}
 
-		DEBUG_TRACE (DEBUG::MidiPlaylistIO, string_compose ("\t%1 regions to read, direct: %2\n", regs.size(), (regs.size() == 1)));
+		RenderedRegions::const_iterator o = _rendered_regions.find ((*i)->id ());
 
-		for (vector<boost::shared_ptr<Region> >::iterator i = regs.begin(); i != regs.end(); ++i) {
+		if (o == _rendered_regions.end ()) {
+			ranges.push_back (render_range (rr.position, rr.length));
+			continue;
+		}
 
-			boost::shared_ptr<MidiRegion> mr = boost::dynamic_pointer_cast<MidiRegion>(*i);
+		RenderedRegion const& orr (o->second);
 
-			if (!mr) {
-				continue;
+		if (orr.region.lock () != *i || dirty.find ((*i)->id ()) != dirty.end ()
+		    || orr.position != rr.position || orr.length != rr.length || orr.start != rr.start || orr.muted != rr.muted) {
+			ranges.push_back (render_range (orr.position, orr.length));
+			ranges.push_back (render_range (rr.position, rr.length));
+		}
+	}
+
+	if (!full) {
+		for (RenderedRegions::const_iterator o = _rendered_regions.begin (); o != _rendered_regions.end (); ++o) {
+			if (rendered_regions.find (o->first) == rendered_regions.end ()) {
+				/* removed */
+				ranges.push_back (render_range (o->second.position, o->second.length));
 			}
+		}
+	}
+
+	_rendered_regions.swap (rendered_regions);
 
-			DEBUG_TRACE (DEBUG::MidiPlaylistIO, string_compose ("render from %1\n", mr->name()));
-			mr->render (*tgt, 0, _note_mode, filter);
+	if (full) {
+		ranges.clear ();
+		ranges.push_back (Evoral::Range<samplepos_t> (std::numeric_limits<samplepos_t>::min (), std::numeric_limits<samplepos_t>::max ()));
+	} else if (ranges.empty ()) {
+		DEBUG_TRACE (DEBUG::MidiPlaylistIO, "---- End MidiPlaylist::render, nothing changed\n");
+		return;
+	} else {
+		/* coalesce overlapping and adjacent ranges */
+		ranges.sort (range_before);
+		RenderRanges::iterator i = ranges.begin ();
+		RenderRanges::iterator n = i;
+		++n;
+		while (n != ranges.end ()) {
+			if (n->from <= i->to + 1) {
+				i->to = max (i->to, n->to);
+				n = ranges.erase (n);
+			} else {
+				i = n++;
+			}
 		}
+	}
 
-		if (!evlist.empty()) {
-			/* We've read from multiple regions into evlist, sort the event list by time. */
-			EventsSortByTimeAndType<samplepos_t> cmp;
-			evlist.sort (cmp);
+	/* render all regions that intersect a dirty range. The per-region
+	 * data is only needed until it is merged, don't keep it around.
+	 */
 
-			/* Copy ordered events from event list to _rendered. */
+	vector<RTMidiBuffer*> bufs;
 
-			wpr.acquire ();
-			_rendered.clear ();
+	for (vector<boost::shared_ptr<MidiRegion> >::const_iterator i = regs.begin(); i != regs.end(); ++i) {
 
-			for (Evoral::EventList<samplepos_t>::iterator e = evlist.begin(); e != evlist.end(); ++e) {
-				Evoral::Event<samplepos_t>* ev (*e);
-				_rendered.write (ev->time(), ev->event_type(), ev->size(), ev->buffer());
-				delete ev;
-			}
+		Evoral::Range<samplepos_t> const rr (render_range ((*i)->position (), (*i)->length ()));
+
+		bool intersects = false;
+		for (RenderRanges::const_iterator r = ranges.begin (); r != ranges.end () && !intersects; ++r) {
+			intersects = rr.from <= r->to && rr.to >= r->from;
+		}
+
+		if (!intersects) {
+			continue;
 		}
+
+		RTMidiBuffer* buf = new RTMidiBuffer;
+		bufs.push_back (buf);
+
+		DEBUG_TRACE (DEBUG::MidiPlaylistIO, string_compose ("render from %1\n", (*i)->name()));
+		(*i)->render (*buf, 0, _note_mode, filter);
+	}
+
+	DEBUG_TRACE (DEBUG::MidiPlaylistIO, string_compose ("\t%1 range(s), %2 of %3 regions rendered, full: %4\n", ranges.size (), bufs.size (), regs.size (), full));
+
+	RTMidiBuffer merged;
+	merge_rendered (ranges, bufs, merged);
+
+	for (vector<RTMidiBuffer*>::iterator i = bufs.begin(); i != bufs.end(); ++i) {
+		delete *i;
+	}
+
+	{
+		/* RAII, the lock is only required to publish the result */
+		RTMidiBuffer::WriteProtectRender wpr (_rendered);
+		wpr.acquire ();
+		_rendered.swap (merged);
 	}
 
-	/* no need to release - RAII with WriteProtectRender takes care of it */
+	/* merged now holds the previous data, which is freed here */
 
 	DEBUG_TRACE (DEBUG::MidiPlaylistIO, string_compose ("---- End MidiPlaylist::render, events: %1\n", _rendered.size()));
 }
 
+/** Assemble the new rendered data in \p dst: events of _rendered
+ * outside of the given (sorted, non-overlapping) ranges are retained,
+ * events inside them are replaced by a k-way merge of the time-ordered
+ * region data in \p bufs.
+ */
+void
+MidiPlaylist::merge_rendered (RenderRanges const& ranges, vector<RTMidiBuffer*> const& bufs, RTMidiBuffer& dst)
+{
+	size_t pos = 0;
+
+	for (RenderRanges::const_iterator r = ranges.begin (); r != ranges.end (); ++r) {
+
+		const size_t lo = _rendered.lower_bound (r->from);
+
+		if (lo > pos) {
+			dst.append (_rendered, pos, lo);
+		}
+
+		pos = max (pos, _rendered.upper_bound (r->to));
+
+		std::priority_queue<MergeHead, vector<MergeHead>, MergeHeadLater> heads;
+
+		for (size_t b = 0; b < bufs.size (); ++b) {
+			const size_t n = bufs[b]->lower_bound (r->from);
+			if (n < bufs[b]->size () && bufs[b]->timestamp (n) <= r->to) {
+				uint32_t size;
+				heads.push (MergeHead (b, n, bufs[b]->timestamp (n), bufs[b]->event (n, size)[0]));
+			}
+		}
+
+		while (!heads.empty ()) {
+			MergeHead h (heads.top ());
+			heads.pop ();
+
+			RTMidiBuffer const* buf = bufs[h.buf];
+
+			uint32_t       size;
+			uint8_t const* data = buf->event (h.idx, size);
+
+			dst.write (h.time, Evoral::MIDI_EVENT, size, data);
+
+			if (++h.idx < buf->size () && buf->timestamp (h.idx) <= r->to) {
+				h.time   = buf->timestamp (h.idx);
+				h.status = buf->event (h.idx, size)[0];
+				heads.push (h);
+			}
+		}
+	}
+
+	if (pos < _rendered.size ()) {
+		dst.append (_rendered, pos, _rendered.size ());
+	}
+}
+
+void
+MidiPlaylist::set_note_mode (NoteMode m)
+{
+	if (_note_mode == m) {
+		return;
+	}
+
+	_note_mode = m;
+
+	Glib::Threads::Mutex::Lock lm (_render_dirty_lock);
+	_render_all_dirty = true;
+}
+
+void
+MidiPlaylist::update_after_tempo_map_change ()
+{
+	/* region positions may remain unchanged, but event times do not */
+	{
+		Glib::Threads::Mutex::Lock lm (_render_dirty_lock);
+		_render_all_dirty = true;
+	}
+
+	Playlist::update_after_tempo_map_change ();
+}
+
+bool
+MidiPlaylist::region_changed (const PBD::PropertyChange& what_changed, boost::shared_ptr<Region> region)
+{
+	/* changes of region bounds are detected by render (), only
+	 * edits of the region's model need to be tracked.
+	 */
+	if (what_changed.contains (Properties::contents)) {
+		Glib::Threads::Mutex::Lock lm (_render_dirty_lock);
+		_render_dirty_regions.insert (region->id ());
+	}
+
+	return Playlist::region_changed (what_changed, region);
+}
+
 RTMidiBuffer*
 MidiPlaylist::rendered ()
 {
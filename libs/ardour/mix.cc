@@ -145,6 +145,78 @@ default_copy_vector (ARDOUR::Sample * dst, const ARDOUR::Sample * src, pframes_t
 	memcpy(dst, src, nframes*sizeof(ARDOUR::Sample));
 }
 
+float
+default_apply_gain_ramp (ARDOUR::Sample * buf, pframes_t nframes, float initial, float target, float coeff)
+{
+	float g = initial;
+	for (pframes_t i = 0; i < nframes; ++i) {
+		buf[i] *= g;
+		g += coeff * (target - g);
+	}
+	return g;
+}
+
+void
+default_apply_gain_curve (ARDOUR::Sample * buf, const ARDOUR::gain_t * gain, pframes_t nframes)
+{
+	for (pframes_t i = 0; i < nframes; ++i) {
+		buf[i] *= gain[i];
+	}
+}
+
+void
+default_apply_inverse_gain_curve (ARDOUR::Sample * buf, const ARDOUR::gain_t * gain, pframes_t nframes)
+{
+	for (pframes_t i = 0; i < nframes; ++i) {
+		buf[i] *= 1.f - gain[i];
+	}
+}
+
+void
+default_mix_buffers_with_curve (ARDOUR::Sample * dst, const ARDOUR::Sample * src, const ARDOUR::gain_t * gain, pframes_t nframes)
+{
+	for (pframes_t i = 0; i < nframes; ++i) {
+		dst[i] += src[i] * gain[i];
+	}
+}
+
+void
+default_interleave (ARDOUR::Sample * dst, const ARDOUR::Sample * src, uint32_t stride, pframes_t nframes)
+{
+	for (pframes_t i = 0; i < nframes; ++i) {
+		*dst = src[i];
+		dst += stride;
+	}
+}
+
+void
+default_deinterleave (ARDOUR::Sample * dst, const ARDOUR::Sample * src, uint32_t stride, pframes_t nframes, float gain)
+{
+	if (gain != 1.f) {
+		for (pframes_t i = 0; i < nframes; ++i) {
+			dst[i] = *src * gain;
+			src += stride;
+		}
+	} else {
+		for (pframes_t i = 0; i < nframes; ++i) {
+			dst[i] = *src;
+			src += stride;
+		}
+	}
+}
+
+void
+default_clip_buffer (ARDOUR::Sample * buf, pframes_t nframes, float limit)
+{
+	for (pframes_t i = 0; i < nframes; ++i) {
+		if (buf[i] > limit) {
+			buf[i] = limit;
+		} else if (buf[i] < -limit) {
+			buf[i] = -limit;
+		}
+	}
+}
+
 #if defined (__APPLE__) && defined (BUILD_VECLIB_OPTIMIZATIONS)
 #include <Accelerate/Accelerate.h>
 
@@ -337,6 +337,7 @@ Playlist::init (bool hide)
 
 	g_atomic_int_set (&block_notifications, 0);
 	g_atomic_int_set (&ignore_state_changes, 0);
+	g_atomic_int_set (&_region_index_dirty, 1);
 	pending_contents_change     = false;
 	pending_layering            = false;
 	first_set_state             = true;
@@ -1737,6 +1738,10 @@ Playlist::region_changed (const PropertyChange& what_changed, boost::shared_ptr<
 	PropertyChange bounds;
 	bool           save = false;
 
+	if (what_changed.contains (Properties::position) || what_changed.contains (Properties::length)) {
+		invalidate_region_index ();
+	}
+
 	if (in_set_state || in_flush) {
 		return false;
 	}
@@ -1983,15 +1988,36 @@ Playlist::regions_touched (samplepos_t start, samplepos_t end)
 boost::shared_ptr<RegionList>
 Playlist::regions_touched_locked (samplepos_t start, samplepos_t end)
 {
-	boost::shared_ptr<RegionList> rlist (new RegionList);
+	RegionIndex::RegionVector rv;
+	regions_touched_locked (start, end, rv);
+	return boost::shared_ptr<RegionList> (new RegionList (rv.begin (), rv.end ()));
+}
 
-	for (RegionList::iterator i = regions.begin (); i != regions.end (); ++i) {
-		if ((*i)->coverage (start, end) != Evoral::OverlapNone) {
-			rlist->push_back (*i);
+void
+Playlist::regions_touched_locked (samplepos_t start, samplepos_t end, RegionIndex::RegionVector& rv) const
+{
+	rv.clear ();
+
+	Glib::Threads::RWLock::ReaderLock lm (_region_index_lock);
+
+	while (g_atomic_int_get (&_region_index_dirty)) {
+		lm.release ();
+		{
+			Glib::Threads::RWLock::WriterLock wl (_region_index_lock);
+			if (g_atomic_int_compare_and_exchange (&_region_index_dirty, 1, 0)) {
+				_region_index.rebuild (regions.rlist ());
+			}
 		}
+		lm.acquire ();
 	}
 
-	return rlist;
+	_region_index.find_touched (start, end, rv);
+}
+
+void
+Playlist::invalidate_region_index () const
+{
+	g_atomic_int_set (&_region_index_dirty, 1);
 }
 
 samplepos_t
@@ -2184,6 +2210,7 @@ void
 Playlist::mark_session_dirty ()
 {
 	_cached_extent.reset ();
+	invalidate_region_index ();
 
 	if (!in_set_state && !holding_state ()) {
 		_session.set_dirty ();
@@ -35,6 +35,7 @@
 #include "ardour/audio_buffer.h"
 #include "ardour/automation_list.h"
 #include "ardour/buffer_set.h"
+#include "ardour/dB.h"
 #include "ardour/debug.h"
 #include "ardour/event_type_map.h"
 #include "ardour/ladspa_plugin.h"
@@ -92,6 +93,9 @@ PluginInsert::PluginInsert (Session& s, boost::shared_ptr<Plugin> plug)
 	, _inverted_bypass_enable (false)
 	, _stat_reset (0)
 	, _flush (0)
+	, _silent_input_samples (0)
+	, _silent_output_samples (0)
+	, _sleeping (false)
 {
 	/* the first is the master */
 
@@ -905,6 +909,24 @@ PluginInsert::connect_and_run (BufferSet& bufs, samplepos_t start, samplepos_t e
 		in_map[0] = ChanMapping (natural_input_streams ());
 	}
 
+	/* Effects whose input has been silent for longer than their tail are
+	 * put to sleep once their output has decayed, too (see below).
+	 * Generators (no inputs) and instruments (which may sustain notes
+	 * without receiving further events) are always processed.
+	 */
+	const bool input_silent = Config->get_sleep_silent_plugins ()
+		&& natural_input_streams ().n_audio () > 0
+		&& natural_input_streams ().n_midi () == 0
+		&& bufs.silent (nframes, offset, GAIN_COEFF_SMALL);
+
+	if (!input_silent) {
+		_silent_input_samples  = 0;
+		_silent_output_samples = 0;
+		_sleeping              = false;
+	} else if (!_sleeping) {
+		_silent_input_samples += nframes;
+	}
+
 	bufs.set_count(ChanCount::max(bufs.count(), _configured_internal));
 	bufs.set_count(ChanCount::max(bufs.count(), _configured_out));
 
@@ -968,6 +990,16 @@ PluginInsert::connect_and_run (BufferSet& bufs, samplepos_t start, samplepos_t e
 		_signal_analysis_collect_nsamples += nframes;
 	}
 
+	if (_sleeping) {
+		/* input and output are silent, as is any thru-data */
+		for (DataType::iterator t = DataType::begin(); t != DataType::end(); ++t) {
+			for (uint32_t out = 0; out < bufs.count().get (*t); ++out) {
+				bufs.get_available (*t, out).silence (nframes, offset);
+			}
+		}
+		return;
+	}
+
 #ifdef MIXBUS
 	if (is_channelstrip ()) {
 		if (_configured_in.n_audio() > 0) {
@@ -1088,6 +1120,29 @@ PluginInsert::connect_and_run (BufferSet& bufs, samplepos_t start, samplepos_t e
 		inplace_silence_unconnected (bufs, _out_map, nframes, offset);
 	}
 
+	if (input_silent) {
+		/* the plugin may still produce output for signal_tail() samples,
+		 * also wait for latent input to be flushed. Most plugins do not
+		 * report a tail, in which case the output (e.g. echoes of a delay)
+		 * has to remain silent for a few seconds.
+		 */
+		const samplecnt_t settle = 4 * _session.nominal_sample_rate ();
+		samplecnt_t       tail   = _plugins.front()->signal_tail ();
+		if (tail == 0) {
+			tail = settle;
+		}
+		tail = std::max (tail, effective_latency ());
+
+		if (bufs.silent (nframes, offset, GAIN_COEFF_SMALL)) {
+			_silent_output_samples += nframes;
+		} else {
+			_silent_output_samples = 0;
+		}
+		if (_silent_input_samples > tail && _silent_output_samples > std::min (tail, settle)) {
+			_sleeping = true;
+		}
+	}
+
 	const samplecnt_t l = effective_latency ();
 	if (_plugin_signal_latency != l) {
 		_plugin_signal_latency = l;
@@ -1272,6 +1327,9 @@ PluginInsert::run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_sa
 		for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i) {
 			(*i)->flush ();
 		}
+		_silent_input_samples  = 0;
+		_silent_output_samples = 0;
+		_sleeping              = false;
 	}
 
 	if (_pending_active) {
@@ -1305,6 +1363,9 @@ PluginInsert::run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_sa
 		bypass (bufs, nframes);
 		automation_run (start_sample, nframes, true); // evaluate automation only
 		_delaybuffers.flush ();
+		_silent_input_samples  = 0;
+		_silent_output_samples = 0;
+		_sleeping              = false;
 	}
 
 	_active = _pending_active;
@@ -2680,8 +2741,13 @@ PluginInsert::set_state(const XMLNode& node, int version)
 	node.get_property ("count", count);
 
 	if (_plugins.empty()) {
-		/* Find and load plugin module */
-		boost::shared_ptr<Plugin> plugin = find_plugin (_session, prop->value(), type);
+		/* Find and load plugin module, unless it was already instantiated
+		 * in the background while loading the session.
+		 */
+		boost::shared_ptr<Plugin> plugin = _session.preloaded_plugin (node);
+		if (!plugin) {
+			plugin = find_plugin (_session, prop->value(), type);
+		}
 
 		/* treat VST plugins equivalent if they have the same uniqueID
 		 * allow to move sessions windows <> linux */
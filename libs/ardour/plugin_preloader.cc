@@ -0,0 +1,216 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cassert>
+
+#include <boost/bind.hpp>
+
+#include "pbd/compose.h"
+#include "pbd/cpus.h"
+#include "pbd/debug.h"
+#include "pbd/error.h"
+#include "pbd/pthread_utils.h"
+#include "pbd/xml++.h"
+
+#include "ardour/ardour.h"
+#include "ardour/debug.h"
+#include "ardour/plugin_preloader.h"
+#include "ardour/session.h"
+
+#include "pbd/i18n.h"
+
+using namespace ARDOUR;
+using namespace PBD;
+using namespace std;
+
+PluginPreloader::PluginPreloader (Session& s)
+	: _session (s)
+{
+	g_atomic_int_set (&_next, 0);
+	g_atomic_int_set (&_done, 0);
+}
+
+PluginPreloader::~PluginPreloader ()
+{
+	/* the session may fail to load before routes are created */
+	for (vector<Glib::Threads::Thread*>::const_iterator i = _threads.begin (); i != _threads.end (); ++i) {
+		(*i)->join ();
+	}
+}
+
+void
+PluginPreloader::queue (XMLNode const& node)
+{
+	std::string str;
+	if (node.name () != X_("Processor") || !node.get_property (X_("type"), str)) {
+		return;
+	}
+
+	PluginType type;
+	if (str == X_("ladspa") || str == X_("Ladspa")) {
+		type = ARDOUR::LADSPA;
+	} else if (str == X_("lv2")) {
+		type = ARDOUR::LV2;
+	} else {
+		return;
+	}
+
+	XMLProperty const* uid = node.property (X_("unique-id"));
+	if (!uid || !node.get_property (X_("id"), str)) {
+		return;
+	}
+
+	Jobs& jobs (type == ARDOUR::LV2 ? _serial : _parallel);
+	_by_id[PBD::ID (str)] = make_pair (&jobs, jobs.size ());
+	jobs.push_back (Job (uid->value (), type));
+}
+
+void
+PluginPreloader::start (XMLNode const& routes)
+{
+	assert (_threads.empty ());
+
+	XMLNodeList const& rl (routes.children ());
+	for (XMLNodeConstIterator r = rl.begin (); r != rl.end (); ++r) {
+		if ((*r)->name () != X_("Route")) {
+			continue;
+		}
+		XMLNodeList const& pl ((*r)->children ());
+		for (XMLNodeConstIterator p = pl.begin (); p != pl.end (); ++p) {
+			queue (**p);
+		}
+	}
+
+	uint32_t n_threads = std::min<uint32_t> (hardware_concurrency (), _parallel.size ());
+
+	DEBUG_TRACE (DEBUG::Processors, string_compose ("Preloading %1 LADSPA plugins using %2 threads, %3 LV2 plugins\n", _parallel.size (), n_threads, _serial.size ()));
+
+	try {
+		for (uint32_t i = 0; i < n_threads; ++i) {
+			_threads.push_back (Glib::Threads::Thread::create (boost::bind (&PluginPreloader::run_parallel, this)));
+		}
+	} catch (Glib::Threads::ThreadError const&) {
+		/* PluginInsert::set_state falls back to instantiating the plugin */
+		if (_threads.empty ()) {
+			g_atomic_int_add (&_done, _parallel.size ());
+		}
+	}
+
+	if (_serial.empty ()) {
+		return;
+	}
+
+	try {
+		_threads.push_back (Glib::Threads::Thread::create (boost::bind (&PluginPreloader::run_serial, this)));
+	} catch (Glib::Threads::ThreadError const&) {
+		g_atomic_int_add (&_done, _serial.size ());
+	}
+}
+
+void
+PluginPreloader::join ()
+{
+	gint const total = _parallel.size () + _serial.size ();
+	gint reported    = -1;
+
+	Glib::Threads::Mutex::Lock lm (_progress_lock);
+	while (true) {
+		gint const done = g_atomic_int_get (&_done);
+		if (done != reported && total > 0) {
+			lm.release ();
+			BootMessage (string_compose (_("Loaded plugin %1 of %2"), done, total));
+			lm.acquire ();
+			reported = done;
+			continue;
+		}
+		if (done >= total) {
+			break;
+		}
+		_progress_cond.wait (_progress_lock);
+	}
+	lm.release ();
+
+	for (vector<Glib::Threads::Thread*>::const_iterator i = _threads.begin (); i != _threads.end (); ++i) {
+		(*i)->join ();
+	}
+	_threads.clear ();
+}
+
+PluginPtr
+PluginPreloader::take (XMLNode const& node)
+{
+	assert (_threads.empty ());
+
+	std::string str;
+	XMLProperty const* uid = node.property (X_("unique-id"));
+	if (!uid || !node.get_property (X_("id"), str)) {
+		return PluginPtr ();
+	}
+
+	map<PBD::ID, pair<Jobs*, size_t> >::const_iterator i = _by_id.find (PBD::ID (str));
+	if (i == _by_id.end ()) {
+		return PluginPtr ();
+	}
+
+	Job& job ((*i->second.first)[i->second.second]);
+	if (job.unique_id != uid->value ()) {
+		return PluginPtr ();
+	}
+
+	PluginPtr rv;
+	rv.swap (job.plugin);
+	return rv;
+}
+
+void
+PluginPreloader::run_parallel ()
+{
+	pthread_set_name ("PluginLoader");
+
+	while (true) {
+		gint n = g_atomic_int_add (&_next, 1);
+		if (n >= (gint)_parallel.size ()) {
+			break;
+		}
+		load (_parallel[n]);
+	}
+}
+
+void
+PluginPreloader::run_serial ()
+{
+	pthread_set_name ("LV2PluginLoader");
+
+	for (Jobs::iterator i = _serial.begin (); i != _serial.end (); ++i) {
+		load (*i);
+	}
+}
+
+void
+PluginPreloader::load (Job& job)
+{
+	try {
+		job.plugin = find_plugin (_session, job.unique_id, job.type);
+	} catch (...) {
+		job.plugin.reset ();
+	}
+
+	g_atomic_int_inc (&_done);
+
+	Glib::Threads::Mutex::Lock lm (_progress_lock);
+	_progress_cond.signal ();
+}
@@ -19,10 +19,12 @@
  */
 
 #include <regex.h>
+#include <string.h>
 
 #include "pbd/error.h"
 
 #include "ardour/port_engine_shared.h"
+#include "ardour/runtime_functions.h"
 
 #include "pbd/i18n.h"
 
@@ -32,6 +34,7 @@ BackendPort::BackendPort (PortEngineSharedImpl &b, const std::string& name, Port
 	: _backend (b)
 	, _name  (name)
 	, _flags (flags)
+	, _connection_table (new ConnectionTable)
 {
 	_capture_latency_range.min = 0;
 	_capture_latency_range.max = 0;
@@ -96,6 +99,7 @@ void
 BackendPort::store_connection (BackendPortHandle port)
 {
 	_connections.insert (port);
+	update_connection_table ();
 }
 
 int
@@ -125,17 +129,80 @@ void BackendPort::remove_connection (BackendPortHandle port)
 	std::set<BackendPortPtr>::iterator it = _connections.find (port);
 	assert (it != _connections.end ());
 	_connections.erase (it);
+	update_connection_table ();
 }
 
 
 void BackendPort::disconnect_all (BackendPortHandle self)
 {
+	std::vector<BackendPortPtr> peers;
 	while (!_connections.empty ()) {
 		std::set<BackendPortPtr>::iterator it = _connections.begin ();
 		(*it)->remove_connection (self);
 		_backend.port_connect_callback (name(), (*it)->name(), false);
+		peers.push_back (*it);
 		_connections.erase (it);
 	}
+	update_connection_table ();
+
+	/* release references held by previous tables, the process thread
+	 * may use those until the end of the current cycle.
+	 */
+	_connection_table.flush ();
+	for (std::vector<BackendPortPtr>::const_iterator it = peers.begin (); it != peers.end (); ++it) {
+		(*it)->_connection_table.flush ();
+	}
+}
+
+void
+BackendPort::update_connection_table ()
+{
+	RCUWriter<ConnectionTable> writer (_connection_table);
+	boost::shared_ptr<ConnectionTable> ct = writer.get_copy ();
+	ct->clear ();
+	for (std::set<BackendPortPtr>::const_iterator it = _connections.begin (); it != _connections.end (); ++it) {
+		ct->push_back (*it);
+	}
+}
+
+Sample*
+BackendPort::get_audio_input_buffer (Sample* buf, pframes_t n_samples)
+{
+	assert (is_input () && type () == DataType::AUDIO);
+
+	if (RCUCycle::active ()) {
+		return mix_connections (*_connection_table.rt_reader (), buf, n_samples);
+	}
+
+	/* backends read playback ports after the engine's process cycle */
+	boost::shared_ptr<ConnectionTable> ct = _connection_table.reader ();
+	return mix_connections (*ct, buf, n_samples);
+}
+
+Sample*
+BackendPort::mix_connections (ConnectionTable const& ct, Sample* buf, pframes_t n_samples)
+{
+	switch (ct.size ()) {
+		case 0:
+			memset (buf, 0, n_samples * sizeof (Sample));
+			return buf;
+		case 1:
+			/* no need to copy, input port buffers are read-only
+			 * (JACK does the same).
+			 */
+			return static_cast<Sample*> (ct.front ()->get_buffer (n_samples));
+		default:
+			break;
+	}
+
+	ConnectionTable::const_iterator it = ct.begin ();
+	assert ((*it)->is_output ());
+	copy_vector (buf, static_cast<Sample const*> ((*it)->get_buffer (n_samples)), n_samples);
+	while (++it != ct.end ()) {
+		assert ((*it)->is_output ());
+		mix_buffers_no_gain (buf, static_cast<Sample const*> ((*it)->get_buffer (n_samples)), n_samples);
+	}
+	return buf;
 }
 
 bool
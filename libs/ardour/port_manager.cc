@@ -19,6 +19,7 @@
  */
 
 #include <algorithm>
+#include <cmath>
 #include <vector>
 
 #ifdef COMPILER_MSVC
@@ -32,6 +33,7 @@
 #include <glibmm/miscutils.h>
 
 #include "pbd/error.h"
+#include "pbd/malign.h"
 #include "pbd/strsplit.h"
 #include "pbd/unwind.h"
 
@@ -45,7 +47,9 @@
 #include "ardour/midiport_manager.h"
 #include "ardour/port_manager.h"
 #include "ardour/profile.h"
+#include "ardour/rc_configuration.h"
 #include "ardour/rt_tasklist.h"
+#include "ardour/runtime_functions.h"
 #include "ardour/session.h"
 #include "ardour/types_convert.h"
 
@@ -66,6 +70,46 @@ PortManager::MIDIInputPort::MIDIInputPort (samplecnt_t sz)
 	, meter (MIDIPortMeter (new MPM))
 {}
 
+PortManager::ResampledInput::ResampledInput (PortEngine::PortHandle ph, pframes_t nframes)
+	: port (ph)
+	, data (0)
+{
+	src.setup (Port::resampler_quality ());
+	src.set_rrfilt (10);
+	set_buffer_size (nframes);
+}
+
+PortManager::ResampledInput::~ResampledInput ()
+{
+	cache_aligned_free (data);
+}
+
+void
+PortManager::ResampledInput::set_buffer_size (pframes_t nframes)
+{
+	/* same size as AudioPort::_data */
+	cache_aligned_free (data);
+	cache_aligned_malloc ((void**) &data, sizeof (Sample) * lrint (floor (nframes * Config->get_max_transport_speed())));
+}
+
+void
+PortManager::ResampledInput::cycle_start (pframes_t nframes)
+{
+	/* see AudioPort::cycle_start () */
+	pframes_t const cycle_nframes = Port::cycle_nframes ();
+
+	src.inp_data  = (float*)AudioEngine::instance()->port_engine().get_buffer (port, nframes);
+	src.inp_count = nframes;
+	src.out_count = cycle_nframes;
+	src.set_rratio (cycle_nframes / (double)nframes);
+	src.out_data  = data;
+	src.process ();
+	while (src.out_count > 0) {
+		*src.out_data =  src.out_data[-1];
+		++src.out_data;
+		--src.out_count;
+	}
+}
 
 PortManager::PortID::PortID (boost::shared_ptr<AudioBackend> b, DataType dt, bool in, std::string const& pn)
 	: backend (b->name ())
@@ -141,6 +185,10 @@ PortManager::PortManager ()
 	: ports (new Ports)
 	, _port_remove_in_progress (false)
 	, _port_deletions_pending (8192) /* ick, arbitrary sizing */
+	, _cycle_ports (0)
+	, _resampled_inputs (new ResampledInputs)
+	, _cycle_resampled_inputs (0)
+	, _resampled_inputs_generation (0)
 	, _midi_info_dirty (true)
 	, _audio_input_ports (new AudioInputPorts)
 	, _midi_input_ports (new MIDIInputPorts)
@@ -179,9 +227,17 @@ PortManager::remove_all_ports ()
 		ps->clear ();
 	}
 
+	{
+		RCUWriter<ResampledInputs> writer (_resampled_inputs);
+		boost::shared_ptr<ResampledInputs> ri = writer.get_copy ();
+		ri->sources.clear ();
+		ri->ports.clear ();
+	}
+
 	/* clear dead wood list in RCU */
 
 	ports.flush ();
+	_resampled_inputs.flush ();
 
 	/* clear out pending port deletion list. we know this is safe because
 	 * the auto connect thread in Session is already dead when this is
@@ -562,6 +618,8 @@ PortManager::unregister_port (boost::shared_ptr<Port> port)
 		/* writer goes out of scope, forces update */
 	}
 
+	drop_resampled_input (port);
+
 	ports.flush ();
 
 	return 0;
@@ -704,6 +762,16 @@ PortManager::reestablish_ports ()
 	boost::shared_ptr<Ports> p = ports.reader ();
 	DEBUG_TRACE (DEBUG::Ports, string_compose ("reestablish %1 ports\n", p->size()));
 
+	{
+		/* backend port handles are about to change, shared
+		 * sources are re-discovered when ports are reconnected.
+		 */
+		RCUWriter<ResampledInputs> writer (_resampled_inputs);
+		boost::shared_ptr<ResampledInputs> ri = writer.get_copy ();
+		ri->sources.clear ();
+		ri->ports.clear ();
+	}
+
 	for (i = p->begin(); i != p->end(); ++i) {
 		if (i->second->reestablish ()) {
 			error << string_compose (_("Re-establising port %1 failed"), i->second->name()) << endmsg;
@@ -814,6 +882,12 @@ PortManager::connect_callback (const string& a, const string& b, bool conn)
 		}
 	}
 
+	/* this may be called from the process thread. Until the shared
+	 * sources are updated, inputs are resampled individually.
+	 */
+	g_atomic_int_inc (&_resampled_inputs_generation);
+	request_resampled_inputs_update ();
+
 	PortConnectedOrDisconnected (
 		port_a, a,
 		port_b, b,
@@ -1021,7 +1095,13 @@ PortManager::cycle_start (pframes_t nframes, Session* s)
 	Port::set_global_port_buffer_offset (0);
 	Port::set_cycle_samplecnt (nframes);
 
-	_cycle_ports = ports.reader ();
+	_cycle_ports = ports.rt_reader ();
+	_cycle_resampled_inputs = _resampled_inputs.rt_reader ();
+
+	if (_cycle_resampled_inputs->generation != g_atomic_int_get (&_resampled_inputs_generation)) {
+		/* connections changed since the sources were looked up */
+		_cycle_resampled_inputs = &_no_resampled_inputs;
+	}
 
 	/* TODO optimize
 	 *  - when speed == 1.0, the resampler copies data without processing
@@ -1036,29 +1116,193 @@ PortManager::cycle_start (pframes_t nframes, Session* s)
 	 *    amount of work (how many connected ports are there, how
 	 *    many resamplers need to run) vs. available CPU cores and semaphore
 	 *    synchronization overhead.
-	 *
-	 *  - input ports: it would make sense to resample each input only once
-	 *    (rather than resample into each ardour-owned input port).
-	 *    A single external source-port may be connected to many ardour
-	 *    input-ports. Currently re-sampling is per input.
 	 */
+	ResampledSources const& rs (_cycle_resampled_inputs->sources);
+	ResampledPorts const&   rp (_cycle_resampled_inputs->ports);
+
 	if (s && s->rt_tasklist () && fabs (Port::speed_ratio ()) != 1.0) {
 		RTTaskList::TaskList tl;
+
+		/* resample each external source once .. */
+		for (ResampledSources::const_iterator r = rs.begin(); r != rs.end(); ++r) {
+			tl.push_back (boost::bind (&ResampledInput::cycle_start, r->second.get (), nframes));
+		}
+		if (!tl.empty ()) {
+			s->rt_tasklist()->process (tl);
+			tl.clear ();
+		}
+
+		/* .. and share the result with all input ports connected to it */
 		for (Ports::iterator p = _cycle_ports->begin(); p != _cycle_ports->end(); ++p) {
-			if (!(p->second->flags() & TransportSyncPort)) {
+			if (p->second->flags() & TransportSyncPort) {
+				continue;
+			}
+			ResampledPorts::const_iterator r = rp.find (p->second.get ());
+			if (r != rp.end ()) {
+				tl.push_back (boost::bind (&PortManager::resampled_port_cycle_start, this, static_cast<AudioPort*> (p->second.get ()), boost::cref (r->second), nframes));
+			} else {
 				tl.push_back (boost::bind (&Port::cycle_start, p->second, nframes));
 			}
 		}
 		s->rt_tasklist()->process (tl);
 	} else {
+		for (ResampledSources::const_iterator r = rs.begin(); r != rs.end(); ++r) {
+			r->second->cycle_start (nframes);
+		}
 		for (Ports::iterator p = _cycle_ports->begin(); p != _cycle_ports->end(); ++p) {
-			if (!(p->second->flags() & TransportSyncPort)) {
+			if (p->second->flags() & TransportSyncPort) {
+				continue;
+			}
+			ResampledPorts::const_iterator r = rp.find (p->second.get ());
+			if (r != rp.end ()) {
+				resampled_port_cycle_start (static_cast<AudioPort*> (p->second.get ()), r->second, nframes);
+			} else {
 				p->second->cycle_start (nframes);
 			}
 		}
 	}
 }
 
+/** Replaces AudioPort::cycle_start () for input ports that are only
+ * connected to external sources, which were already resampled.
+ * The resampler is linear, so resampling the sum of the sources
+ * is equivalent to summing the resampled sources.
+ */
+void
+PortManager::resampled_port_cycle_start (AudioPort* ap, std::vector<ResampledInput*> const& sources, pframes_t nframes)
+{
+	ap->Port::cycle_start (nframes);
+
+	pframes_t const cycle_nframes = Port::cycle_nframes ();
+
+	std::vector<ResampledInput*>::const_iterator i = sources.begin ();
+	copy_vector (ap->_data, (*i)->data, cycle_nframes);
+	for (++i; i != sources.end (); ++i) {
+		mix_buffers_no_gain (ap->_data, (*i)->data, cycle_nframes);
+	}
+}
+
+/** Find the external sources of all Ardour audio input ports.
+ * A port shares resampled data if all of its connections are to
+ * external ports, otherwise AudioPort::cycle_start() resamples
+ * the backend's (mixed) port buffer.
+ */
+void
+PortManager::update_resampled_inputs ()
+{
+	boost::shared_ptr<AudioBackend> backend (_backend);
+
+	if (!backend || _port_remove_in_progress) {
+		return;
+	}
+
+	/* connections that change from now on bump the generation again */
+	const gint generation = g_atomic_int_get (&_resampled_inputs_generation);
+
+	typedef std::map<Port const*, vector<PortEngine::PortPtr> > PortSources;
+	PortSources port_sources;
+
+	boost::shared_ptr<Ports> pr = ports.reader ();
+
+	for (Ports::const_iterator i = pr->begin (); i != pr->end (); ++i) {
+		boost::shared_ptr<Port> const& port (i->second);
+
+		if (port->type () != DataType::AUDIO || !port->receives_input () || (port->flags () & TransportSyncPort) || !port->port_handle ()) {
+			continue;
+		}
+
+		vector<string> connections;
+		vector<PortEngine::PortPtr> handles;
+
+		backend->get_connections (port->port_handle (), connections);
+
+		for (vector<string>::const_iterator c = connections.begin (); c != connections.end (); ++c) {
+			PortEngine::PortPtr ph;
+			if (!port_is_mine (*c)) {
+				ph = backend->get_port_by_name (*c);
+			}
+			if (!ph) {
+				/* internal connection, or unknown port */
+				handles.clear ();
+				break;
+			}
+			handles.push_back (ph);
+		}
+
+		if (!handles.empty ()) {
+			port_sources[port.get ()].swap (handles);
+		}
+	}
+
+	{
+		RCUWriter<ResampledInputs>         writer (_resampled_inputs);
+		boost::shared_ptr<ResampledInputs> ri = writer.get_copy ();
+
+		/* ports may have been unregistered meanwhile */
+		boost::shared_ptr<Ports> current = ports.reader ();
+
+		ResampledSources sources;
+		ri->ports.clear ();
+
+		for (PortSources::const_iterator i = port_sources.begin (); i != port_sources.end (); ++i) {
+			Ports::const_iterator x = current->find (make_port_name_relative (i->first->name ()));
+			if (x == current->end () || x->second.get () != i->first) {
+				continue;
+			}
+
+			std::vector<ResampledInput*>& rv (ri->ports[i->first]);
+
+			for (vector<PortEngine::PortPtr>::const_iterator h = i->second.begin (); h != i->second.end (); ++h) {
+				ResampledSources::iterator r = sources.find (*h);
+				if (r == sources.end ()) {
+					ResampledSources::const_iterator o = ri->sources.find (*h);
+					if (o != ri->sources.end ()) {
+						r = sources.insert (*o).first;
+					} else {
+						r = sources.insert (make_pair (*h, boost::shared_ptr<ResampledInput> (new ResampledInput (*h, AudioEngine::instance()->samples_per_cycle())))).first;
+					}
+				}
+				rv.push_back (r->second.get ());
+			}
+		}
+
+		/* sources that are no longer used go with the previous copy */
+		ri->sources.swap (sources);
+		ri->generation = generation;
+	}
+
+	_resampled_inputs.flush ();
+}
+
+void
+PortManager::drop_resampled_input (boost::shared_ptr<Port> port)
+{
+	{
+		RCUWriter<ResampledInputs>         writer (_resampled_inputs);
+		boost::shared_ptr<ResampledInputs> ri = writer.get_copy ();
+
+		ResampledPorts::iterator p = ri->ports.find (port.get ());
+		if (p == ri->ports.end ()) {
+			return;
+		}
+
+		std::vector<ResampledInput*> sources (p->second);
+		ri->ports.erase (p);
+
+		for (std::vector<ResampledInput*>::const_iterator s = sources.begin (); s != sources.end (); ++s) {
+			bool used = false;
+			for (ResampledPorts::const_iterator p = ri->ports.begin (); p != ri->ports.end () && !used; ++p) {
+				used = std::find (p->second.begin (), p->second.end (), *s) != p->second.end ();
+			}
+			if (!used) {
+				ri->sources.erase ((*s)->port);
+			}
+		}
+	}
+
+	_resampled_inputs.flush ();
+}
+
 void
 PortManager::cycle_end (pframes_t nframes, Session* s)
 {
@@ -1085,7 +1329,8 @@ PortManager::cycle_end (pframes_t nframes, Session* s)
 		p->second->flush_buffers (nframes * Port::speed_ratio() - Port::port_offset ());
 	}
 
-	_cycle_ports.reset ();
+	_cycle_ports = 0;
+	_cycle_resampled_inputs = 0;
 
 	/* we are done */
 }
@@ -1205,7 +1450,8 @@ PortManager::cycle_end_fade_out (gain_t base_gain, gain_t gain_step, pframes_t n
 			}
 		}
 	}
-	_cycle_ports.reset ();
+	_cycle_ports = 0;
+	_cycle_resampled_inputs = 0;
 	/* we are done */
 }
 
@@ -1637,6 +1883,12 @@ PortManager::set_port_buffer_sizes (pframes_t n)
 	for (Ports::iterator p = all->begin(); p != all->end(); ++p) {
 		p->second->set_buffer_size (n);
 	}
+
+	boost::shared_ptr<ResampledInputs> ri = _resampled_inputs.reader ();
+
+	for (ResampledSources::iterator r = ri->sources.begin(); r != ri->sources.end(); ++r) {
+		r->second->set_buffer_size (n);
+	}
 }
 
 bool
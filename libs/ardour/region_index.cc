@@ -0,0 +1,102 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <limits>
+
+#include "ardour/region.h"
+#include "ardour/region_index.h"
+
+using namespace ARDOUR;
+
+RegionIndex::Entry::Entry (boost::shared_ptr<Region> const& r, uint32_t o)
+	: first (r->position ())
+	, last (r->last_sample ())
+	, max_last (r->last_sample ())
+	, order (o)
+	, region (r)
+{
+}
+
+void
+RegionIndex::clear ()
+{
+	_entries.clear ();
+}
+
+void
+RegionIndex::rebuild (RegionList const& rl)
+{
+	_entries.clear ();
+	_entries.reserve (rl.size ());
+
+	uint32_t order = 0;
+	for (RegionList::const_iterator i = rl.begin (); i != rl.end (); ++i, ++order) {
+		_entries.push_back (Entry (*i, order));
+	}
+
+	std::sort (_entries.begin (), _entries.end (), EntrySorter ());
+
+	build (0, _entries.size ());
+}
+
+samplepos_t
+RegionIndex::build (size_t lo, size_t hi)
+{
+	if (lo >= hi) {
+		return std::numeric_limits<samplepos_t>::min ();
+	}
+
+	const size_t mid = lo + (hi - lo) / 2;
+	Entry& e (_entries[mid]);
+
+	e.max_last = std::max (e.last, std::max (build (lo, mid), build (mid + 1, hi)));
+	return e.max_last;
+}
+
+void
+RegionIndex::find_touched (samplepos_t start, samplepos_t end, RegionVector& result) const
+{
+	query (0, _entries.size (), start, end, result);
+}
+
+void
+RegionIndex::query (size_t lo, size_t hi, samplepos_t start, samplepos_t end, RegionVector& result) const
+{
+	/* in-order traversal, so that results are sorted like _entries */
+	while (lo < hi) {
+		const size_t mid = lo + (hi - lo) / 2;
+		Entry const& e (_entries[mid]);
+
+		if (e.max_last < start) {
+			/* nothing in this subtree reaches the range */
+			return;
+		}
+
+		query (lo, mid, start, end, result);
+
+		if (e.first > end) {
+			/* this and all following entries start after the range */
+			return;
+		}
+
+		if (e.last >= start) {
+			result.push_back (e.region);
+		}
+
+		lo = mid + 1;
+	}
+}
@@ -354,6 +354,9 @@ Route::process_output_buffers (BufferSet& bufs,
 		return;
 	}
 
+	const bool     collect_dsp_stats = DSPStats::enabled ();
+	const uint64_t dsp_t0            = collect_dsp_stats ? DSPStats::now () : 0;
+
 	/* We should offset the route-owned ctrls by the given latency, however
 	 * this only affects Mute. Other route-owned controls (solo, polarity..)
 	 * are not automatable.
@@ -474,6 +477,7 @@ Route::process_output_buffers (BufferSet& bufs,
 	   ----------------------------------------------------------------------------------------- */
 
 	samplecnt_t latency = 0;
+	uint64_t    dsp_t1  = collect_dsp_stats ? DSPStats::now () : 0;
 
 	for (ProcessorList::const_iterator i = _processors.begin(); i != _processors.end(); ++i) {
 
@@ -530,6 +534,12 @@ Route::process_output_buffers (BufferSet& bufs,
 			(*i)->run (bufs, start_sample - latency, end_sample - latency, pspeed, nframes, *i != _processors.back());
 		}
 
+		if (collect_dsp_stats) {
+			const uint64_t now = DSPStats::now ();
+			(*i)->dsp_stats ().update (now - dsp_t1);
+			dsp_t1 = now;
+		}
+
 		bufs.set_count ((*i)->output_streams());
 
 		if (re_inject_oob_data) {
@@ -542,6 +552,10 @@ Route::process_output_buffers (BufferSet& bufs,
 		}
 #endif
 	}
+
+	if (collect_dsp_stats) {
+		_dsp_stats.update_since (dsp_t0);
+	}
 }
 
 void
@@ -6102,6 +6116,18 @@ Route::automation_control_recurse (PBD::ID const & id) const
 	return boost::shared_ptr<AutomationControl> ();
 }
 
+void
+Route::reset_dsp_stats ()
+{
+	_dsp_stats.reset ();
+	_graph_wait_stats.reset ();
+
+	Glib::Threads::RWLock::ReaderLock lm (_processor_lock);
+	for (ProcessorList::const_iterator i = _processors.begin(); i != _processors.end(); ++i) {
+		(*i)->dsp_stats ().reset ();
+	}
+}
+
 SlavableControlList
 Route::slavables () const
 {
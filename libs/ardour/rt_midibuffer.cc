@@ -17,7 +17,7 @@
  */
 
 #include <iostream>
-#include <algorithm>    // std::reverse
+#include <algorithm>    // std::reverse, std::lower_bound
 
 #include "pbd/malign.h"
 #include "pbd/compose.h"
@@ -233,6 +233,59 @@ RTMidiBuffer::write (TimeType time, Evoral::EventType /*type*/, uint32_t size, c
 	return size;
 }
 
+uint8_t const*
+RTMidiBuffer::event (size_t n, uint32_t& size) const
+{
+	Item const* item = &_data[n];
+
+	if (item->bytes[0]) {
+
+		/* more than 3 bytes ... indirect */
+
+		uint32_t offset = item->offset & ~(1<<(CHAR_BIT-1));
+		Blob const* blob = reinterpret_cast<Blob const*> (&_pool[offset]);
+
+		size = blob->size;
+		return blob->data;
+	}
+
+	size = Evoral::midi_event_size (item->bytes[1]);
+	return &item->bytes[1];
+}
+
+void
+RTMidiBuffer::append (RTMidiBuffer const& other, size_t from, size_t to)
+{
+	assert (from <= to && to <= other._size);
+
+	if (_size + (to - from) > _capacity) {
+		resize (_size + (to - from) + 1024);
+	}
+
+	for (size_t n = from; n < to; ++n) {
+		Item const& item (other._data[n]);
+		if (item.bytes[0]) {
+			uint32_t size;
+			uint8_t const* data = other.event (n, size);
+			write (item.timestamp, Evoral::MIDI_EVENT, size, data);
+		} else {
+			_data[_size++] = item;
+		}
+	}
+}
+
+void
+RTMidiBuffer::swap (RTMidiBuffer& other)
+{
+	std::swap (_size, other._size);
+	std::swap (_capacity, other._capacity);
+	std::swap (_data, other._data);
+	std::swap (_reversed, other._reversed);
+	std::swap (_pool_size, other._pool_size);
+	std::swap (_pool_capacity, other._pool_capacity);
+	std::swap (_pool, other._pool);
+}
+
 /* These (non-matching) comparison arguments weren't supported prior to C99 !!!
 static
 bool
@@ -248,6 +301,22 @@ item_item_earlier (ARDOUR::RTMidiBuffer::Item const & item, ARDOUR::RTMidiBuffer
 	return item.timestamp < other.timestamp;
 }
 
+size_t
+RTMidiBuffer::lower_bound (TimeType time) const
+{
+	Item foo;
+	foo.timestamp = time;
+	return std::lower_bound (_data, _data + _size, foo, item_item_earlier) - _data;
+}
+
+size_t
+RTMidiBuffer::upper_bound (TimeType time) const
+{
+	Item foo;
+	foo.timestamp = time;
+	return std::upper_bound (_data, _data + _size, foo, item_item_earlier) - _data;
+}
+
 uint32_t
 RTMidiBuffer::read (MidiBuffer& dst, samplepos_t start, samplepos_t end, MidiStateTracker& tracker, samplecnt_t offset)
 {
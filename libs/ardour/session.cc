@@ -237,6 +237,7 @@ Session::Session (AudioEngine &eng,
 	, _suspend_save (0)
 	, _save_queued (false)
 	, _save_queued_pending (false)
+	, _state_writer (0)
 	, _last_roll_location (0)
 	, _last_roll_or_reversal_location (0)
 	, _last_record_location (0)
@@ -294,6 +295,7 @@ Session::Session (AudioEngine &eng,
 	, _capture_load (0)
 	, _bundles (new BundleList)
 	, _bundle_xml_node (0)
+	, _plugin_preloader (0)
 	, _current_trans (0)
 	, _clicking (false)
 	, _click_rec_only (false)
@@ -4922,6 +4924,25 @@ Session::create_audio_source_for_session (size_t n_chans, string const & base, u
 	}
 }
 
+/** Create sources for all channels of a new within-session interleaved audio file */
+SourceList
+Session::create_interleaved_audio_sources_for_session (size_t n_chans, string const & base)
+{
+	const string path = new_audio_source_path (base, 1, 0, true);
+
+	if (path.empty()) {
+		throw failed_constructor ();
+	}
+
+	SourceList srcs = SourceFactory::createWritableInterleaved (*this, path, n_chans, sample_rate(), true, true);
+
+	if (srcs.size () != n_chans) {
+		throw failed_constructor ();
+	}
+
+	return srcs;
+}
+
 /** Create a new within-session MIDI source */
 boost::shared_ptr<MidiSource>
 Session::create_midi_source_for_session (string const & basic_name)
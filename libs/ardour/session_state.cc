@@ -113,6 +113,7 @@
 #include "ardour/midi_source.h"
 #include "ardour/midi_track.h"
 #include "ardour/playlist_factory.h"
+#include "ardour/plugin_preloader.h"
 #include "ardour/playlist_source.h"
 #include "ardour/port.h"
 #include "ardour/processor.h"
@@ -691,6 +692,9 @@ Session::maybe_write_autosave()
 void
 Session::remove_pending_capture_state ()
 {
+	/* don't let a pending save in progress re-create the file */
+	wait_for_state_writer ();
+
 	std::string pending_state_file_path(_session_dir->root_path());
 
 	pending_state_file_path = Glib::build_filename (pending_state_file_path, legalize_for_path (_current_snapshot_name) + pending_suffix);
@@ -764,6 +768,69 @@ Session::remove_state (string snapshot_name)
 	StateSaved (snapshot_name); /* EMIT SIGNAL */
 }
 
+/** Write \p tree to \p tmp_path and atomically rename it to \p xml_path.
+ * If \p backup_path is given, a copy of the file is kept there as well.
+ * This does not access any session state and can be called from any thread.
+ */
+int
+Session::write_state_file (XMLTree& tree, std::string const& tmp_path, std::string const& xml_path, std::string const& backup_path)
+{
+#ifndef NDEBUG
+	cerr << "actually writing state to " << tmp_path << endl;
+#endif
+
+	if (!tree.write (tmp_path)) {
+		error << string_compose (_("state could not be saved to %1"), tmp_path) << endmsg;
+		if (g_remove (tmp_path.c_str()) != 0) {
+			error << string_compose(_("Could not remove temporary session file at path \"%1\" (%2)"),
+					tmp_path, g_strerror (errno)) << endmsg;
+		}
+		return -1;
+
+	} else {
+
+#ifndef NDEBUG
+		cerr << "renaming state to " << xml_path << endl;
+#endif
+
+		if (::g_rename (tmp_path.c_str(), xml_path.c_str()) != 0) {
+			error << string_compose (_("could not rename temporary session file %1 to %2 (%3)"),
+					tmp_path, xml_path, g_strerror(errno)) << endmsg;
+			if (g_remove (tmp_path.c_str()) != 0) {
+				error << string_compose(_("Could not remove temporary session file at path \"%1\" (%2)"),
+						tmp_path, g_strerror (errno)) << endmsg;
+			}
+			return -1;
+		}
+	}
+
+	if (!backup_path.empty () && !copy_file (xml_path, backup_path)) {
+		error << string_compose(_("Could not save backup file at path \"%1\" (%2)"),
+				backup_path, g_strerror (errno)) << endmsg;
+	}
+
+	return 0;
+}
+
+void
+Session::state_writer_thread (XMLTree* tree, std::string tmp_path, std::string xml_path, std::string backup_path)
+{
+	pthread_set_name (X_("StateWriter"));
+	write_state_file (*tree, tmp_path, xml_path, backup_path);
+	delete tree;
+}
+
+/** Wait for a pending save that is being written in the background */
+void
+Session::wait_for_state_writer ()
+{
+	Glib::Threads::Mutex::Lock lm (_state_writer_lock);
+	if (_state_writer) {
+		_state_writer->join ();
+		_state_writer = 0;
+	}
+}
+
 /** @param snapshot_name Name to save under, without .ardour / .pending prefix */
 int
 Session::save_state (string snapshot_name, bool pending, bool switch_to_snapshot, bool template_only, bool for_archive, bool only_used_assets)
@@ -790,6 +857,9 @@ Session::save_state (string snapshot_name, bool pending, bool switch_to_snapshot
 		lx.acquire ();
 	}
 
+	/* previous pending save must be complete, it uses the same tmp_path */
+	wait_for_state_writer ();
+
 	if (!_writable || cannot_save()) {
 		return 1;
 	}
@@ -876,58 +946,53 @@ Session::save_state (string snapshot_name, bool pending, bool switch_to_snapshot
 	std::string tmp_path(_session_dir->root_path());
 	tmp_path = Glib::build_filename (tmp_path, legalize_for_path (snapshot_name) + temp_suffix);
 
-#ifndef NDEBUG
-	cerr << "actually writing state to " << tmp_path << endl;
-#endif
-
-	if (!tree.write (tmp_path)) {
-		error << string_compose (_("state could not be saved to %1"), tmp_path) << endmsg;
-		if (g_remove (tmp_path.c_str()) != 0) {
-			error << string_compose(_("Could not remove temporary session file at path \"%1\" (%2)"),
-					tmp_path, g_strerror (errno)) << endmsg;
-		}
-		return -1;
-
-	} else {
-
-#ifndef NDEBUG
-		cerr << "renaming state to " << xml_path << endl;
-#endif
-
-		if (::g_rename (tmp_path.c_str(), xml_path.c_str()) != 0) {
-			error << string_compose (_("could not rename temporary session file %1 to %2 (%3)"),
-					tmp_path, xml_path, g_strerror(errno)) << endmsg;
-			if (g_remove (tmp_path.c_str()) != 0) {
-				error << string_compose(_("Could not remove temporary session file at path \"%1\" (%2)"),
-						tmp_path, g_strerror (errno)) << endmsg;
-			}
-			return -1;
-		}
-	}
+	if (pending) {
+		/* nothing depends on the outcome of a pending save, so
+		 * the file can be written in the background. Only the
+		 * libxml2 conversion and file I/O move off this thread:
+		 * state() above was captured synchronously and the
+		 * caller still waits for it.
+		 */
+		std::string backup_path;
 
-	//Mixbus auto-backup mechanism
-	if(Profile->get_mixbus()) {
-		if (pending) {  //"pending" save means it's a backup, or some other non-user-initiated save;  a good time to make a backup
-			// make a serialized safety backup
-			// (will make one periodically but only one per hour is left on disk)
-			// these backup files go into a separated folder
+		if (Profile->get_mixbus()) {
+			/* Mixbus auto-backup mechanism: a pending save is a
+			 * non-user-initiated save; a good time to make a backup.
+			 * (will make one periodically but only one per hour is left on disk)
+			 * these backup files go into a separated folder
+			 */
 			char timebuf[128];
 			time_t n;
 			struct tm local_time;
 			time (&n);
 			localtime_r (&n, &local_time);
 			strftime (timebuf, sizeof(timebuf), "%y-%m-%d.%H", &local_time);
-			std::string save_path(session_directory().backup_path());
-			save_path += G_DIR_SEPARATOR;
-			save_path += legalize_for_path(_current_snapshot_name);
-			save_path += "-";
-			save_path += timebuf;
-			save_path += statefile_suffix;
-			if (!copy_file (xml_path, save_path)) {
-					error << string_compose(_("Could not save backup file at path \"%1\" (%2)"),
-							save_path, g_strerror (errno)) << endmsg;
+			backup_path = session_directory().backup_path();
+			backup_path += G_DIR_SEPARATOR;
+			backup_path += legalize_for_path(_current_snapshot_name);
+			backup_path += "-";
+			backup_path += timebuf;
+			backup_path += statefile_suffix;
+		}
+
+		XMLTree* bg_tree = new XMLTree;
+		bg_tree->set_root (tree.root ());
+		tree.set_root (0);
+
+		Glib::Threads::Mutex::Lock lw (_state_writer_lock);
+		assert (!_state_writer);
+		try {
+			_state_writer = Glib::Threads::Thread::create (boost::bind (&Session::state_writer_thread, this, bg_tree, tmp_path, xml_path, backup_path));
+		} catch (Glib::Threads::ThreadError const&) {
+			lw.release ();
+			int rv = write_state_file (*bg_tree, tmp_path, xml_path, backup_path);
+			delete bg_tree;
+			if (rv) {
+				return rv;
 			}
 		}
+	} else if (write_state_file (tree, tmp_path, xml_path, std::string ())) {
+		return -1;
 	}
 
 	if (!pending && !for_archive) {
@@ -1633,6 +1698,14 @@ Session::set_state (const XMLNode& node, int version)
 		_speakers->set_state (*child, version);
 	}
 
+	if (version >= 3000 && Config->get_parallel_plugin_load ()) {
+		/* instantiate plugins while sources, regions and playlists are loaded */
+		if ((child = find_named_node (node, "Routes")) != 0) {
+			_plugin_preloader = new PluginPreloader (*this);
+			_plugin_preloader->start (*child);
+		}
+	}
+
 	if ((child = find_named_node (node, "Sources")) == 0) {
 		error << _("Session: XML state has no sources section") << endmsg;
 		goto out;
@@ -1723,6 +1796,10 @@ Session::set_state (const XMLNode& node, int version)
 		goto out;
 	}
 
+	/* unused instances are dropped */
+	delete _plugin_preloader;
+	_plugin_preloader = 0;
+
 	/* Now that we Tracks have been loaded and playlists are assigned */
 	_playlists->update_tracking ();
 
@@ -1802,6 +1879,8 @@ Session::set_state (const XMLNode& node, int version)
 	return 0;
 
 out:
+	delete _plugin_preloader;
+	_plugin_preloader = 0;
 	delete state_tree;
 	state_tree = 0;
 	return ret;
@@ -1818,6 +1897,10 @@ Session::load_routes (const XMLNode& node, int version)
 
 	set_dirty();
 
+	if (_plugin_preloader) {
+		_plugin_preloader->join ();
+	}
+
 	for (niter = nlist.begin(); niter != nlist.end(); ++niter) {
 
 		boost::shared_ptr<Route> route;
@@ -1859,6 +1942,15 @@ Session::load_routes (const XMLNode& node, int version)
 	return 0;
 }
 
+boost::shared_ptr<Plugin>
+Session::preloaded_plugin (XMLNode const& node)
+{
+	if (!_plugin_preloader) {
+		return boost::shared_ptr<Plugin> ();
+	}
+	return _plugin_preloader->take (node);
+}
+
 boost::shared_ptr<Route>
 Session::XMLRouteFactory (const XMLNode& node, int version)
 {
@@ -4161,6 +4253,12 @@ Session::config_changed (std::string p, bool ours)
 
 		first_file_data_format_reset = false;
 
+	} else if (p == "interleaved-capture") {
+
+		if (!loading ()) {
+			reset_native_file_format ();
+		}
+
 	} else if (p == "external-sync") {
 		request_sync_source (TransportMasterManager::instance().current());
 	}  else if (p == "denormal-model") {
@@ -26,13 +26,19 @@
 #include "libardour-config.h"
 #endif
 
+#include <algorithm>
 #include <cstring>
 #include <cerrno>
 #include <climits>
 #include <cstdarg>
+#include <map>
+#include <vector>
 #include <fcntl.h>
 
 #include <sys/stat.h>
+#ifndef PLATFORM_WINDOWS
+#include <unistd.h>
+#endif
 
 #include <glib.h>
 #include "pbd/gstdio_compat.h"
@@ -40,7 +46,12 @@
 #include <glibmm/convert.h>
 #include <glibmm/fileutils.h>
 #include <glibmm/miscutils.h>
+#include <glibmm/threads.h>
+
+#include <boost/weak_ptr.hpp>
 
+#include "ardour/disk_reader.h"
+#include "ardour/rc_configuration.h"
 #include "ardour/runtime_functions.h"
 #include "ardour/sndfilesource.h"
 #include "ardour/sndfile_helpers.h"
@@ -60,6 +71,137 @@ const Source::Flag SndFileSource::default_writable_flags = Source::Flag (
 		Source::RemovableIfEmpty |
 		Source::CanRename );
 
+namespace ARDOUR {
+
+/** The most recently read block of interleaved data of a multi-channel file.
+ *
+ * There is one SndFileSource per channel of a file. They usually read the
+ * same range in turn (one region per channel), so the first read fills this
+ * block with all channels and sibling sources just de-interleave from it.
+ */
+class SndFileReadCache
+{
+public:
+	SndFileReadCache () : start (0), cnt (0) {}
+
+	static boost::shared_ptr<SndFileReadCache> get (std::string const& path);
+
+	Glib::Threads::Mutex lock;
+	samplepos_t          start;
+	samplecnt_t          cnt; ///< number of (multi-channel) samples in buf
+	std::vector<Sample>  buf; ///< at most DiskReader::chunk_samples () per channel
+
+private:
+	typedef std::map<std::string, boost::weak_ptr<SndFileReadCache> > CacheMap;
+	static CacheMap             _caches;
+	static Glib::Threads::Mutex _caches_lock;
+};
+
+/** Combines data written by the sources of a new multi-channel file.
+ *
+ * Each channel source appends its data, complete frames are written to
+ * the file with a single write. The file is closed when the last channel
+ * source releases the writer.
+ */
+class SndFileInterleavedWriter
+{
+public:
+	SndFileInterleavedWriter (SNDFILE* sf, uint32_t n_chn, bool seekable)
+		: sndfile (sf)
+		, _n_chn (n_chn)
+		, _seekable (seekable)
+		, _written (0)
+		, _failed (false)
+		, _pending (n_chn, 0)
+	{}
+
+	~SndFileInterleavedWriter () {
+		sf_close (sndfile);
+	}
+
+	samplecnt_t write (uint32_t chn, Sample const* data, samplepos_t pos, samplecnt_t cnt);
+
+	SNDFILE* const sndfile;
+
+private:
+	Glib::Threads::Mutex     _lock;
+	uint32_t                 _n_chn;
+	bool                     _seekable;
+	samplepos_t              _written; ///< number of frames written to the file
+	bool                     _failed;  ///< a write to the file failed, all channels fail from then on
+	std::vector<samplepos_t> _pending; ///< per channel, end of the data in _buf
+	std::vector<Sample>      _buf;     ///< interleaved frames, starting at _written
+};
+
+} /* namespace ARDOUR */
+
+samplecnt_t
+SndFileInterleavedWriter::write (uint32_t chn, Sample const* data, samplepos_t pos, samplecnt_t cnt)
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	/* channel sources only ever append */
+	if (_failed || chn >= _n_chn || pos != _pending[chn]) {
+		return 0;
+	}
+
+	const size_t need = (pos + cnt - _written) * _n_chn;
+	if (_buf.size () < need) {
+		_buf.resize (need, 0.f);
+	}
+
+	interleave (&_buf[(pos - _written) * _n_chn + chn], data, _n_chn, cnt);
+	_pending[chn] = pos + cnt;
+
+	const samplepos_t complete = *std::min_element (_pending.begin (), _pending.end ());
+
+	if (complete > _written) {
+		const samplecnt_t n = complete - _written;
+
+		if ((_seekable && sf_seek (sndfile, _written, SEEK_SET|SFM_WRITE) < 0)
+		    || sf_writef_float (sndfile, &_buf[0], n) != n) {
+			/* other channels' data is buffered for frames that will
+			 * never make it to the file, give up on all of them.
+			 */
+			_failed = true;
+			std::vector<Sample> ().swap (_buf);
+			return 0;
+		}
+
+		_buf.erase (_buf.begin (), _buf.begin () + n * _n_chn);
+		_written = complete;
+	}
+
+	return cnt;
+}
+
+SndFileReadCache::CacheMap SndFileReadCache::_caches;
+Glib::Threads::Mutex       SndFileReadCache::_caches_lock;
+
+boost::shared_ptr<SndFileReadCache>
+SndFileReadCache::get (std::string const& path)
+{
+	Glib::Threads::Mutex::Lock lm (_caches_lock);
+
+	/* drop caches of files that are no longer used */
+	for (CacheMap::iterator i = _caches.begin (); i != _caches.end (); ) {
+		if (i->second.expired ()) {
+			_caches.erase (i++);
+		} else {
+			++i;
+		}
+	}
+
+	CacheMap::iterator i = _caches.find (path);
+	if (i != _caches.end ()) {
+		return i->second.lock ();
+	}
+
+	boost::shared_ptr<SndFileReadCache> c (new SndFileReadCache);
+	_caches[path] = c;
+	return c;
+}
+
 SndFileSource::SndFileSource (Session& s, const XMLNode& node)
 	: Source(s, node)
 	, AudioFileSource (s, node)
@@ -102,7 +244,7 @@ SndFileSource::SndFileSource (Session& s, const string& path, int chn, Flag flag
     not open existing ones.
 */
 SndFileSource::SndFileSource (Session& s, const string& path, const string& origin,
-                              SampleFormat sfmt, HeaderFormat hf, samplecnt_t rate, Flag flags)
+                              SampleFormat sfmt, HeaderFormat hf, samplecnt_t rate, Flag flags, uint32_t n_channels)
 	: Source(s, DataType::AUDIO, path, flags)
 	, AudioFileSource (s, path, origin, flags, sfmt, hf)
 	, _sndfile (0)
@@ -189,14 +331,45 @@ SndFileSource::SndFileSource (Session& s, const string& path, const string& orig
 		break;
 	}
 
-	_info.channels = 1;
+	_info.channels = n_channels;
 	_info.samplerate = rate;
 	_info.format = fmt;
 
+	if (n_channels > 1) {
+		/* the sources of all channels share the file, open it now.
+		 * It must not be renamed from under the other channels.
+		 */
+		_flags = Flag (_flags & ~CanRename);
+
+		if (open ()) {
+			throw failed_constructor ();
+		}
+
+		_writer.reset (new SndFileInterleavedWriter (_sndfile, n_channels, (fmt & SF_FORMAT_TYPEMASK) != SF_FORMAT_FLAC));
+	}
+
 	/* normal mode: do not open the file here - do that in {read,write}_unlocked() as needed
 	 */
 }
 
+SndFileSource::SndFileSource (SndFileSource const& other, int chn)
+	: Source (other._session, DataType::AUDIO, other._path, other._flags)
+	, AudioFileSource (other._session, other._path, other._origin, other._flags, /*unused*/ FormatFloat, /*unused*/ WAVE)
+	, _sndfile (other._sndfile)
+	, _broadcast_info (0)
+{
+	assert (other._writer && chn > 0 && chn < other._info.channels);
+
+	init_sndfile ();
+
+	/* no existence_check(), the file was created by the first channel */
+
+	_file_is_new = true;
+	_channel = chn;
+	_info = other._info;
+	_writer = other._writer;
+}
+
 /** Constructor to be called for recovering files being used for
  * capture. They are in-session, they already exist, they should not
  * be writable. They are an odd hybrid (from a constructor point of
@@ -323,6 +496,10 @@ SndFileSource::init_sndfile ()
 
 	memset (&_info, 0, sizeof(_info));
 
+	_fd = -1;
+	_data_offset = 0;
+	_bytes_per_frame = 0;
+
 	AudioFileSource::HeaderPositionOffsetChanged.connect_same_thread (header_position_connection, boost::bind (&SndFileSource::handle_header_position_change, this));
 }
 
@@ -330,12 +507,113 @@ void
 SndFileSource::close ()
 {
 	if (_sndfile) {
-		sf_close (_sndfile);
+		if (_writer) {
+			/* the last channel to let go closes the file */
+			_writer.reset ();
+		} else {
+			sf_close (_sndfile);
+		}
 		_sndfile = 0;
+		_fd = -1;
+		/* the last channel to let go frees the shared read buffer */
+		_read_cache.reset ();
 		file_closed ();
 	}
 }
 
+/** Find the location of the sample data of uncompressed files, so that
+ * the OS can be told what to read ahead and what to drop from its cache.
+ * libsndfile does not expose the data offset, but seeking to the first
+ * sample positions the file descriptor there.
+ */
+void
+SndFileSource::init_io_hints (int fd)
+{
+	_fd = -1;
+
+#ifdef POSIX_FADV_WILLNEED
+	if (writable ()) {
+		return;
+	}
+
+	switch (_info.format & SF_FORMAT_TYPEMASK) {
+		case SF_FORMAT_WAV:
+		case SF_FORMAT_WAVEX:
+		case SF_FORMAT_RF64:
+		case SF_FORMAT_W64:
+		case SF_FORMAT_CAF:
+		case SF_FORMAT_AIFF:
+			break;
+		default:
+			return;
+	}
+
+	int bytes_per_sample;
+
+	switch (_info.format & SF_FORMAT_SUBMASK) {
+		case SF_FORMAT_PCM_S8:
+		case SF_FORMAT_PCM_U8:
+			bytes_per_sample = 1;
+			break;
+		case SF_FORMAT_PCM_16:
+			bytes_per_sample = 2;
+			break;
+		case SF_FORMAT_PCM_24:
+			bytes_per_sample = 3;
+			break;
+		case SF_FORMAT_PCM_32:
+		case SF_FORMAT_FLOAT:
+			bytes_per_sample = 4;
+			break;
+		case SF_FORMAT_DOUBLE:
+			bytes_per_sample = 8;
+			break;
+		default:
+			return;
+	}
+
+	if (sf_seek (_sndfile, 0, SEEK_SET) != 0) {
+		return;
+	}
+
+	off_t const pos = lseek (fd, 0, SEEK_CUR);
+
+	if (pos <= 0) {
+		return;
+	}
+
+	_fd              = fd;
+	_data_offset     = pos;
+	_bytes_per_frame = bytes_per_sample * _info.channels;
+#endif
+}
+
+void
+SndFileSource::prefetch_unlocked (samplepos_t start, samplecnt_t cnt) const
+{
+#ifdef POSIX_FADV_WILLNEED
+	if (_fd < 0 || start >= _length) {
+		return;
+	}
+	cnt = min (cnt, _length - start);
+	posix_fadvise (_fd, _data_offset + start * _bytes_per_frame, cnt * _bytes_per_frame, POSIX_FADV_WILLNEED);
+#endif
+}
+
+/** Called after reading, to keep data that is unlikely to be read again
+ * soon from evicting other files from the page cache.
+ */
+void
+SndFileSource::drop_cached (samplepos_t start, samplecnt_t cnt) const
+{
+#ifdef POSIX_FADV_DONTNEED
+	if (_fd < 0 || cnt <= 0 || !Config->get_playback_bypass_page_cache ()) {
+		return;
+	}
+	posix_fadvise (_fd, _data_offset + start * _bytes_per_frame, cnt * _bytes_per_frame, POSIX_FADV_DONTNEED);
+#endif
+}
+
 int
 SndFileSource::open ()
 {
@@ -383,6 +661,8 @@ SndFileSource::open ()
 
 	_length = _info.frames;
 
+	init_io_hints (fd);
+
 #ifdef HAVE_RF64_RIFF
 	if (_file_is_new && _length == 0 && writable()) {
 		if (_flags & RF64_RIFF) {
@@ -476,8 +756,11 @@ SndFileSource::read_unlocked (Sample *dst, samplepos_t start, samplecnt_t cnt) c
 	samplecnt_t real_cnt;
 	samplepos_t file_cnt;
 
-        if (writable() && !_sndfile) {
-                /* file has not been opened yet - nothing written to it */
+        if (writable() && (!_sndfile || _writer)) {
+                /* file has not been opened yet - nothing written to it,
+                 * or an interleaved file is being written, which can only be
+                 * read once all channels are done.
+                 */
                 memset (dst, 0, sizeof (Sample) * cnt);
                 return cnt;
         }
@@ -513,6 +796,14 @@ SndFileSource::read_unlocked (Sample *dst, samplepos_t start, samplecnt_t cnt) c
 		memset (dst+file_cnt, 0, sizeof (Sample) * delta);
 	}
 
+	if (file_cnt > 0 && file_cnt == cnt && _info.channels > 1 && !writable ()) {
+		/* read once for all channels */
+		samplecnt_t ret = read_shared (dst, start, cnt);
+		if (ret >= 0) {
+			return ret;
+		}
+	}
+
 	if (file_cnt) {
 
 		if (sf_seek (_sndfile, (sf_count_t) start, SEEK_SET|SFM_READ) != (sf_count_t) start) {
@@ -524,15 +815,14 @@ SndFileSource::read_unlocked (Sample *dst, samplepos_t start, samplecnt_t cnt) c
 
 		if (_info.channels == 1) {
 			samplecnt_t ret = sf_read_float (_sndfile, dst, file_cnt);
+			drop_cached (start, ret);
 			if (ret != file_cnt) {
 				char errbuf[256];
 				sf_error_str (0, errbuf, sizeof (errbuf) - 1);
 				error << string_compose(_("SndFileSource: @ %1 could not read %2 within %3 (%4) (len = %5, ret was %6)"), start, file_cnt, _name.val().substr (1), errbuf, _length, ret) << endl;
 			}
-			if (_gain != 1.f) {
-				for (samplecnt_t i = 0; i < ret; ++i) {
-					dst[i] *= _gain;
-				}
+			if (_gain != 1.f && ret > 0) {
+				apply_gain_to_buffer (dst, ret, _gain);
 			}
 			return ret;
 		}
@@ -548,16 +838,64 @@ SndFileSource::read_unlocked (Sample *dst, samplepos_t start, samplecnt_t cnt) c
 
 	/* stride through the interleaved data */
 
-	if (_gain != 1.f) {
-		for (samplecnt_t n = 0; n < nread; ++n) {
-			dst[n] = *ptr * _gain;
-			ptr += _info.channels;
+	if (nread > 0) {
+		deinterleave (dst, ptr, _info.channels, nread, _gain);
+	}
+
+	return nread;
+}
+
+/** Read channel _channel of [start, start + cnt) via the file's shared read cache.
+ *  @return number of samples read, or -1 if the request is too large to be cached.
+ */
+samplecnt_t
+SndFileSource::read_shared (Sample *dst, samplepos_t start, samplecnt_t cnt) const
+{
+	const int nchn = _info.channels;
+
+	/* larger reads (e.g. analysis, export) are not shared, don't keep a
+	 * buffer of that size around for every open file.
+	 */
+	if (cnt > DiskReader::chunk_samples ()) {
+		return -1;
+	}
+
+	if (!_read_cache) {
+		_read_cache = SndFileReadCache::get (_path);
+	}
+
+	SndFileReadCache& rc (*_read_cache);
+	Glib::Threads::Mutex::Lock lm (rc.lock);
+
+	if (start < rc.start || start + cnt > rc.start + rc.cnt) {
+
+		rc.cnt = 0;
+
+		if (sf_seek (_sndfile, (sf_count_t) start, SEEK_SET|SFM_READ) != (sf_count_t) start) {
+			char errbuf[256];
+			sf_error_str (0, errbuf, sizeof (errbuf) - 1);
+			error << string_compose(_("SndFileSource: could not seek to sample %1 within %2 (%3)"), start, _name.val().substr (1), errbuf) << endmsg;
+			return 0;
 		}
-	} else {
-		for (samplecnt_t n = 0; n < nread; ++n) {
-			dst[n] = *ptr;
-			ptr += _info.channels;
+
+		if (rc.buf.size () < (size_t) (cnt * nchn)) {
+			rc.buf.resize (cnt * nchn);
 		}
+
+		rc.start = start;
+		rc.cnt   = sf_read_float (_sndfile, &rc.buf[0], cnt * nchn) / nchn;
+
+		/* sibling sources use rc.buf, the file's pages are not needed anymore */
+		drop_cached (rc.start, rc.cnt);
+	}
+
+	const samplecnt_t nread = std::min (cnt, rc.start + rc.cnt - start);
+	Sample const* ptr = &rc.buf[(start - rc.start) * nchn + _channel];
+
+	/* stride through the interleaved data */
+
+	if (nread > 0) {
+		deinterleave (dst, ptr, nchn, nread, _gain);
 	}
 
 	return nread;
@@ -581,7 +919,7 @@ SndFileSource::nondestructive_write_unlocked (Sample *data, samplecnt_t cnt)
 		return 0;
 	}
 
-	if (_info.channels != 1) {
+	if (_info.channels != 1 && !_writer) {
 		fatal << string_compose (_("programming error: %1 %2"), X_("SndFileSource::write called on non-mono file"), _path) << endmsg;
 		abort(); /*NOTREACHED*/
 		return 0;
@@ -701,6 +1039,10 @@ SndFileSource::set_header_natural_position ()
 samplecnt_t
 SndFileSource::write_float (Sample* data, samplepos_t sample_pos, samplecnt_t cnt)
 {
+	if (_writer) {
+		return _writer->write (_channel, data, sample_pos, cnt);
+	}
+
 	if ((_info.format & SF_FORMAT_TYPEMASK ) == SF_FORMAT_FLAC) {
 		assert (_length == sample_pos);
 	}
@@ -810,4 +1152,5 @@ void
 SndFileSource::set_path (const string& p)
 {
         FileSource::set_path (p);
+        _read_cache.reset ();
 }
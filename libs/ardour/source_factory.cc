@@ -348,6 +348,41 @@ SourceFactory::createWritable (DataType type, Session& s, const std::string& pat
 	return boost::shared_ptr<Source> ();
 }
 
+SourceList
+SourceFactory::createWritableInterleaved (Session& s, const std::string& path, uint32_t n_channels,
+                                          samplecnt_t rate, bool announce, bool defer_peaks)
+{
+	/* this might throw failed_constructor(), which is OK */
+
+	boost::shared_ptr<SndFileSource> first (new SndFileSource (s, path, string(),
+	                                                           s.config.get_native_file_data_format(),
+	                                                           s.config.get_native_file_header_format(),
+	                                                           rate,
+	                                                           SndFileSource::default_writable_flags,
+	                                                           n_channels));
+	SourceList ret;
+	ret.push_back (first);
+
+	for (uint32_t n = 1; n < n_channels; ++n) {
+		ret.push_back (boost::shared_ptr<Source> (new SndFileSource (*first, n)));
+	}
+
+	for (SourceList::const_iterator i = ret.begin (); i != ret.end (); ++i) {
+		BOOST_MARK_SOURCE (*i);
+		if (setup_peakfile (*i, defer_peaks)) {
+			return SourceList ();
+		}
+	}
+
+	if (announce) {
+		for (SourceList::const_iterator i = ret.begin (); i != ret.end (); ++i) {
+			SourceCreated (*i);
+		}
+	}
+
+	return ret;
+}
+
 boost::shared_ptr<Source>
 SourceFactory::createForRecovery (DataType type, Session& s, const std::string& path, int chn)
 {
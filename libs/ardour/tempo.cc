@@ -722,7 +722,341 @@ struct MetricSectionFrameSorter {
 	}
 };
 
+/***********************************************************************/
+
+/* The conversions below are shared by TempoMap's walks over a Metrics list
+ * and by TempoMapIndex. They take the section(s) the walk stopped at.
+ */
+
+static double
+pulse_at_minute_in (const TempoSection& prev_t, const TempoSection* next_t, const double& minute)
+{
+	if (next_t) {
+		/*the previous ts is the one containing the sample */
+		const double ret = prev_t.pulse_at_minute (minute);
+		/* audio locked section in new meter*/
+		if (next_t->pulse() < ret) {
+			return next_t->pulse();
+		}
+		return ret;
+	}
+
+	/* treated as constant for this ts */
+	const double pulses_in_section = ((minute - prev_t.minute()) * prev_t.note_types_per_minute()) / prev_t.note_type();
+
+	return pulses_in_section + prev_t.pulse();
+}
+
+static BBT_Time
+bbt_in_meter (const MeterSection& prev_m, const double& beats_in_ms)
+{
+	const uint32_t bars_in_ms = (uint32_t) floor (beats_in_ms / prev_m.divisions_per_bar());
+	const uint32_t total_bars = bars_in_ms + (prev_m.bbt().bars - 1);
+	const double remaining_beats = beats_in_ms - (bars_in_ms * prev_m.divisions_per_bar());
+	const double remaining_ticks = (remaining_beats - floor (remaining_beats)) * BBT_Time::ticks_per_beat;
+
+	BBT_Time ret;
+
+	ret.ticks = (uint32_t) floor (remaining_ticks + 0.5);
+	ret.beats = (uint32_t) floor (remaining_beats);
+	ret.bars = total_bars;
+
+	/* 0 0 0 to 1 1 0 - based mapping*/
+	++ret.bars;
+	++ret.beats;
+
+	if (ret.ticks >= BBT_Time::ticks_per_beat) {
+		++ret.beats;
+		ret.ticks -= BBT_Time::ticks_per_beat;
+	}
+
+	if (ret.beats >= prev_m.divisions_per_bar() + 1) {
+		++ret.bars;
+		ret.beats = 1;
+	}
+
+	return ret;
+}
+
+static BBT_Time
+bbt_at_minute_in (const TempoSection& ts, const MeterSection& prev_m, const MeterSection* next_m, const double& minute)
+{
+	double beat = prev_m.beat() + (ts.pulse_at_minute (minute) - prev_m.pulse()) * prev_m.note_divisor();
+
+	/* handle sample before first meter */
+	if (minute < prev_m.minute()) {
+		beat = 0.0;
+	}
+	/* audio locked meters fake their beat */
+	if (next_m && next_m->beat() < beat) {
+		beat = next_m->beat();
+	}
+
+	beat = max (0.0, beat);
+
+	return bbt_in_meter (prev_m, beat - prev_m.beat());
+}
+
+static double
+pulse_at_bbt_in (const MeterSection& prev_m, const BBT_Time& bbt)
+{
+	const double remaining_bars = bbt.bars - prev_m.bbt().bars;
+	const double remaining_pulses = remaining_bars * prev_m.divisions_per_bar() / prev_m.note_divisor();
+
+	return remaining_pulses + prev_m.pulse() + (((bbt.beats - 1) + (bbt.ticks / BBT_Time::ticks_per_beat)) / prev_m.note_divisor());
+}
+
+/* keys are only ever compared from the second entry on (a walk always
+ * accepts the first section), so the running maximum starts there.
+ */
+static void
+make_running_max (std::vector<double>& keys, size_t first)
+{
+	for (size_t n = first; n < keys.size(); ++n) {
+		if (isnan (keys[n])) {
+			/* never greater than anything, a walk passes it by */
+			keys[n] = -HUGE_VAL;
+		}
+		if (n > first) {
+			keys[n] = max (keys[n], keys[n - 1]);
+		}
+	}
+}
+
+static void
+make_running_max (std::vector<samplepos_t>& keys)
+{
+	for (size_t n = 1; n < keys.size(); ++n) {
+		keys[n] = max (keys[n], keys[n - 1]);
+	}
+}
+
+/* index of the entry preceding the first one after the initial entry
+ * whose key is greater than @p key.
+ */
+static size_t
+index_before (std::vector<double> const& keys, double key)
+{
+	return (upper_bound (keys.begin() + 1, keys.end(), key) - keys.begin()) - 1;
+}
+
+void
+TempoMapIndex::clear ()
+{
+	_tempos.clear ();
+	_tempo_minute.clear ();
+	_tempo_pulse.clear ();
+
+	_meters.clear ();
+	_meter_minute.clear ();
+	_meter_pulse.clear ();
+	_meter_beat.clear ();
+	_meter_bbt_beat.clear ();
+	_meter_bbt_bar.clear ();
+	_meter_bbt_pulse.clear ();
+
+	_sections.clear ();
+	_section_sample.clear ();
+	_section_tempo.clear ();
+	_section_meter.clear ();
+	_positions.clear ();
+
+	_copies.clear ();
+}
+
+void
+TempoMapIndex::build (Metrics const& metrics, bool copy_sections)
+{
+	clear ();
+
+	MeterSection* prev_m = 0;
+	TempoSection* last_t = 0;
+	MeterSection* last_m = 0;
+
+	for (Metrics::const_iterator i = metrics.begin(); i != metrics.end(); ++i) {
+		MetricSection* s = *i;
+
+		if (copy_sections) {
+			if (s->is_tempo()) {
+				s = new TempoSection (*static_cast<TempoSection*> (s));
+			} else {
+				s = new MeterSection (*static_cast<MeterSection*> (s));
+			}
+			_copies.push_back (boost::shared_ptr<MetricSection> (s));
+		} else {
+			_positions.push_back (i);
+		}
+
+		if (s->is_tempo()) {
+			TempoSection* t = static_cast<TempoSection*> (s);
+			last_t = t;
+			if (t->active()) {
+				_tempos.push_back (t);
+				_tempo_minute.push_back (t->minute());
+				_tempo_pulse.push_back (t->pulse());
+			}
+		} else {
+			MeterSection* m = static_cast<MeterSection*> (s);
+			last_m = m;
+			_meters.push_back (m);
+			_meter_minute.push_back (m->minute());
+			_meter_pulse.push_back (m->pulse());
+			_meter_beat.push_back (m->beat());
+			_meter_bbt_bar.push_back (m->bbt().bars);
+			if (prev_m) {
+				_meter_bbt_beat.push_back (((m->beat() - prev_m->beat()) / prev_m->divisions_per_bar()) + (prev_m->bbt().bars - 1));
+				_meter_bbt_pulse.push_back (prev_m->pulse() + (m->pulse() - prev_m->pulse()));
+			} else {
+				_meter_bbt_beat.push_back (0.0);
+				_meter_bbt_pulse.push_back (0.0);
+			}
+			prev_m = m;
+		}
+
+		_sections.push_back (s);
+		_section_sample.push_back (s->sample());
+		_section_tempo.push_back (last_t);
+		_section_meter.push_back (last_m);
+	}
+
+	make_running_max (_tempo_minute, 1);
+	make_running_max (_tempo_pulse, 1);
+	make_running_max (_meter_minute, 1);
+	make_running_max (_meter_pulse, 1);
+	make_running_max (_meter_beat, 1);
+	make_running_max (_meter_bbt_beat, 1);
+	make_running_max (_meter_bbt_bar, 1);
+	make_running_max (_meter_bbt_pulse, 1);
+	/* metric_at() has no special case for the first section */
+	make_running_max (_section_sample);
+}
+
+TempoSection*
+TempoMapIndex::tempo_at_minute (double minute, TempoSection** next) const
+{
+	const size_t n = index_before (_tempo_minute, minute);
+	if (next) {
+		*next = n + 1 < _tempos.size() ? _tempos[n + 1] : 0;
+	}
+	return _tempos[n];
+}
+
+TempoSection*
+TempoMapIndex::tempo_at_pulse (double pulse, TempoSection** next) const
+{
+	const size_t n = index_before (_tempo_pulse, pulse);
+	if (next) {
+		*next = n + 1 < _tempos.size() ? _tempos[n + 1] : 0;
+	}
+	return _tempos[n];
+}
+
+TempoSection*
+TempoMapIndex::tempo_at_beat (double beat, MeterSection const& prev_m) const
+{
+	/* the beat of a tempo section within prev_m grows with its pulse,
+	 * so the running maximum of the pulse can be searched directly.
+	 */
+	size_t lo = 1;
+	size_t hi = _tempo_pulse.size();
+
+	while (lo < hi) {
+		const size_t mid = lo + (hi - lo) / 2;
+		if (((_tempo_pulse[mid] - prev_m.pulse()) * prev_m.note_divisor()) + prev_m.beat() > beat) {
+			hi = mid;
+		} else {
+			lo = mid + 1;
+		}
+	}
+
+	return _tempos[lo - 1];
+}
+
+MeterSection*
+TempoMapIndex::meter_at_minute (double minute, MeterSection** next) const
+{
+	const size_t n = index_before (_meter_minute, minute);
+	if (next) {
+		*next = n + 1 < _meters.size() ? _meters[n + 1] : 0;
+	}
+	return _meters[n];
+}
+
+MeterSection*
+TempoMapIndex::meter_at_pulse (double pulse) const
+{
+	return _meters[index_before (_meter_pulse, pulse)];
+}
+
+MeterSection*
+TempoMapIndex::meter_at_beat (double beat) const
+{
+	return _meters[index_before (_meter_beat, beat)];
+}
+
+MeterSection*
+TempoMapIndex::meter_at_bbt_beat (BBT_Time const& bbt) const
+{
+	return _meters[index_before (_meter_bbt_beat, bbt.bars - 1)];
+}
+
+MeterSection*
+TempoMapIndex::meter_at_bbt_bar (BBT_Time const& bbt) const
+{
+	return _meters[index_before (_meter_bbt_bar, bbt.bars)];
+}
+
+MeterSection*
+TempoMapIndex::meter_at_bbt_pulse (double pulse) const
+{
+	return _meters[index_before (_meter_bbt_pulse, pulse)];
+}
+
+size_t
+TempoMapIndex::sections_at_sample (samplepos_t sample, TempoSection const** tempo, MeterSection const** meter) const
+{
+	const size_t n = upper_bound (_section_sample.begin(), _section_sample.end(), sample) - _section_sample.begin();
+
+	if (n > 0) {
+		*tempo = _section_tempo[n - 1];
+		*meter = _section_meter[n - 1];
+	}
+
+	return n;
+}
+
+double
+TempoMapIndex::pulse_at_minute (double minute) const
+{
+	TempoSection* next_t;
+	TempoSection const* prev_t = tempo_at_minute (minute, &next_t);
+
+	return pulse_at_minute_in (*prev_t, next_t, minute);
+}
+
+BBT_Time
+TempoMapIndex::bbt_at_minute (double minute) const
+{
+	if (minute < 0) {
+		return BBT_Time (1, 1, 0);
+	}
+
+	MeterSection* next_m;
+	MeterSection const* prev_m = meter_at_minute (minute, &next_m);
+
+	return bbt_at_minute_in (*tempo_at_minute (minute), *prev_m, next_m, minute);
+}
+
+double
+TempoMapIndex::pulse_at_bbt (BBT_Time const& bbt) const
+{
+	return pulse_at_bbt_in (*meter_at_bbt_bar (bbt), bbt);
+}
+
+/***********************************************************************/
+
 TempoMap::TempoMap (samplecnt_t fr)
+	: _rt_index (new TempoMapIndex)
 {
 	_sample_rate = fr;
 	BBT_Time start (1, 1, 0);
@@ -740,6 +1074,7 @@ TempoMap::TempoMap (samplecnt_t fr)
 	_metrics.push_back (t);
 	_metrics.push_back (m);
 
+	rebuild_index ();
 }
 
 TempoMap&
@@ -769,6 +1104,8 @@ TempoMap::operator= (TempoMap const & other)
 				_metrics.push_back (new_section);
 			}
 		}
+
+		rebuild_index ();
 	}
 
 	PropertyChanged (PropertyChange());
@@ -786,6 +1123,38 @@ TempoMap::~TempoMap ()
 	_metrics.clear();
 }
 
+void
+TempoMap::rebuild_index ()
+{
+	/* CALLER MUST HOLD WRITE LOCK */
+
+	_index.build (_metrics, false);
+
+	boost::shared_ptr<TempoMapIndex> rt_index = _rt_index.write_copy ();
+	rt_index->build (_metrics, true);
+	_rt_index.update (rt_index);
+}
+
+void
+TempoMap::invalidate_index (Metrics const& metrics)
+{
+	/* CALLER MUST HOLD WRITE LOCK */
+
+	if (&metrics == &_metrics) {
+		_index.clear ();
+	}
+}
+
+TempoMapIndex const*
+TempoMap::index_for (Metrics const& metrics) const
+{
+	/* the imaginary maps used while solving are searched linearly */
+	if (&metrics == &_metrics && _index.valid ()) {
+		return &_index;
+	}
+	return 0;
+}
+
 samplepos_t
 TempoMap::sample_at_minute (const double time) const
 {
@@ -822,6 +1191,8 @@ TempoMap::remove_tempo_locked (const TempoSection& tempo)
 {
 	Metrics::iterator i;
 
+	invalidate_index (_metrics);
+
 	for (i = _metrics.begin(); i != _metrics.end(); ++i) {
 		if (dynamic_cast<TempoSection*> (*i) != 0) {
 			if (tempo.sample() == (*i)->sample()) {
@@ -859,6 +1230,7 @@ TempoMap::remove_meter (const MeterSection& tempo, bool complete_operation)
 bool
 TempoMap::remove_meter_locked (const MeterSection& meter)
 {
+	invalidate_index (_metrics);
 
 	if (meter.position_lock_style() == AudioTime) {
 		/* remove meter-locked tempo */
@@ -893,6 +1265,9 @@ void
 TempoMap::do_insert (MetricSection* section)
 {
 	bool need_add = true;
+
+	invalidate_index (_metrics);
+
 	/* we only allow new meters to be inserted on beat 1 of an existing
 	 * measure.
 	 */
@@ -1393,10 +1768,12 @@ TempoMap::first_tempo ()
 	return *t;
 }
 void
-TempoMap::recompute_tempi (Metrics& metrics)
+TempoMap::recompute_tempi (Metrics& metrics, bool update_index)
 {
 	TempoSection* prev_t = 0;
 
+	invalidate_index (metrics);
+
 	for (Metrics::const_iterator i = metrics.begin(); i != metrics.end(); ++i) {
 		TempoSection* t;
 
@@ -1431,6 +1808,10 @@ TempoMap::recompute_tempi (Metrics& metrics)
 	}
 	assert (prev_t);
 	prev_t->set_c (0.0);
+
+	if (update_index && &metrics == &_metrics) {
+		rebuild_index ();
+	}
 }
 
 /* tempos must be positioned correctly.
@@ -1439,11 +1820,13 @@ TempoMap::recompute_tempi (Metrics& metrics)
  * while a music-locked meter requires recomputations of sample pulse and beat (but not bbt)
  */
 void
-TempoMap::recompute_meters (Metrics& metrics)
+TempoMap::recompute_meters (Metrics& metrics, bool update_index)
 {
 	MeterSection* meter = 0;
 	MeterSection* prev_m = 0;
 
+	invalidate_index (metrics);
+
 	for (Metrics::const_iterator mi = metrics.begin(); mi != metrics.end(); ++mi) {
 		if (!(*mi)->is_tempo()) {
 			meter = static_cast<MeterSection*> (*mi);
@@ -1513,6 +1896,10 @@ TempoMap::recompute_meters (Metrics& metrics)
 			prev_m = meter;
 		}
 	}
+
+	if (update_index && &metrics == &_metrics) {
+		rebuild_index ();
+	}
 }
 
 void
@@ -1528,8 +1915,12 @@ TempoMap::recompute_map (Metrics& metrics, samplepos_t end)
 		return;
 	}
 
-	recompute_tempi (metrics);
-	recompute_meters (metrics);
+	recompute_tempi (metrics, false);
+	recompute_meters (metrics, false);
+
+	if (&metrics == &_metrics) {
+		rebuild_index ();
+	}
 }
 
 TempoMetric
@@ -1549,6 +1940,29 @@ TempoMap::metric_at (samplepos_t sample, Metrics::const_iterator* last) const
 	   now see if we can find better candidates.
 	*/
 
+	if (_index.valid()) {
+		const TempoSection* t = 0;
+		const MeterSection* ms = 0;
+		const size_t n = _index.sections_at_sample (sample, &t, &ms);
+
+		if (n > 0) {
+			if (t) {
+				m.set_tempo (*t);
+			}
+			if (ms) {
+				m.set_meter (*ms);
+			}
+			m.set_minute (_index.section (n - 1)->minute());
+			m.set_pulse (_index.section (n - 1)->pulse());
+
+			if (last) {
+				*last = _index.position (n - 1);
+			}
+		}
+
+		return m;
+	}
+
 	for (Metrics::const_iterator i = _metrics.begin(); i != _metrics.end(); ++i) {
 
 		if ((*i)->sample() > sample) {
@@ -1618,16 +2032,21 @@ double
 TempoMap::beat_at_minute_locked (const Metrics& metrics, const double& minute) const
 {
 	const TempoSection& ts = tempo_section_at_minute_locked (metrics, minute);
+	const TempoMapIndex* index = index_for (metrics);
 	MeterSection* prev_m = 0;
 	MeterSection* next_m = 0;
 
-	for (Metrics::const_iterator i = metrics.begin(); i != metrics.end(); ++i) {
-		if (!(*i)->is_tempo()) {
-			if (prev_m && (*i)->minute() > minute) {
-				next_m = static_cast<MeterSection*> (*i);
-				break;
+	if (index) {
+		prev_m = index->meter_at_minute (minute, &next_m);
+	} else {
+		for (Metrics::const_iterator i = metrics.begin(); i != metrics.end(); ++i) {
+			if (!(*i)->is_tempo()) {
+				if (prev_m && (*i)->minute() > minute) {
+					next_m = static_cast<MeterSection*> (*i);
+					break;
+				}
+				prev_m = static_cast<MeterSection*> (*i);
 			}
-			prev_m = static_cast<MeterSection*> (*i);
 		}
 	}
 
@@ -1661,9 +2080,17 @@ TempoMap::sample_at_beat (const double& beat) const
 double
 TempoMap::minute_at_beat_locked (const Metrics& metrics, const double& beat) const
 {
+	const TempoMapIndex* index = index_for (metrics);
 	MeterSection* prev_m = 0;
 	TempoSection* prev_t = 0;
 
+	if (index) {
+		prev_m = index->meter_at_beat (beat);
+		prev_t = index->tempo_at_beat (beat, *prev_m);
+
+		return prev_t->minute_at_pulse (((beat - prev_m->beat()) / prev_m->note_divisor()) + prev_m->pulse());
+	}
+
 	MeterSection* m;
 
 	for (Metrics::const_iterator i = metrics.begin(); i != metrics.end(); ++i) {
@@ -1715,21 +2142,30 @@ TempoMap::tempo_at_sample (const samplepos_t sample) const
 Tempo
 TempoMap::tempo_at_minute_locked (const Metrics& metrics, const double& minute) const
 {
+	const TempoMapIndex* index = index_for (metrics);
 	TempoSection* prev_t = 0;
 
-	TempoSection* t;
+	if (index) {
+		TempoSection* next_t;
+		prev_t = index->tempo_at_minute (minute, &next_t);
+		if (next_t) {
+			return prev_t->tempo_at_minute (minute);
+		}
+	} else {
+		TempoSection* t;
 
-	for (Metrics::const_iterator i = metrics.begin(); i != metrics.end(); ++i) {
-		if ((*i)->is_tempo()) {
-			t = static_cast<TempoSection*> (*i);
-			if (!t->active()) {
-				continue;
-			}
-			if ((prev_t) && t->minute() > minute) {
-				/* t is the section past sample */
-				return prev_t->tempo_at_minute (minute);
+		for (Metrics::const_iterator i = metrics.begin(); i != metrics.end(); ++i) {
+			if ((*i)->is_tempo()) {
+				t = static_cast<TempoSection*> (*i);
+				if (!t->active()) {
+					continue;
+				}
+				if ((prev_t) && t->minute() > minute) {
+					/* t is the section past sample */
+					return prev_t->tempo_at_minute (minute);
+				}
+				prev_t = t;
 			}
-			prev_t = t;
 		}
 	}
 
@@ -1794,21 +2230,30 @@ TempoMap::minute_at_tempo_locked (const Metrics& metrics, const Tempo& tempo) co
 Tempo
 TempoMap::tempo_at_pulse_locked (const Metrics& metrics, const double& pulse) const
 {
+	const TempoMapIndex* index = index_for (metrics);
 	TempoSection* prev_t = 0;
 
-	TempoSection* t;
+	if (index) {
+		TempoSection* next_t;
+		prev_t = index->tempo_at_pulse (pulse, &next_t);
+		if (next_t) {
+			return prev_t->tempo_at_pulse (pulse);
+		}
+	} else {
+		TempoSection* t;
 
-	for (Metrics::const_iterator i = metrics.begin(); i != metrics.end(); ++i) {
-		if ((*i)->is_tempo()) {
-			t = static_cast<TempoSection*> (*i);
-			if (!t->active()) {
-				continue;
-			}
-			if ((prev_t) && t->pulse() > pulse) {
-				/* t is the section past sample */
-				return prev_t->tempo_at_pulse (pulse);
+		for (Metrics::const_iterator i = metrics.begin(); i != metrics.end(); ++i) {
+			if ((*i)->is_tempo()) {
+				t = static_cast<TempoSection*> (*i);
+				if (!t->active()) {
+					continue;
+				}
+				if ((prev_t) && t->pulse() > pulse) {
+					/* t is the section past sample */
+					return prev_t->tempo_at_pulse (pulse);
+				}
+				prev_t = t;
 			}
-			prev_t = t;
 		}
 	}
 
@@ -1907,16 +2352,21 @@ TempoMap::pulse_at_beat_locked (const Metrics& metrics, const double& beat) cons
 double
 TempoMap::beat_at_pulse_locked (const Metrics& metrics, const double& pulse) const
 {
+	const TempoMapIndex* index = index_for (metrics);
 	MeterSection* prev_m = 0;
 
-	for (Metrics::const_iterator i = metrics.begin(); i != metrics.end(); ++i) {
-		MeterSection* m;
-		if (!(*i)->is_tempo()) {
-			m = static_cast<MeterSection*> (*i);
-			if (prev_m && m->pulse() > pulse) {
-				break;
+	if (index) {
+		prev_m = index->meter_at_pulse (pulse);
+	} else {
+		for (Metrics::const_iterator i = metrics.begin(); i != metrics.end(); ++i) {
+			MeterSection* m;
+			if (!(*i)->is_tempo()) {
+				m = static_cast<MeterSection*> (*i);
+				if (prev_m && m->pulse() > pulse) {
+					break;
+				}
+				prev_m = m;
 			}
-			prev_m = m;
 		}
 	}
 	assert (prev_m);
@@ -1930,7 +2380,14 @@ double
 TempoMap::pulse_at_minute_locked (const Metrics& metrics, const double& minute) const
 {
 	/* HOLD (at least) THE READER LOCK */
+	const TempoMapIndex* index = index_for (metrics);
+
+	if (index) {
+		return index->pulse_at_minute (minute);
+	}
+
 	TempoSection* prev_t = 0;
+	TempoSection* next_t = 0;
 
 	for (Metrics::const_iterator i = metrics.begin(); i != metrics.end(); ++i) {
 		TempoSection* t;
@@ -1940,13 +2397,8 @@ TempoMap::pulse_at_minute_locked (const Metrics& metrics, const double& minute)
 				continue;
 			}
 			if (prev_t && t->minute() > minute) {
-				/*the previous ts is the one containing the sample */
-				const double ret = prev_t->pulse_at_minute (minute);
-				/* audio locked section in new meter*/
-				if (t->pulse() < ret) {
-					return t->pulse();
-				}
-				return ret;
+				next_t = t;
+				break;
 			}
 			prev_t = t;
 		}
@@ -1954,10 +2406,7 @@ TempoMap::pulse_at_minute_locked (const Metrics& metrics, const double& minute)
 
 	assert (prev_t);
 
-	/* treated as constant for this ts */
-	const double pulses_in_section = ((minute - prev_t->minute()) * prev_t->note_types_per_minute()) / prev_t->note_type();
-
-	return pulses_in_section + prev_t->pulse();
+	return pulse_at_minute_in (*prev_t, next_t, minute);
 }
 
 /* tempo section based */
@@ -1966,21 +2415,30 @@ TempoMap::minute_at_pulse_locked (const Metrics& metrics, const double& pulse) c
 {
 	/* HOLD THE READER LOCK */
 
+	const TempoMapIndex* index = index_for (metrics);
 	const TempoSection* prev_t = 0;
 
-	for (Metrics::const_iterator i = metrics.begin(); i != metrics.end(); ++i) {
-		TempoSection* t;
+	if (index) {
+		TempoSection* next_t;
+		prev_t = index->tempo_at_pulse (pulse, &next_t);
+		if (next_t) {
+			return prev_t->minute_at_pulse (pulse);
+		}
+	} else {
+		for (Metrics::const_iterator i = metrics.begin(); i != metrics.end(); ++i) {
+			TempoSection* t;
 
-		if ((*i)->is_tempo()) {
-			t = static_cast<TempoSection*> (*i);
-			if (!t->active()) {
-				continue;
-			}
-			if (prev_t && t->pulse() > pulse) {
-				return prev_t->minute_at_pulse (pulse);
-			}
+			if ((*i)->is_tempo()) {
+				t = static_cast<TempoSection*> (*i);
+				if (!t->active()) {
+					continue;
+				}
+				if (prev_t && t->pulse() > pulse) {
+					return prev_t->minute_at_pulse (pulse);
+				}
 
-			prev_t = t;
+				prev_t = t;
+			}
 		}
 	}
 
@@ -2010,23 +2468,29 @@ TempoMap::beat_at_bbt_locked (const Metrics& metrics, const Timecode::BBT_Time&
 {
 	/* CALLER HOLDS READ LOCK */
 
+	const TempoMapIndex* index = index_for (metrics);
 	MeterSection* prev_m = 0;
 
 	/* because audio-locked meters have 'fake' integral beats,
 	   there is no pulse offset here.
 	*/
-	MeterSection* m;
 
-	for (Metrics::const_iterator i = metrics.begin(); i != metrics.end(); ++i) {
-		if (!(*i)->is_tempo()) {
-			m = static_cast<MeterSection*> (*i);
-			if (prev_m) {
-				const double bars_to_m = (m->beat() - prev_m->beat()) / prev_m->divisions_per_bar();
-				if ((bars_to_m + (prev_m->bbt().bars - 1)) > (bbt.bars - 1)) {
-					break;
+	if (index) {
+		prev_m = index->meter_at_bbt_beat (bbt);
+	} else {
+		MeterSection* m;
+
+		for (Metrics::const_iterator i = metrics.begin(); i != metrics.end(); ++i) {
+			if (!(*i)->is_tempo()) {
+				m = static_cast<MeterSection*> (*i);
+				if (prev_m) {
+					const double bars_to_m = (m->beat() - prev_m->beat()) / prev_m->divisions_per_bar();
+					if ((bars_to_m + (prev_m->bbt().bars - 1)) > (bbt.bars - 1)) {
+						break;
+					}
 				}
+				prev_m = m;
 			}
-			prev_m = m;
 		}
 	}
 
@@ -2123,6 +2587,12 @@ TempoMap::quarter_note_at_bbt (const Timecode::BBT_Time& bbt)
 double
 TempoMap::quarter_note_at_bbt_rt (const Timecode::BBT_Time& bbt)
 {
+	boost::shared_ptr<TempoMapIndex> rt_index = _rt_index.reader ();
+
+	if (rt_index->valid()) {
+		return rt_index->pulse_at_bbt (bbt) * 4.0;
+	}
+
 	Glib::Threads::RWLock::ReaderLock lm (lock, Glib::Threads::TRY_LOCK);
 
 	if (!lm.locked()) {
@@ -2137,6 +2607,12 @@ TempoMap::pulse_at_bbt_locked (const Metrics& metrics, const Timecode::BBT_Time&
 {
 	/* CALLER HOLDS READ LOCK */
 
+	const TempoMapIndex* index = index_for (metrics);
+
+	if (index) {
+		return index->pulse_at_bbt (bbt);
+	}
+
 	MeterSection* prev_m = 0;
 
 	/* because audio-locked meters have 'fake' integral beats,
@@ -2158,11 +2634,7 @@ TempoMap::pulse_at_bbt_locked (const Metrics& metrics, const Timecode::BBT_Time&
 
 	assert (prev_m);
 
-	const double remaining_bars = bbt.bars - prev_m->bbt().bars;
-	const double remaining_pulses = remaining_bars * prev_m->divisions_per_bar() / prev_m->note_divisor();
-	const double ret = remaining_pulses + prev_m->pulse() + (((bbt.beats - 1) + (bbt.ticks / BBT_Time::ticks_per_beat)) / prev_m->note_divisor());
-
-	return ret;
+	return pulse_at_bbt_in (*prev_m, bbt);
 }
 
 /** Returns the BBT time corresponding to the supplied quarter-note beat.
@@ -2192,56 +2664,35 @@ TempoMap::bbt_at_quarter_note (const double& qn)
 Timecode::BBT_Time
 TempoMap::bbt_at_pulse_locked (const Metrics& metrics, const double& pulse) const
 {
+	const TempoMapIndex* index = index_for (metrics);
 	MeterSection* prev_m = 0;
 
-	MeterSection* m = 0;
+	if (index) {
+		prev_m = index->meter_at_bbt_pulse (pulse);
+	} else {
+		MeterSection* m = 0;
 
-	for (Metrics::const_iterator i = metrics.begin(); i != metrics.end(); ++i) {
+		for (Metrics::const_iterator i = metrics.begin(); i != metrics.end(); ++i) {
 
-		if (!(*i)->is_tempo()) {
-			m = static_cast<MeterSection*> (*i);
+			if (!(*i)->is_tempo()) {
+				m = static_cast<MeterSection*> (*i);
 
-			if (prev_m) {
-				double const pulses_to_m = m->pulse() - prev_m->pulse();
-				if (prev_m->pulse() + pulses_to_m > pulse) {
-					/* this is the meter after the one our beat is on*/
-					break;
+				if (prev_m) {
+					double const pulses_to_m = m->pulse() - prev_m->pulse();
+					if (prev_m->pulse() + pulses_to_m > pulse) {
+						/* this is the meter after the one our beat is on*/
+						break;
+					}
 				}
-			}
 
-			prev_m = m;
+				prev_m = m;
+			}
 		}
 	}
 
 	assert (prev_m);
 
-	const double beats_in_ms = (pulse - prev_m->pulse()) * prev_m->note_divisor();
-	const uint32_t bars_in_ms = (uint32_t) floor (beats_in_ms / prev_m->divisions_per_bar());
-	const uint32_t total_bars = bars_in_ms + (prev_m->bbt().bars - 1);
-	const double remaining_beats = beats_in_ms - (bars_in_ms * prev_m->divisions_per_bar());
-	const double remaining_ticks = (remaining_beats - floor (remaining_beats)) * BBT_Time::ticks_per_beat;
-
-	BBT_Time ret;
-
-	ret.ticks = (uint32_t) floor (remaining_ticks + 0.5);
-	ret.beats = (uint32_t) floor (remaining_beats);
-	ret.bars = total_bars;
-
-	/* 0 0 0 to 1 1 0 mapping*/
-	++ret.bars;
-	++ret.beats;
-
-	if (ret.ticks >= BBT_Time::ticks_per_beat) {
-		++ret.beats;
-		ret.ticks -= BBT_Time::ticks_per_beat;
-	}
-
-	if (ret.beats >= prev_m->divisions_per_bar() + 1) {
-		++ret.bars;
-		ret.beats = 1;
-	}
-
-	return ret;
+	return bbt_in_meter (*prev_m, (pulse - prev_m->pulse()) * prev_m->note_divisor());
 }
 
 /** Returns the BBT time corresponding to the supplied sample position.
@@ -2275,6 +2726,12 @@ TempoMap::bbt_at_sample_rt (samplepos_t sample) const
 {
 	const double minute =  minute_at_sample (sample);
 
+	boost::shared_ptr<TempoMapIndex> rt_index = _rt_index.reader ();
+
+	if (rt_index->valid()) {
+		return rt_index->bbt_at_minute (minute);
+	}
+
 	Glib::Threads::RWLock::ReaderLock lm (lock, Glib::Threads::TRY_LOCK);
 
 	if (!lm.locked()) {
@@ -2287,6 +2744,12 @@ TempoMap::bbt_at_sample_rt (samplepos_t sample) const
 Timecode::BBT_Time
 TempoMap::bbt_at_minute_locked (const Metrics& metrics, const double& minute) const
 {
+	const TempoMapIndex* index = index_for (metrics);
+
+	if (index) {
+		return index->bbt_at_minute (minute);
+	}
+
 	if (minute < 0) {
 		BBT_Time bbt;
 		bbt.bars = 1;
@@ -2314,46 +2777,7 @@ TempoMap::bbt_at_minute_locked (const Metrics& metrics, const double& minute) co
 
 	assert (prev_m);
 
-	double beat = prev_m->beat() + (ts.pulse_at_minute (minute) - prev_m->pulse()) * prev_m->note_divisor();
-
-	/* handle sample before first meter */
-	if (minute < prev_m->minute()) {
-		beat = 0.0;
-	}
-	/* audio locked meters fake their beat */
-	if (next_m && next_m->beat() < beat) {
-		beat = next_m->beat();
-	}
-
-	beat = max (0.0, beat);
-
-	const double beats_in_ms = beat - prev_m->beat();
-	const uint32_t bars_in_ms = (uint32_t) floor (beats_in_ms / prev_m->divisions_per_bar());
-	const uint32_t total_bars = bars_in_ms + (prev_m->bbt().bars - 1);
-	const double remaining_beats = beats_in_ms - (bars_in_ms * prev_m->divisions_per_bar());
-	const double remaining_ticks = (remaining_beats - floor (remaining_beats)) * BBT_Time::ticks_per_beat;
-
-	BBT_Time ret;
-
-	ret.ticks = (uint32_t) floor (remaining_ticks + 0.5);
-	ret.beats = (uint32_t) floor (remaining_beats);
-	ret.bars = total_bars;
-
-	/* 0 0 0 to 1 1 0 - based mapping*/
-	++ret.bars;
-	++ret.beats;
-
-	if (ret.ticks >= BBT_Time::ticks_per_beat) {
-		++ret.beats;
-		ret.ticks -= BBT_Time::ticks_per_beat;
-	}
-
-	if (ret.beats >= prev_m->divisions_per_bar() + 1) {
-		++ret.bars;
-		ret.beats = 1;
-	}
-
-	return ret;
+	return bbt_at_minute_in (ts, *prev_m, next_m, minute);
 }
 
 /** Returns the sample position corresponding to the supplied BBT time.
@@ -2416,6 +2840,12 @@ TempoMap::quarter_note_at_sample_rt (const samplepos_t sample) const
 {
 	const double minute =  minute_at_sample (sample);
 
+	boost::shared_ptr<TempoMapIndex> rt_index = _rt_index.reader ();
+
+	if (rt_index->valid()) {
+		return rt_index->pulse_at_minute (minute) * 4.0;
+	}
+
 	Glib::Threads::RWLock::ReaderLock lm (lock, Glib::Threads::TRY_LOCK);
 
 	if (!lm.locked()) {
@@ -2616,6 +3046,8 @@ TempoMap::check_solved (const Metrics& metrics) const
 bool
 TempoMap::set_active_tempi (const Metrics& metrics, const samplepos_t sample)
 {
+	invalidate_index (metrics);
+
 	for (Metrics::const_iterator i = metrics.begin(); i != metrics.end(); ++i) {
 		TempoSection* t;
 		if ((*i)->is_tempo()) {
@@ -2643,6 +3075,9 @@ TempoMap::solve_map_minute (Metrics& imaginary, TempoSection* section, const dou
 	TempoSection* prev_t = 0;
 	TempoSection* section_prev = 0;
 	double first_m_minute = 0.0;
+
+	invalidate_index (imaginary);
+
 	const bool sml = section->locked_to_meter();
 
 	/* can't move a tempo before the first meter */
@@ -2726,6 +3161,8 @@ TempoMap::solve_map_pulse (Metrics& imaginary, TempoSection* section, const doub
 	TempoSection* prev_t = 0;
 	TempoSection* section_prev = 0;
 
+	invalidate_index (imaginary);
+
 	section->set_pulse (pulse);
 
 	for (Metrics::iterator i = imaginary.begin(); i != imaginary.end(); ++i) {
@@ -2795,6 +3232,8 @@ TempoMap::solve_map_minute (Metrics& imaginary, MeterSection* section, const dou
 		return false;
 	}
 
+	invalidate_index (imaginary);
+
 	if (section->initial()) {
 		/* lock the first tempo to our first meter */
 		if (!set_active_tempi (imaginary, sample_at_minute (minute))) {
@@ -2949,6 +3388,8 @@ TempoMap::solve_map_bbt (Metrics& imaginary, MeterSection* section, const BBT_Ti
 		}
 	}
 
+	invalidate_index (imaginary);
+
 	MeterSection* prev_m = 0;
 	MeterSection* section_prev = 0;
 
@@ -3467,7 +3908,7 @@ TempoMap::gui_stretch_tempo (TempoSection* ts, const samplepos_t sample, const s
 				}
 			}
 
-			recompute_tempi (_metrics);
+			recompute_tempi (_metrics, false);
 			recompute_meters (_metrics);
 		}
 	}
@@ -3548,7 +3989,7 @@ TempoMap::gui_stretch_tempo_end (TempoSection* ts, const samplepos_t sample, con
 				}
 			}
 
-			recompute_tempi (_metrics);
+			recompute_tempi (_metrics, false);
 			recompute_meters (_metrics);
 		}
 	}
@@ -4227,6 +4668,12 @@ TempoMap::tempo_section_at_sample (samplepos_t sample)
 const TempoSection&
 TempoMap::tempo_section_at_minute_locked (const Metrics& metrics, double minute) const
 {
+	const TempoMapIndex* index = index_for (metrics);
+
+	if (index) {
+		return *index->tempo_at_minute (minute);
+	}
+
 	TempoSection* prev = 0;
 
 	TempoSection* t;
@@ -4256,6 +4703,12 @@ TempoMap::tempo_section_at_minute_locked (const Metrics& metrics, double minute)
 TempoSection&
 TempoMap::tempo_section_at_minute_locked (const Metrics& metrics, double minute)
 {
+	const TempoMapIndex* index = index_for (metrics);
+
+	if (index) {
+		return *index->tempo_at_minute (minute);
+	}
+
 	TempoSection* prev = 0;
 
 	TempoSection* t;
@@ -4285,9 +4738,14 @@ TempoMap::tempo_section_at_minute_locked (const Metrics& metrics, double minute)
 const TempoSection&
 TempoMap::tempo_section_at_beat_locked (const Metrics& metrics, const double& beat) const
 {
+	const TempoMapIndex* index = index_for (metrics);
 	TempoSection* prev_t = 0;
 	const MeterSection* prev_m = &meter_section_at_beat_locked (metrics, beat);
 
+	if (index) {
+		return *index->tempo_at_beat (beat, *prev_m);
+	}
+
 	TempoSection* t;
 
 	for (Metrics::const_iterator i = metrics.begin(); i != metrics.end(); ++i) {
@@ -4446,6 +4904,12 @@ TempoMap::meter_section_at_sample (samplepos_t sample) const
 const MeterSection&
 TempoMap::meter_section_at_minute_locked (const Metrics& metrics, double minute) const
 {
+	const TempoMapIndex* index = index_for (metrics);
+
+	if (index) {
+		return *index->meter_at_minute (minute);
+	}
+
 	Metrics::const_iterator i;
 	MeterSection* prev = 0;
 
@@ -4475,6 +4939,12 @@ TempoMap::meter_section_at_minute_locked (const Metrics& metrics, double minute)
 const MeterSection&
 TempoMap::meter_section_at_beat_locked (const Metrics& metrics, const double& beat) const
 {
+	const TempoMapIndex* index = index_for (metrics);
+
+	if (index) {
+		return *index->meter_at_beat (beat);
+	}
+
 	MeterSection* prev_m = 0;
 
 	for (Metrics::const_iterator i = metrics.begin(); i != metrics.end(); ++i) {
@@ -4637,6 +5107,8 @@ TempoMap::set_state (const XMLNode& node, int /*version*/)
 	{
 		Glib::Threads::RWLock::WriterLock lm (lock);
 
+		invalidate_index (_metrics);
+
 		XMLNodeList nlist;
 		XMLNodeConstIterator niter;
 		Metrics old_metrics (_metrics);
@@ -24,9 +24,11 @@ class AutomationListPropertyTest : public CppUnit::TestFixture
 	CPPUNIT_TEST_SUITE (AutomationListPropertyTest);
 	CPPUNIT_TEST (basicTest);
 	CPPUNIT_TEST (undoTest);
+	CPPUNIT_TEST (serializeTest);
 	CPPUNIT_TEST_SUITE_END ();
 
 public:
 	void basicTest ();
 	void undoTest ();
+	void serializeTest ();
 };
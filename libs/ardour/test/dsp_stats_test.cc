@@ -0,0 +1,68 @@
+#include "ardour/dsp_stats.h"
+
+#include "dsp_stats_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (DSPStatsTest);
+
+using namespace ARDOUR;
+
+void
+DSPStatsTest::windowTest ()
+{
+	uint64_t min, max, p50, p95, p99;
+	double   avg;
+
+	DSPStats::set_window (10);
+	DSPStats s;
+
+	/* nothing is published until the first window is complete */
+	for (uint64_t i = 1; i < 10; ++i) {
+		s.update (i);
+		CPPUNIT_ASSERT (!s.get_stats (min, max, avg, p50, p95, p99));
+	}
+	s.update (10);
+
+	CPPUNIT_ASSERT (s.get_stats (min, max, avg, p50, p95, p99));
+	CPPUNIT_ASSERT_EQUAL ((uint64_t)1, min);
+	CPPUNIT_ASSERT_EQUAL ((uint64_t)10, max);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (5.5, avg, 1e-9);
+
+	/* the published window stays until the next one is complete */
+	s.update (1000);
+	CPPUNIT_ASSERT (s.get_stats (min, max, avg, p50, p95, p99));
+	CPPUNIT_ASSERT_EQUAL ((uint64_t)10, max);
+
+	s.reset ();
+	s.update (5);
+	CPPUNIT_ASSERT (!s.get_stats (min, max, avg, p50, p95, p99));
+
+	DSPStats::set_window (1000);
+}
+
+void
+DSPStatsTest::percentileTest ()
+{
+	DSPStats::set_window (1000);
+	DSPStats s;
+
+	/* 1..1000 usec, uniform */
+	for (uint64_t i = 1; i <= 1000; ++i) {
+		s.update (i);
+	}
+
+	/* buckets are 1/4 octave wide */
+	uint64_t p50 = s.percentile (50);
+	uint64_t p99 = s.percentile (99);
+	CPPUNIT_ASSERT (p50 >= 500 && p50 < 500 * 1.25);
+	CPPUNIT_ASSERT (p99 >= 990 && p99 <= 1000);
+	CPPUNIT_ASSERT_EQUAL ((uint64_t)1, s.percentile (0));
+	CPPUNIT_ASSERT_EQUAL ((uint64_t)1000, s.percentile (100));
+
+	/* exact for small values */
+	DSPStats t;
+	for (int i = 0; i < 1000; ++i) {
+		t.update (i < 900 ? 2 : 3);
+	}
+	CPPUNIT_ASSERT_EQUAL ((uint64_t)2, t.percentile (90));
+	CPPUNIT_ASSERT_EQUAL ((uint64_t)3, t.percentile (95));
+}
@@ -0,0 +1,14 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class DSPStatsTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (DSPStatsTest);
+	CPPUNIT_TEST (windowTest);
+	CPPUNIT_TEST (percentileTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void windowTest ();
+	void percentileTest ();
+};
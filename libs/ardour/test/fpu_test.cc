@@ -1,4 +1,6 @@
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 #include "pbd/compose.h"
 #include "pbd/fpu.h"
 #include "pbd/malign.h"
@@ -81,6 +83,44 @@ FPUTest::run (size_t align_max)
 			find_peaks (&_test1[off], cnt, &pk_test, &pk_test_max);
 			default_find_peaks (&_comp1[off], cnt, &pk_comp, &pk_comp_max);
 			CPPUNIT_ASSERT_MESSAGE (string_compose ("Find peaks not aligned off: %1 cnt: %2", off, cnt), fabsf (pk_test - pk_comp) < 2e-6 && fabsf (pk_test_max - pk_comp_max) < 2e-6);
+
+			/* gain ramp, SIMD versions evaluate the closed form */
+			float g_test = apply_gain_ramp (&_test1[off], cnt, 0.2, 1.1, 0.01);
+			float g_comp = default_apply_gain_ramp (&_comp1[off], cnt, 0.2, 1.1, 0.01);
+			CPPUNIT_ASSERT_MESSAGE (string_compose ("Gain ramp result off: %1 cnt: %2", off, cnt), fabsf (g_test - g_comp) < 1e-5);
+			compare_and_sync (string_compose ("Gain ramp not aligned off: %1 cnt: %2", off, cnt), off + cnt, 1e-5);
+
+			/* gain curves, _test2 is in [0, 2.5] */
+			apply_gain_curve (&_test1[off], &_test2[cnt], cnt);
+			default_apply_gain_curve (&_comp1[off], &_comp2[cnt], cnt);
+			compare (string_compose ("Apply gain curve not aligned off: %1 cnt: %2", off, cnt), off + cnt);
+
+			apply_inverse_gain_curve (&_test1[off], &_test2[cnt], cnt);
+			default_apply_inverse_gain_curve (&_comp1[off], &_comp2[cnt], cnt);
+			compare (string_compose ("Apply inverse gain curve not aligned off: %1 cnt: %2", off, cnt), off + cnt);
+
+			mix_buffers_with_curve (&_test1[off], &_test2[off], &_test2[cnt], cnt);
+			default_mix_buffers_with_curve (&_comp1[off], &_comp2[off], &_comp2[cnt], cnt);
+			compare_and_sync (string_compose ("Mix buffers w/curve not aligned off: %1 cnt: %2", off, cnt), off + cnt, 1e-6);
+
+			/* clip */
+			clip_buffer (&_test1[off], cnt, 0.5);
+			default_clip_buffer (&_comp1[off], cnt, 0.5);
+			compare (string_compose ("Clip buffer not aligned off: %1 cnt: %2", off, cnt), off + cnt);
+
+			/* (de)interleave, _test2 holds up to 3 interleaved channels */
+			for (uint32_t stride = 1; stride < 4; ++stride) {
+				assert (off + cnt * stride < _size);
+				deinterleave (&_test1[off], &_test2[off], stride, cnt, 0.7);
+				default_deinterleave (&_comp1[off], &_comp2[off], stride, cnt, 0.7);
+				compare (string_compose ("Deinterleave stride: %3 off: %1 cnt: %2", off, cnt, stride), off + cnt);
+
+				interleave (&_test2[off], &_test1[off], stride, cnt);
+				default_interleave (&_comp2[off], &_comp1[off], stride, cnt);
+				for (size_t i = 0; i < _size; ++i) {
+					CPPUNIT_ASSERT_MESSAGE (string_compose ("Interleave stride: %3 off: %1 cnt: %2", off, cnt, stride), _test2[i] == _comp2[i]);
+				}
+			}
 		}
 	}
 }
@@ -97,6 +137,23 @@ FPUTest::compare (std::string msg, size_t cnt)
 	CPPUNIT_ASSERT_MESSAGE (msg, err == 0);
 }
 
+/* for routines that are allowed to differ in rounding: compare with
+ * the given tolerance, then re-sync so that subsequent tests can
+ * compare for equality.
+ */
+void
+FPUTest::compare_and_sync (std::string msg, size_t cnt, float tolerance)
+{
+	size_t err = 0;
+	for (size_t i = 0; i < cnt; ++i) {
+		if (fabsf (_test1[i] - _comp1[i]) > tolerance * std::max (1.f, fabsf (_comp1[i]))) {
+			++err;
+		}
+	}
+	CPPUNIT_ASSERT_MESSAGE (msg, err == 0);
+	memcpy (_test1, _comp1, sizeof (float) * _size);
+}
+
 #if defined(ARCH_X86) && defined(BUILD_SSE_OPTIMIZATIONS)
 
 void
@@ -123,6 +180,14 @@ FPUTest::avxFmaTest ()
 	mix_buffers_no_gain   = x86_sse_avx_mix_buffers_no_gain;
 	copy_vector           = x86_sse_avx_copy_vector;
 
+	apply_gain_ramp          = x86_fma_apply_gain_ramp;
+	apply_gain_curve         = x86_sse_avx_apply_gain_curve;
+	apply_inverse_gain_curve = x86_sse_avx_apply_inverse_gain_curve;
+	mix_buffers_with_curve   = x86_fma_mix_buffers_with_curve;
+	interleave               = x86_sse_avx_interleave;
+	deinterleave             = x86_sse_avx_deinterleave;
+	clip_buffer              = x86_sse_avx_clip_buffer;
+
 	run (align_max);
 }
 
@@ -150,6 +215,14 @@ FPUTest::avxTest ()
 	mix_buffers_no_gain   = x86_sse_avx_mix_buffers_no_gain;
 	copy_vector           = x86_sse_avx_copy_vector;
 
+	apply_gain_ramp          = x86_sse_avx_apply_gain_ramp;
+	apply_gain_curve         = x86_sse_avx_apply_gain_curve;
+	apply_inverse_gain_curve = x86_sse_avx_apply_inverse_gain_curve;
+	mix_buffers_with_curve   = x86_sse_avx_mix_buffers_with_curve;
+	interleave               = x86_sse_avx_interleave;
+	deinterleave             = x86_sse_avx_deinterleave;
+	clip_buffer              = x86_sse_avx_clip_buffer;
+
 	run (align_max);
 }
 
@@ -177,6 +250,14 @@ FPUTest::sseTest ()
 	mix_buffers_no_gain   = x86_sse_mix_buffers_no_gain;
 	copy_vector           = default_copy_vector;
 
+	apply_gain_ramp          = default_apply_gain_ramp;
+	apply_gain_curve         = default_apply_gain_curve;
+	apply_inverse_gain_curve = default_apply_inverse_gain_curve;
+	mix_buffers_with_curve   = default_mix_buffers_with_curve;
+	interleave               = default_interleave;
+	deinterleave             = default_deinterleave;
+	clip_buffer              = default_clip_buffer;
+
 	run (align_max);
 }
 
@@ -201,6 +282,14 @@ FPUTest::neonTest ()
 	mix_buffers_no_gain   = arm_neon_mix_buffers_no_gain;
 	copy_vector           = arm_neon_copy_vector;
 
+	apply_gain_ramp          = arm_neon_apply_gain_ramp;
+	apply_gain_curve         = arm_neon_apply_gain_curve;
+	apply_inverse_gain_curve = arm_neon_apply_inverse_gain_curve;
+	mix_buffers_with_curve   = arm_neon_mix_buffers_with_curve;
+	interleave               = arm_neon_interleave;
+	deinterleave             = arm_neon_deinterleave;
+	clip_buffer              = arm_neon_clip_buffer;
+
 	run (128);
 }
 
@@ -225,6 +314,14 @@ FPUTest::veclibTest ()
 	mix_buffers_no_gain   = veclib_mix_buffers_no_gain;
 	copy_vector           = default_copy_vector;
 
+	apply_gain_ramp          = default_apply_gain_ramp;
+	apply_gain_curve         = default_apply_gain_curve;
+	apply_inverse_gain_curve = default_apply_inverse_gain_curve;
+	mix_buffers_with_curve   = default_mix_buffers_with_curve;
+	interleave               = default_interleave;
+	deinterleave             = default_deinterleave;
+	clip_buffer              = default_clip_buffer;
+
 	run (16);
 }
 
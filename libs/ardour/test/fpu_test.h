@@ -38,6 +38,7 @@ public:
 private:
 	void run (size_t);
 	void compare (std::string, size_t);
+	void compare_and_sync (std::string, size_t, float);
 
 	ARDOUR::compute_peak_t          compute_peak;
 	ARDOUR::find_peaks_t            find_peaks;
@@ -45,6 +46,13 @@ private:
 	ARDOUR::mix_buffers_with_gain_t mix_buffers_with_gain;
 	ARDOUR::mix_buffers_no_gain_t   mix_buffers_no_gain;
 	ARDOUR::copy_vector_t           copy_vector;
+	ARDOUR::apply_gain_ramp_t        apply_gain_ramp;
+	ARDOUR::apply_gain_curve_t       apply_gain_curve;
+	ARDOUR::apply_gain_curve_t       apply_inverse_gain_curve;
+	ARDOUR::mix_buffers_with_curve_t mix_buffers_with_curve;
+	ARDOUR::interleave_t             interleave;
+	ARDOUR::deinterleave_t           deinterleave;
+	ARDOUR::clip_buffer_t            clip_buffer;
 
 	size_t _size;
 
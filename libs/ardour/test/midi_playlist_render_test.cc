@@ -0,0 +1,140 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cstring>
+
+#include <glibmm/miscutils.h>
+
+#include "pbd/compose.h"
+#include "evoral/Note.h"
+#include "ardour/midi_model.h"
+#include "ardour/midi_playlist.h"
+#include "ardour/midi_region.h"
+#include "ardour/midi_source.h"
+#include "ardour/playlist_factory.h"
+#include "ardour/region_factory.h"
+#include "ardour/rt_midibuffer.h"
+#include "ardour/session.h"
+#include "ardour/source_factory.h"
+#include "midi_playlist_render_test.h"
+#include "test_util.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (MidiPlaylistRenderTest);
+
+using namespace std;
+using namespace PBD;
+using namespace ARDOUR;
+
+void
+MidiPlaylistRenderTest::setUp ()
+{
+	TestNeedingSession::setUp ();
+
+	std::string const test_mid_path = Glib::build_filename (new_test_output_dir(), "test.mid");
+	_playlist = boost::dynamic_pointer_cast<MidiPlaylist> (PlaylistFactory::create (DataType::MIDI, *_session, "test"));
+	_source = SourceFactory::createWritable (DataType::MIDI, *_session, test_mid_path, _session->sample_rate ());
+
+	boost::shared_ptr<MidiModel> model = boost::dynamic_pointer_cast<MidiSource> (_source)->model ();
+	CPPUNIT_ASSERT (model);
+
+	MidiModel::NoteDiffCommand* cmd = model->new_note_diff_command ("test notes");
+	for (int i = 0; i < 32; ++i) {
+		cmd->add (boost::shared_ptr<Evoral::Note<Temporal::Beats> > (
+			          new Evoral::Note<Temporal::Beats> (0, Temporal::Beats (i, 0), Temporal::Beats (0.5), 60 + (i % 12), 100)));
+	}
+	model->apply_command (*_session, cmd);
+
+	samplecnt_t const one_second = _session->sample_rate ();
+
+	for (int i = 0; i < 4; ++i) {
+		PropertyList plist;
+		plist.add (Properties::start, i * one_second / 2);
+		plist.add (Properties::length, one_second);
+		_r[i] = RegionFactory::create (_source, plist);
+		_r[i]->set_name (string_compose ("mr%1", i));
+	}
+}
+
+void
+MidiPlaylistRenderTest::tearDown ()
+{
+	_playlist.reset ();
+	_source.reset ();
+	for (int i = 0; i < 4; ++i) {
+		_r[i].reset ();
+	}
+
+	TestNeedingSession::tearDown ();
+}
+
+/** Render a copy of _playlist from scratch, and compare with what _playlist has */
+void
+MidiPlaylistRenderTest::check_equal_to_full_render ()
+{
+	boost::shared_ptr<MidiPlaylist> full = boost::dynamic_pointer_cast<MidiPlaylist> (PlaylistFactory::create (_playlist, "full"));
+	full->render (0);
+
+	RTMidiBuffer const* a = _playlist->rendered ();
+	RTMidiBuffer const* b = full->rendered ();
+
+	CPPUNIT_ASSERT (a->size () > 0);
+	CPPUNIT_ASSERT_EQUAL (b->size (), a->size ());
+
+	for (size_t n = 0; n < a->size (); ++n) {
+		CPPUNIT_ASSERT_EQUAL (b->timestamp (n), a->timestamp (n));
+
+		uint32_t a_size;
+		uint32_t b_size;
+		uint8_t const* a_data = a->event (n, a_size);
+		uint8_t const* b_data = b->event (n, b_size);
+
+		CPPUNIT_ASSERT_EQUAL (b_size, a_size);
+		CPPUNIT_ASSERT (memcmp (a_data, b_data, a_size) == 0);
+	}
+}
+
+void
+MidiPlaylistRenderTest::incrementalTest ()
+{
+	samplecnt_t const one_second = _session->sample_rate ();
+
+	_playlist->add_region (_r[0], 0);
+	_playlist->add_region (_r[1], one_second);
+	_playlist->add_region (_r[2], 3 * one_second);
+	_playlist->render (0);
+	check_equal_to_full_render ();
+
+	/* move, overlapping another region */
+	_r[1]->set_position (one_second / 2);
+	_playlist->render (0);
+	check_equal_to_full_render ();
+
+	/* remove and add */
+	_playlist->remove_region (_r[2]);
+	_playlist->add_region (_r[3], 2 * one_second);
+	_playlist->render (0);
+	check_equal_to_full_render ();
+
+	/* trim and mute */
+	_r[3]->trim_end (2 * one_second + one_second / 3);
+	_r[0]->set_muted (true);
+	_playlist->render (0);
+	check_equal_to_full_render ();
+
+	/* nothing changed */
+	_playlist->render (0);
+	check_equal_to_full_render ();
+}
@@ -0,0 +1,50 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <boost/shared_ptr.hpp>
+#include "test_needing_session.h"
+
+namespace ARDOUR {
+	class MidiPlaylist;
+	class Source;
+	class Region;
+}
+
+/** Checks that incremental renders of a MIDI playlist produce the same
+ *  data as a complete render.
+ */
+class MidiPlaylistRenderTest : public TestNeedingSession
+{
+	CPPUNIT_TEST_SUITE (MidiPlaylistRenderTest);
+	CPPUNIT_TEST (incrementalTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void setUp ();
+	void tearDown ();
+
+	void incrementalTest ();
+
+private:
+	void check_equal_to_full_render ();
+
+	boost::shared_ptr<ARDOUR::MidiPlaylist> _playlist;
+	boost::shared_ptr<ARDOUR::Source> _source;
+	/** 4 regions of one second each, at different offsets into a source
+	 *  which has a note on every beat.
+	 */
+	boost::shared_ptr<ARDOUR::Region> _r[4];
+};
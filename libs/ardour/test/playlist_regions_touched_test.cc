@@ -0,0 +1,96 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "ardour/playlist.h"
+#include "ardour/region.h"
+#include "playlist_regions_touched_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (PlaylistRegionsTouchedTest);
+
+using namespace std;
+using namespace ARDOUR;
+
+/** Compare the indexed lookup with a linear scan of the playlist */
+void
+PlaylistRegionsTouchedTest::check_against_regions (samplepos_t start, samplepos_t end)
+{
+	boost::shared_ptr<RegionList> all = _playlist->region_list ();
+	RegionList expected;
+
+	for (RegionList::const_iterator i = all->begin (); i != all->end (); ++i) {
+		if ((*i)->coverage (start, end) != Evoral::OverlapNone) {
+			expected.push_back (*i);
+		}
+	}
+
+	boost::shared_ptr<RegionList> touched = _playlist->regions_touched (start, end);
+
+	CPPUNIT_ASSERT_EQUAL (expected.size (), touched->size ());
+
+	RegionList::const_iterator j = touched->begin ();
+	for (RegionList::const_iterator i = expected.begin (); i != expected.end (); ++i, ++j) {
+		CPPUNIT_ASSERT (*i == *j);
+	}
+}
+
+void
+PlaylistRegionsTouchedTest::basicsTest ()
+{
+	/* 16 regions of length 100, partially overlapping */
+	for (int i = 0; i < 16; ++i) {
+		_playlist->add_region (_r[i], i * 70);
+	}
+
+	CPPUNIT_ASSERT_EQUAL ((size_t) 0, _playlist->regions_touched (2000, 3000)->size ());
+	CPPUNIT_ASSERT_EQUAL ((size_t) 1, _playlist->regions_touched (0, 0)->size ());
+	CPPUNIT_ASSERT_EQUAL ((size_t) 2, _playlist->regions_touched (70, 70)->size ());
+	CPPUNIT_ASSERT_EQUAL ((size_t) 16, _playlist->regions_touched (0, 2000)->size ());
+
+	for (samplepos_t s = 0; s < 1200; s += 13) {
+		check_against_regions (s, s);
+		check_against_regions (s, s + 99);
+		check_against_regions (s, s + 250);
+	}
+}
+
+void
+PlaylistRegionsTouchedTest::moveTest ()
+{
+	for (int i = 0; i < 16; ++i) {
+		_playlist->add_region (_r[i], i * 100);
+	}
+
+	CPPUNIT_ASSERT_EQUAL ((size_t) 1, _playlist->regions_touched (5000, 5050)->size ());
+	check_against_regions (0, 200);
+
+	/* moving a region must update the index */
+	_r[0]->set_position (5000);
+
+	CPPUNIT_ASSERT_EQUAL ((size_t) 1, _playlist->regions_touched (5000, 5050)->size ());
+	CPPUNIT_ASSERT (_playlist->regions_touched (5000, 5050)->front () == _r[0]);
+	check_against_regions (0, 200);
+
+	/* .. and so must trimming and removing */
+	_r[1]->trim_end (150);
+	check_against_regions (140, 160);
+
+	_playlist->remove_region (_r[0]);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 0, _playlist->regions_touched (5000, 5050)->size ());
+
+	for (samplepos_t s = 0; s < 1700; s += 17) {
+		check_against_regions (s, s + 40);
+	}
+}
@@ -635,3 +635,69 @@ TempoTest::tempoFundamentalsTest ()
 	CPPUNIT_ASSERT_DOUBLES_EQUAL (164.0, tE->quarter_notes_per_minute (), 1e-17);
 	CPPUNIT_ASSERT_DOUBLES_EQUAL (41.0, tE->pulses_per_minute (), 1e-17);
 }
+
+void
+TempoTest::indexTest ()
+{
+	int const sampling_rate = 48000;
+
+	TempoMap map (sampling_rate);
+	map.replace_meter (map.first_meter(), Meter (4, 4), BBT_Time (1, 1, 0), 0, AudioTime);
+	map.replace_tempo (map.first_tempo(), Tempo (120.0, 4.0, 140.0), 0.0, 0, AudioTime);
+
+	/* a mix of music- and audio-locked, ramped and constant sections */
+	for (int n = 1; n < 40; ++n) {
+		if (n % 4 == 0) {
+			map.add_meter (Meter (3 + n % 3, 4), BBT_Time (4 * n + 1, 1, 0), 0, MusicTime);
+		} else if (n % 3 == 0) {
+			map.add_tempo (Tempo (80.0 + n, 4.0), 0.0, n * sampling_rate * 5, AudioTime);
+		} else {
+			map.add_tempo (Tempo (100.0 + 2 * n, 4.0, 90.0 + n), n * 3.5, 0, MusicTime);
+		}
+	}
+
+	CPPUNIT_ASSERT (map._index.valid ());
+
+	Metrics const& metrics (map._metrics);
+	TempoMapIndex index (map._index);
+
+	for (int n = 0; n < 2000; ++n) {
+		const samplepos_t s = (n - 10) * 7919;
+		const double minute = map.minute_at_sample (s);
+		const double pulse = s / (double) sampling_rate / 4.0;
+		const double beat = pulse * 4.0;
+		const BBT_Time bbt (1 + n % 180, 1 + n % 3, (n * 7) % 1920);
+
+		/* indexed lookups */
+		map._index = index;
+
+		const double pulse_at_minute = map.pulse_at_minute_locked (metrics, minute);
+		const double minute_at_pulse = map.minute_at_pulse_locked (metrics, pulse);
+		const double beat_at_minute = map.beat_at_minute_locked (metrics, minute);
+		const double minute_at_beat = map.minute_at_beat_locked (metrics, beat);
+		const double beat_at_bbt = map.beat_at_bbt_locked (metrics, bbt);
+		const double pulse_at_bbt = map.pulse_at_bbt_locked (metrics, bbt);
+		const BBT_Time bbt_at_pulse = map.bbt_at_pulse_locked (metrics, pulse);
+		const BBT_Time bbt_at_minute = map.bbt_at_minute_locked (metrics, minute);
+		const TempoSection* ts = &map.tempo_section_at_minute_locked (metrics, minute);
+		const MeterSection* ms = &map.meter_section_at_beat_locked (metrics, beat);
+		const double qn_rt = map.quarter_note_at_sample_rt (s);
+		const BBT_Time bbt_rt = map.bbt_at_sample_rt (s);
+
+		/* the same via a walk over the list */
+		map._index.clear ();
+
+		CPPUNIT_ASSERT_EQUAL (map.pulse_at_minute_locked (metrics, minute), pulse_at_minute);
+		CPPUNIT_ASSERT_EQUAL (map.minute_at_pulse_locked (metrics, pulse), minute_at_pulse);
+		CPPUNIT_ASSERT_EQUAL (map.beat_at_minute_locked (metrics, minute), beat_at_minute);
+		CPPUNIT_ASSERT_EQUAL (map.minute_at_beat_locked (metrics, beat), minute_at_beat);
+		CPPUNIT_ASSERT_EQUAL (map.beat_at_bbt_locked (metrics, bbt), beat_at_bbt);
+		CPPUNIT_ASSERT_EQUAL (map.pulse_at_bbt_locked (metrics, bbt), pulse_at_bbt);
+		CPPUNIT_ASSERT_EQUAL (map.bbt_at_pulse_locked (metrics, pulse), bbt_at_pulse);
+		CPPUNIT_ASSERT_EQUAL (map.bbt_at_minute_locked (metrics, minute), bbt_at_minute);
+		CPPUNIT_ASSERT_EQUAL (&map.tempo_section_at_minute_locked (metrics, minute), ts);
+		CPPUNIT_ASSERT_EQUAL (&map.meter_section_at_beat_locked (metrics, beat), ms);
+		CPPUNIT_ASSERT_EQUAL (pulse_at_minute * 4.0, qn_rt);
+		CPPUNIT_ASSERT_EQUAL (bbt_at_minute, bbt_rt);
+	}
+}
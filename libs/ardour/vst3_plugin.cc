@@ -16,6 +16,8 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <limits>
+
 #include "pbd/gstdio_compat.h"
 #include <glibmm.h>
 
@@ -583,6 +585,16 @@ VST3Plugin::plugin_latency () const
 	return _plug->plugin_latency ();
 }
 
+samplecnt_t
+VST3Plugin::signal_tail () const
+{
+	uint32_t tail = _plug->plugin_tail ();
+	if (tail == Vst::kInfiniteTail) {
+		return std::numeric_limits<samplecnt_t>::max ();
+	}
+	return tail;
+}
+
 void
 VST3Plugin::add_slave (boost::shared_ptr<Plugin> p, bool rt)
 {
@@ -1471,6 +1483,7 @@ VST3PI::activate ()
 	}
 
 	_plugin_latency.reset ();
+	_plugin_tail.reset ();
 	_is_processing = true;
 	return true;
 }
@@ -1509,6 +1522,15 @@ VST3PI::plugin_latency ()
 	return _plugin_latency.value ();
 }
 
+uint32_t
+VST3PI::plugin_tail ()
+{
+	if (!_plugin_tail) {
+		_plugin_tail = _processor->getTailSamples ();
+	}
+	return _plugin_tail.value ();
+}
+
 void
 VST3PI::set_owner (SessionObject* o)
 {
@@ -0,0 +1,267 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "ardour/mix.h"
+
+#include <immintrin.h>
+#include <xmmintrin.h>
+
+#ifndef __AVX__
+#error "__AVX__ must be enabled for this module to work"
+#endif
+
+/* These routines use unaligned loads and stores throughout: the buffers
+ * they operate on (fade curves, offsets into disk-reader buffers,
+ * interleaved file data) are rarely aligned, and on CPUs that support AVX
+ * unaligned access to aligned data carries no penalty.
+ */
+
+/**
+ * @brief x86-64 AVX optimized routine for applying a declicking gain ramp.
+ *
+ * The one-pole lowpass g[n+1] = g[n] + c * (t - g[n]) has the closed form
+ * g[n] = t + (g[0] - t) * (1 - c)^n, which allows to compute 8 gain
+ * coefficients at once.
+ *
+ * @param[in,out] buf Pointer to buffer, which gets updated
+ * @param nframes Number of samples to process
+ * @param initial Gain of the first sample
+ * @param target Gain that is approached
+ * @param coeff Lowpass filter coefficient
+ * @return gain after the last sample
+ */
+float
+x86_sse_avx_apply_gain_ramp (float* buf, uint32_t nframes, float initial, float target, float coeff)
+{
+	if (nframes < 16) {
+		return default_apply_gain_ramp (buf, nframes, initial, target, coeff);
+	}
+
+	float  pwr[8];
+	double k = 1.0;
+	for (int i = 0; i < 8; ++i) {
+		pwr[i] = k;
+		k *= 1.0 - coeff;
+	}
+
+	const __m256 vp = _mm256_loadu_ps (pwr);
+	const __m256 vk = _mm256_set1_ps (k);
+	const __m256 vt = _mm256_set1_ps (target);
+	__m256       vd = _mm256_set1_ps (initial - target);
+
+	while (nframes >= 8) {
+		__m256 g = _mm256_add_ps (vt, _mm256_mul_ps (vd, vp));
+		_mm256_storeu_ps (buf, _mm256_mul_ps (g, _mm256_loadu_ps (buf)));
+		vd = _mm256_mul_ps (vd, vk);
+		buf += 8;
+		nframes -= 8;
+	}
+
+	float g = target + _mm_cvtss_f32 (_mm256_castps256_ps128 (vd));
+
+	_mm256_zeroupper ();
+
+	return default_apply_gain_ramp (buf, nframes, g, target, coeff);
+}
+
+/**
+ * @brief x86-64 AVX optimized routine for multiplying a buffer by a gain curve.
+ *
+ * @param[in,out] buf Pointer to buffer, which gets updated
+ * @param[in] gain Pointer to per-sample gain coefficients
+ * @param nframes Number of samples to process
+ */
+void
+x86_sse_avx_apply_gain_curve (float* buf, float const* gain, uint32_t nframes)
+{
+	while (nframes >= 8) {
+		_mm256_storeu_ps (buf, _mm256_mul_ps (_mm256_loadu_ps (buf), _mm256_loadu_ps (gain)));
+		buf += 8;
+		gain += 8;
+		nframes -= 8;
+	}
+
+	_mm256_zeroupper ();
+
+	while (nframes > 0) {
+		*buf++ *= *gain++;
+		--nframes;
+	}
+}
+
+/**
+ * @brief x86-64 AVX optimized routine for multiplying a buffer by an inverted gain curve (1 - gain).
+ *
+ * @param[in,out] buf Pointer to buffer, which gets updated
+ * @param[in] gain Pointer to per-sample gain coefficients
+ * @param nframes Number of samples to process
+ */
+void
+x86_sse_avx_apply_inverse_gain_curve (float* buf, float const* gain, uint32_t nframes)
+{
+	const __m256 one = _mm256_set1_ps (1.f);
+
+	while (nframes >= 8) {
+		__m256 g = _mm256_sub_ps (one, _mm256_loadu_ps (gain));
+		_mm256_storeu_ps (buf, _mm256_mul_ps (_mm256_loadu_ps (buf), g));
+		buf += 8;
+		gain += 8;
+		nframes -= 8;
+	}
+
+	_mm256_zeroupper ();
+
+	while (nframes > 0) {
+		*buf++ *= 1.f - *gain++;
+		--nframes;
+	}
+}
+
+/**
+ * @brief x86-64 AVX optimized routine for mixing a buffer with a gain curve.
+ *
+ * @param[in,out] dst Pointer to destination buffer, which gets updated
+ * @param[in] src Pointer to source buffer (not updated)
+ * @param[in] gain Pointer to per-sample gain coefficients
+ * @param nframes Number of samples to process
+ */
+void
+x86_sse_avx_mix_buffers_with_curve (float* dst, float const* src, float const* gain, uint32_t nframes)
+{
+	while (nframes >= 8) {
+		__m256 s = _mm256_mul_ps (_mm256_loadu_ps (src), _mm256_loadu_ps (gain));
+		_mm256_storeu_ps (dst, _mm256_add_ps (_mm256_loadu_ps (dst), s));
+		dst += 8;
+		src += 8;
+		gain += 8;
+		nframes -= 8;
+	}
+
+	_mm256_zeroupper ();
+
+	while (nframes > 0) {
+		*dst++ += *src++ * *gain++;
+		--nframes;
+	}
+}
+
+/**
+ * @brief x86-64 AVX optimized routine for writing one channel of interleaved data.
+ *
+ * Only stereo is vectorized, other layouts are handled by the generic routine.
+ * The samples of the other channel are read and written back unmodified.
+ *
+ * @param[out] dst Pointer to the first sample of the channel in the interleaved buffer
+ * @param[in] src Pointer to source buffer (not updated)
+ * @param stride Number of interleaved channels
+ * @param nframes Number of samples to process
+ */
+void
+x86_sse_avx_interleave (float* dst, float const* src, uint32_t stride, uint32_t nframes)
+{
+	if (stride != 2) {
+		default_interleave (dst, src, stride, nframes);
+		return;
+	}
+
+	/* the last vector touches one sample past the end of this channel,
+	 * which is only valid if there is another frame following it.
+	 */
+	while (nframes > 8) {
+		__m256 s  = _mm256_loadu_ps (src);
+		__m256 lo = _mm256_unpacklo_ps (s, s); // s0 s0 s1 s1 | s4 s4 s5 s5
+		__m256 hi = _mm256_unpackhi_ps (s, s); // s2 s2 s3 s3 | s6 s6 s7 s7
+		__m256 a  = _mm256_permute2f128_ps (lo, hi, 0x20);
+		__m256 b  = _mm256_permute2f128_ps (lo, hi, 0x31);
+
+		_mm256_storeu_ps (dst + 0, _mm256_blend_ps (_mm256_loadu_ps (dst + 0), a, 0x55));
+		_mm256_storeu_ps (dst + 8, _mm256_blend_ps (_mm256_loadu_ps (dst + 8), b, 0x55));
+
+		src += 8;
+		dst += 16;
+		nframes -= 8;
+	}
+
+	_mm256_zeroupper ();
+
+	default_interleave (dst, src, stride, nframes);
+}
+
+/**
+ * @brief x86-64 AVX optimized routine for extracting one channel of interleaved data.
+ *
+ * Only stereo is vectorized, other layouts are handled by the generic routine.
+ *
+ * @param[out] dst Pointer to destination buffer
+ * @param[in] src Pointer to the first sample of the channel in the interleaved buffer
+ * @param stride Number of interleaved channels
+ * @param nframes Number of samples to process
+ * @param gain Gain to apply
+ */
+void
+x86_sse_avx_deinterleave (float* dst, float const* src, uint32_t stride, uint32_t nframes, float gain)
+{
+	if (stride != 2) {
+		default_deinterleave (dst, src, stride, nframes, gain);
+		return;
+	}
+
+	const __m256 vgain = _mm256_set1_ps (gain);
+
+	/* see x86_sse_avx_interleave() */
+	while (nframes > 8) {
+		__m256 a  = _mm256_loadu_ps (src + 0);
+		__m256 b  = _mm256_loadu_ps (src + 8);
+		__m256 lo = _mm256_permute2f128_ps (a, b, 0x20); // a0..a3 | b0..b3
+		__m256 hi = _mm256_permute2f128_ps (a, b, 0x31); // a4..a7 | b4..b7
+		__m256 d  = _mm256_shuffle_ps (lo, hi, _MM_SHUFFLE (2, 0, 2, 0));
+
+		_mm256_storeu_ps (dst, _mm256_mul_ps (d, vgain));
+
+		src += 16;
+		dst += 8;
+		nframes -= 8;
+	}
+
+	_mm256_zeroupper ();
+
+	default_deinterleave (dst, src, stride, nframes, gain);
+}
+
+/**
+ * @brief x86-64 AVX optimized routine for hard-clipping a buffer.
+ *
+ * @param[in,out] buf Pointer to buffer, which gets updated
+ * @param nframes Number of samples to process
+ * @param limit Absolute value to clip to
+ */
+void
+x86_sse_avx_clip_buffer (float* buf, uint32_t nframes, float limit)
+{
+	const __m256 vmax = _mm256_set1_ps (limit);
+	const __m256 vmin = _mm256_set1_ps (-limit);
+
+	while (nframes >= 8) {
+		__m256 x = _mm256_loadu_ps (buf);
+		_mm256_storeu_ps (buf, _mm256_min_ps (vmax, _mm256_max_ps (vmin, x)));
+		buf += 8;
+		nframes -= 8;
+	}
+
+	_mm256_zeroupper ();
+
+	default_clip_buffer (buf, nframes, limit);
+}
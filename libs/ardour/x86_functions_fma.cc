@@ -106,7 +106,7 @@ x86_fma_mix_buffers_with_gain(
 			// Load destinations
 			d0 = _mm256_load_ps(dst + 0 );
 			// dst = dst + (src * gain)
-			d0 = _mm256_fmadd_ps(g0, d0, s0);
+			d0 = _mm256_fmadd_ps(g0, s0, d0);
 			// Store result
 			_mm256_store_ps(dst, d0);
 			// Update pointers and counters
@@ -138,4 +138,79 @@ x86_fma_mix_buffers_with_gain(
 	} while (0);
 }
 
+/**
+ * @brief x86-64 AVX/FMA optimized routine for applying a declicking gain ramp.
+ *
+ * see x86_sse_avx_apply_gain_ramp()
+ *
+ * @param[in,out] buf Pointer to buffer, which gets updated
+ * @param nframes Number of samples to process
+ * @param initial Gain of the first sample
+ * @param target Gain that is approached
+ * @param coeff Lowpass filter coefficient
+ * @return gain after the last sample
+ */
+float
+x86_fma_apply_gain_ramp(float *buf, uint32_t nframes, float initial, float target, float coeff)
+{
+	if (nframes < 16) {
+		return default_apply_gain_ramp(buf, nframes, initial, target, coeff);
+	}
+
+	float  pwr[8];
+	double k = 1.0;
+	for (int i = 0; i < 8; ++i) {
+		pwr[i] = k;
+		k *= 1.0 - coeff;
+	}
+
+	const __m256 vp = _mm256_loadu_ps(pwr);
+	const __m256 vk = _mm256_set1_ps(k);
+	const __m256 vt = _mm256_set1_ps(target);
+	__m256       vd = _mm256_set1_ps(initial - target);
+
+	while (nframes >= 8) {
+		// gain = target + delta * (1 - coeff)^n
+		__m256 g = _mm256_fmadd_ps(vd, vp, vt);
+		_mm256_storeu_ps(buf, _mm256_mul_ps(g, _mm256_loadu_ps(buf)));
+		vd = _mm256_mul_ps(vd, vk);
+		buf += 8;
+		nframes -= 8;
+	}
+
+	float g = target + _mm_cvtss_f32(_mm256_castps256_ps128(vd));
+
+	_mm256_zeroupper();
+
+	return default_apply_gain_ramp(buf, nframes, g, target, coeff);
+}
+
+/**
+ * @brief x86-64 AVX/FMA optimized routine for mixing a buffer with a gain curve.
+ *
+ * @param[in,out] dst Pointer to destination buffer, which gets updated
+ * @param[in] src Pointer to source buffer (not updated)
+ * @param[in] gain Pointer to per-sample gain coefficients
+ * @param nframes Number of samples to process
+ */
+void
+x86_fma_mix_buffers_with_curve(float *dst, const float *src, const float *gain, uint32_t nframes)
+{
+	while (nframes >= 8) {
+		__m256 d0 = _mm256_fmadd_ps(_mm256_loadu_ps(src), _mm256_loadu_ps(gain), _mm256_loadu_ps(dst));
+		_mm256_storeu_ps(dst, d0);
+		dst += 8;
+		src += 8;
+		gain += 8;
+		nframes -= 8;
+	}
+
+	_mm256_zeroupper();
+
+	while (nframes > 0) {
+		*dst++ += *src++ * *gain++;
+		--nframes;
+	}
+}
+
 #endif // FPU_AVX_FMA_SUPPORT
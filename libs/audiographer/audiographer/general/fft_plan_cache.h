@@ -0,0 +1,76 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef AUDIOGRAPHER_FFT_PLAN_CACHE_H
+#define AUDIOGRAPHER_FFT_PLAN_CACHE_H
+
+#include <map>
+#include <string>
+#include <stdint.h>
+
+#include <fftw3.h>
+#include <glibmm/threads.h>
+
+#include "audiographer/visibility.h"
+
+namespace AudioGrapher
+{
+
+/** Process-wide cache of FFTW plans and wisdom.
+ *
+ * Planning with FFTW_MEASURE takes a noticeable amount of time for every
+ * new transform size. Plans are created once per size and shared by all
+ * users: a plan may be executed concurrently with fftwf_execute_r2r() on
+ * different, fftwf_malloc()ed, out-of-place buffers.
+ *
+ * Wisdom is loaded from and saved to a file, so that measurements
+ * carry over to the next run.
+ */
+class LIBAUDIOGRAPHER_API FFTPlanCache
+{
+  public:
+	/** Get a real-to-halfcomplex plan for the given size.
+	 * The plan is owned by the cache and remains valid until clear().
+	 * \n Not RT safe
+	 */
+	static fftwf_plan r2hc (uint32_t size);
+
+	/** Import wisdom from \a path. New wisdom is written back to
+	 * the same file whenever a plan is measured.
+	 * \return true if wisdom was loaded
+	 */
+	static bool load_wisdom (std::string const& path);
+
+	/** Write accumulated wisdom to the file given to load_wisdom() */
+	static bool save_wisdom ();
+
+	/** Destroy all cached plans. No plan may be in use */
+	static void clear ();
+
+  private:
+	typedef std::map<uint32_t, fftwf_plan> PlanMap;
+
+	static bool save_wisdom_locked ();
+
+	static Glib::Threads::Mutex _lock;
+	static PlanMap              _r2hc;
+	static std::string          _wisdom_file;
+	static bool                 _wisdom_dirty;
+};
+
+} // namespace
+
+#endif // AUDIOGRAPHER_FFT_PLAN_CACHE_H
@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2010-2011 Fons Adriaensen <fons@linuxaudio.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef AUDIOGRAPHER_LOUDNESS_METER_H
+#define AUDIOGRAPHER_LOUDNESS_METER_H
+
+#include <vector>
+
+#include "audiographer/visibility.h"
+#include "audiographer/types.h"
+
+namespace AudioGrapher
+{
+
+/** True-peak detector for a single channel (ITU-R BS.1770, 4x oversampling).
+ *
+ * The polyphase interpolation filter is the same as used by the
+ * dBTP Vamp plugin (zita-resampler, 48 taps per phase). Coefficients are
+ * stored phase-interleaved, so that the four interpolated samples of each
+ * input sample are computed with a single 4-wide multiply-accumulate per tap.
+ *
+ * Processing does not allocate memory and is realtime safe.
+ */
+class LIBAUDIOGRAPHER_API TruePeakMeter
+{
+  public:
+	TruePeakMeter ();
+
+	/// Clears the filter state and peak values \n RT safe
+	void reset ();
+
+	/** Processes samples
+	  * \n RT safe
+	  * \param data first sample of the channel
+	  * \param n_samples number of samples
+	  * \param stride distance between consecutive samples, the number of channels for interleaved data
+	  */
+	void process (float const * data, samplecnt_t n_samples, unsigned int stride = 1);
+
+	/// \return linear peak since the previous call to read ()
+	float read () { const float m = _m; _m = 0; return m; }
+
+	/// \return linear peak since reset ()
+	float peak () const { return _p; }
+
+  private:
+	static const unsigned int n_phases = 4;
+	static const unsigned int n_taps   = 48;
+	static const unsigned int n_chunk  = 64;
+
+	float _coeff[n_taps][n_phases];
+	float _z[n_taps - 1 + n_chunk];
+	float _m;
+	float _p;
+};
+
+/** EBU R128 loudness meter.
+ *
+ * Momentary and short-term loudness, integrated loudness and loudness range
+ * according to ITU-R BS.1770 / EBU R128, using the algorithm of
+ * Fons Adriaensen's ebu_r128_proc. All channels are weighted equally,
+ * mono is treated as dual-mono.
+ *
+ * init () allocates per-channel state, process () is realtime safe.
+ */
+class LIBAUDIOGRAPHER_API LoudnessMeter
+{
+  public:
+	LoudnessMeter ();
+
+	/// Sets up the K-weighting filter for the given rate and resets the meter \n Not RT safe
+	void init (float sample_rate, unsigned int n_channels);
+
+	/// Clears all filter state and statistics \n RT safe
+	void reset ();
+
+	/** Processes non-interleaved data
+	  * \n RT safe
+	  * \param data one buffer per channel
+	  * \param n_samples number of samples per channel
+	  */
+	void process (float const * const * data, samplecnt_t n_samples);
+
+	/** Processes interleaved data
+	  * \n RT safe
+	  * \param data interleaved buffer
+	  * \param n_samples number of samples per channel
+	  */
+	void process_interleaved (float const * data, samplecnt_t n_samples);
+
+	unsigned int n_channels () const { return _filter.size (); }
+
+	float momentary () const      { return _loudness_M; } ///< LUFS, 400ms window
+	float short_term () const     { return _loudness_S; } ///< LUFS, 3s window
+	float max_momentary () const  { return _maxloudn_M; }
+	float max_short_term () const { return _maxloudn_S; }
+	float integrated () const     { return _integrated; } ///< LUFS, gated
+	float range_min () const      { return _range_min; }
+	float range_max () const      { return _range_max; }
+
+	/// \return loudness range in LU
+	float loudness_range () const { return _range_max - _range_min; }
+
+	/** Histogram of short-term loudness values.
+	  * Bin \a i counts values of (i - 700) / 10 LUFS
+	  * \return array of \a histogram_size bins
+	  */
+	int const * short_term_histogram () const { return _hist_S; }
+
+	static const int histogram_size = 751;
+
+  private:
+	struct Filter {
+		Filter () : z1 (0), z2 (0), z3 (0), z4 (0) {}
+		float z1, z2, z3, z4;
+	};
+
+	void  run (samplecnt_t n_samples, unsigned int stride);
+	float detect_process (samplecnt_t n_samples, unsigned int stride);
+	float addfrags (int nfrag) const;
+
+	void  hist_reset ();
+	void  hist_addpoint (int* hist, int& count, float v);
+	float hist_integrate (int const* hist, int i) const;
+	void  calc_integrated ();
+	void  calc_range ();
+
+	int   _fragm;  ///< fragment size, 1/20 second
+	int   _frcnt;  ///< samples remaining in current fragment
+	float _frpwr;  ///< power accumulated for current fragment
+	float _power[64];
+	int   _wrind;
+	int   _div1;   ///< momentary histogram period counter, 200 ms
+	int   _div2;   ///< short-term histogram period counter, 1 s
+
+	float _loudness_M;
+	float _maxloudn_M;
+	float _loudness_S;
+	float _maxloudn_S;
+	float _integrated;
+	float _range_min;
+	float _range_max;
+
+	float _a0, _a1, _a2;
+	float _b1, _b2;
+	float _c3, _c4;
+
+	std::vector<Filter>        _filter;
+	std::vector<float const *> _ipp;
+
+	int   _hist_M[histogram_size];
+	int   _hist_S[histogram_size];
+	int   _count_M;
+	int   _count_S;
+	float _bin_power[100];
+};
+
+} // namespace
+
+#endif // AUDIOGRAPHER_LOUDNESS_METER_H
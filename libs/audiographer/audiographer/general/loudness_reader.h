@@ -21,10 +21,9 @@
 
 #include <vector>
 
-#include <vamp-hostsdk/PluginLoader.h>
-
 #include "audiographer/visibility.h"
 #include "audiographer/sink.h"
+#include "audiographer/general/loudness_meter.h"
 #include "audiographer/routines.h"
 #include "audiographer/utils/listed_source.h"
 
@@ -49,14 +48,13 @@ class LIBAUDIOGRAPHER_API LoudnessReader : public ListedSource<float>, public Si
 	using Sink<float>::process;
 
   protected:
-	Vamp::Plugin*              _ebur_plugin;
-	std::vector<Vamp::Plugin*> _dbtp_plugins;
+	LoudnessMeter*             _ebur; ///< mono and stereo only
+	std::vector<TruePeakMeter> _dbtp; ///< one per channel
 
 	float        _sample_rate;
 	unsigned int _channels;
 	samplecnt_t   _bufsize;
 	samplecnt_t   _pos;
-	float*       _bufs[2];
 };
 
 } // namespace
@@ -18,9 +18,11 @@ class LIBAUDIOGRAPHER_API Routines
 
 	typedef float (*compute_peak_t)          (float const *, uint_type, float);
 	typedef void  (*apply_gain_to_buffer_t)  (float *, uint_type, float);
+	typedef void  (*clip_buffer_t)           (float *, uint_type, float);
 
 	static void override_compute_peak         (compute_peak_t func)         { _compute_peak = func; }
 	static void override_apply_gain_to_buffer (apply_gain_to_buffer_t func) { _apply_gain_to_buffer = func; }
+	static void override_clip_buffer          (clip_buffer_t func)          { _clip_buffer = func; }
 
 	/** Computes peak in float buffer
 	  * \n RT safe
@@ -45,6 +47,17 @@ class LIBAUDIOGRAPHER_API Routines
 		(*_apply_gain_to_buffer) (data, samples, gain);
 	}
 
+	/** Clamps buffer to [-\a limit, \a limit]
+	 * \n RT safe
+	 * \param data data which is clipped
+	 * \param samples length of data
+	 * \param limit absolute value to clip to
+	 */
+	static inline void clip_buffer (float * data, uint_type samples, float limit)
+	{
+		(*_clip_buffer) (data, samples, limit);
+	}
+
   private:
 	static inline float default_compute_peak (float const * data, uint_type samples, float current_peak)
 	{
@@ -62,8 +75,20 @@ class LIBAUDIOGRAPHER_API Routines
 		}
 	}
 
+	static inline void default_clip_buffer (float * data, uint_type samples, float limit)
+	{
+		for (uint_type i = 0; i < samples; ++i) {
+			if (data[i] > limit) {
+				data[i] = limit;
+			} else if (data[i] < -limit) {
+				data[i] = -limit;
+			}
+		}
+	}
+
 	static compute_peak_t          _compute_peak;
 	static apply_gain_to_buffer_t  _apply_gain_to_buffer;
+	static clip_buffer_t           _clip_buffer;
 };
 
 } // namespace
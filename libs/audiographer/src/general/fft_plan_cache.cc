@@ -0,0 +1,90 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "audiographer/general/fft_plan_cache.h"
+
+using namespace AudioGrapher;
+
+Glib::Threads::Mutex    FFTPlanCache::_lock;
+FFTPlanCache::PlanMap   FFTPlanCache::_r2hc;
+std::string             FFTPlanCache::_wisdom_file;
+bool                    FFTPlanCache::_wisdom_dirty = false;
+
+fftwf_plan
+FFTPlanCache::r2hc (uint32_t size)
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	PlanMap::const_iterator i = _r2hc.find (size);
+	if (i != _r2hc.end ()) {
+		return i->second;
+	}
+
+	/* FFTW_MEASURE overwrites the buffers. Since users bring their own
+	 * buffers, plan on scratch memory of the same (fftwf_malloc) alignment.
+	 */
+	float* in  = (float*) fftwf_malloc (sizeof (float) * size);
+	float* out = (float*) fftwf_malloc (sizeof (float) * size);
+
+	fftwf_plan p = fftwf_plan_r2r_1d (size, in, out, FFTW_R2HC, FFTW_MEASURE);
+
+	fftwf_free (in);
+	fftwf_free (out);
+
+	_r2hc[size]   = p;
+	_wisdom_dirty = true;
+	save_wisdom_locked ();
+
+	return p;
+}
+
+bool
+FFTPlanCache::load_wisdom (std::string const& path)
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	_wisdom_file = path;
+	return fftwf_import_wisdom_from_filename (path.c_str ()) != 0;
+}
+
+bool
+FFTPlanCache::save_wisdom ()
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	return save_wisdom_locked ();
+}
+
+bool
+FFTPlanCache::save_wisdom_locked ()
+{
+	if (!_wisdom_dirty || _wisdom_file.empty ()) {
+		return false;
+	}
+	if (fftwf_export_wisdom_to_filename (_wisdom_file.c_str ()) == 0) {
+		return false;
+	}
+	_wisdom_dirty = false;
+	return true;
+}
+
+void
+FFTPlanCache::clear ()
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	for (PlanMap::const_iterator i = _r2hc.begin (); i != _r2hc.end (); ++i) {
+		fftwf_destroy_plan (i->second);
+	}
+	_r2hc.clear ();
+}
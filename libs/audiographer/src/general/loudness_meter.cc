@@ -0,0 +1,396 @@
+/*
+ * Copyright (C) 2010-2011 Fons Adriaensen <fons@linuxaudio.org>
+ * Copyright (C) 2012-2019 Robin Gareus <robin@gareus.org>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <string.h>
+
+#include "audiographer/general/loudness_meter.h"
+
+#ifdef COMPILER_MSVC
+#include <float.h>
+#define isfinite_local(val) (bool)_finite((double)val)
+#else
+#define isfinite_local std::isfinite
+#endif
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+using namespace AudioGrapher;
+
+/* ****************************************************************************
+ * True Peak
+ */
+
+static double
+sinc (double x)
+{
+	x = fabs (x);
+	if (x < 1e-6) {
+		return 1.0;
+	}
+	x *= M_PI;
+	return sin (x) / x;
+}
+
+static double
+wind (double x)
+{
+	x = fabs (x);
+	if (x >= 1.0) {
+		return 0.0;
+	}
+	x *= M_PI;
+	return 0.384 + 0.500 * cos (x) + 0.116 * cos (2 * x);
+}
+
+TruePeakMeter::TruePeakMeter ()
+{
+	/* phase p of the interpolated signal, delayed by half the filter length */
+	const double hl = n_taps / 2;
+	for (unsigned int k = 0; k < n_taps; ++k) {
+		for (unsigned int p = 0; p < n_phases; ++p) {
+			const double t = k - (hl - 1) - (double) p / n_phases;
+			_coeff[k][p] = sinc (t) * wind (t / hl);
+		}
+	}
+	reset ();
+}
+
+void
+TruePeakMeter::reset ()
+{
+	memset (_z, 0, sizeof (_z));
+	_m = 0;
+	_p = 0;
+}
+
+void
+TruePeakMeter::process (float const * data, samplecnt_t n_samples, unsigned int stride)
+{
+	const unsigned int hist = n_taps - 1;
+	float m = _m;
+
+	while (n_samples > 0) {
+		const unsigned int n = std::min<samplecnt_t> (n_samples, (samplecnt_t) n_chunk);
+
+		for (unsigned int i = 0; i < n; ++i) {
+			_z[hist + i] = data[i * stride];
+		}
+
+		for (unsigned int i = 0; i < n; ++i) {
+			float const * const w = &_z[i];
+			float acc[n_phases] = { 0, 0, 0, 0 };
+			for (unsigned int k = 0; k < n_taps; ++k) {
+				const float x = w[k];
+				for (unsigned int p = 0; p < n_phases; ++p) {
+					acc[p] += _coeff[k][p] * x;
+				}
+			}
+			for (unsigned int p = 0; p < n_phases; ++p) {
+				m = std::max (m, fabsf (acc[p]));
+			}
+		}
+
+		memmove (_z, &_z[n], hist * sizeof (float));
+
+		data      += n * stride;
+		n_samples -= n;
+	}
+
+	_m = m;
+	_p = std::max (_p, m);
+}
+
+/* ****************************************************************************
+ * Loudness
+ */
+
+LoudnessMeter::LoudnessMeter ()
+	: _fragm (0)
+{
+	for (int i = 0; i < 100; ++i) {
+		_bin_power[i] = powf (10.0f, i / 100.0f);
+	}
+	init (48000.f, 1);
+}
+
+void
+LoudnessMeter::init (float fsamp, unsigned int n_channels)
+{
+	float a, b, c, d, r, u1, u2, w1, w2;
+
+	_filter.resize (n_channels);
+	_ipp.resize (n_channels);
+	_fragm = (int) fsamp / 20;
+
+	/* K-weighting: high-shelf and high-pass, combined */
+	r  = 1 / tan (4712.3890f / fsamp);
+	w1 = r / 1.12201f;
+	w2 = r * 1.12201f;
+	u1 = u2 = 1.4085f + 210.0f / fsamp;
+	a  = u1 * w1;
+	b  = w1 * w1;
+	c  = u2 * w2;
+	d  = w2 * w2;
+	r  = 1 + a + b;
+	_a0 = (1 + c + d) / r;
+	_a1 = (2 - 2 * d) / r;
+	_a2 = (1 - c + d) / r;
+	_b1 = (2 - 2 * b) / r;
+	_b2 = (1 - a + b) / r;
+	r  = 48.0f / fsamp;
+	a  = 4.9886075f * r;
+	b  = 6.2298014f * r * r;
+	r  = 1 + a + b;
+	a *= 2 / r;
+	b *= 4 / r;
+	_c3 = a + b;
+	_c4 = b;
+	r  = 1.004995f / r;
+	_a0 *= r;
+	_a1 *= r;
+	_a2 *= r;
+
+	reset ();
+}
+
+void
+LoudnessMeter::reset ()
+{
+	_frcnt = _fragm;
+	_frpwr = 1e-30f;
+	_wrind = 0;
+	_div1  = 0;
+	_div2  = 0;
+
+	_loudness_M = -200.0f;
+	_loudness_S = -200.0f;
+	_maxloudn_M = -200.0f;
+	_maxloudn_S = -200.0f;
+	_integrated = -200.0f;
+	_range_min  = -200.0f;
+	_range_max  = -200.0f;
+
+	memset (_power, 0, sizeof (_power));
+	hist_reset ();
+
+	for (std::vector<Filter>::iterator i = _filter.begin (); i != _filter.end (); ++i) {
+		*i = Filter ();
+	}
+}
+
+void
+LoudnessMeter::process (float const * const * data, samplecnt_t n_samples)
+{
+	for (size_t c = 0; c < _ipp.size (); ++c) {
+		_ipp[c] = data[c];
+	}
+	run (n_samples, 1);
+}
+
+void
+LoudnessMeter::process_interleaved (float const * data, samplecnt_t n_samples)
+{
+	for (size_t c = 0; c < _ipp.size (); ++c) {
+		_ipp[c] = data + c;
+	}
+	run (n_samples, _ipp.size ());
+}
+
+void
+LoudnessMeter::run (samplecnt_t n_samples, unsigned int stride)
+{
+	while (n_samples > 0) {
+		const int k = std::min<samplecnt_t> (_frcnt, n_samples);
+
+		_frpwr += detect_process (k, stride);
+		_frcnt -= k;
+
+		if (_frcnt == 0) {
+			_power[_wrind++] = _frpwr / _fragm;
+			_frcnt = _fragm;
+			_frpwr = 1e-30f;
+			_wrind &= 63;
+
+			_loudness_M = addfrags (8);
+			_loudness_S = addfrags (60);
+			if (!isfinite_local (_loudness_M) || _loudness_M < -200.f) { _loudness_M = -200.0f; }
+			if (!isfinite_local (_loudness_S) || _loudness_S < -200.f) { _loudness_S = -200.0f; }
+			_maxloudn_M = std::max (_maxloudn_M, _loudness_M);
+			_maxloudn_S = std::max (_maxloudn_S, _loudness_S);
+
+			if (++_div1 == 2) {
+				hist_addpoint (_hist_M, _count_M, _loudness_M);
+				_div1 = 0;
+			}
+			if (++_div2 == 10) {
+				hist_addpoint (_hist_S, _count_S, _loudness_S);
+				_div2 = 0;
+				calc_integrated ();
+				calc_range ();
+			}
+		}
+
+		for (size_t c = 0; c < _ipp.size (); ++c) {
+			_ipp[c] += k * stride;
+		}
+		n_samples -= k;
+	}
+}
+
+float
+LoudnessMeter::detect_process (samplecnt_t n_samples, unsigned int stride)
+{
+	float si = 0;
+
+	for (size_t c = 0; c < _filter.size (); ++c) {
+		Filter& f (_filter[c]);
+		float z1 = f.z1;
+		float z2 = f.z2;
+		float z3 = f.z3;
+		float z4 = f.z4;
+		float const * p = _ipp[c];
+		float sj = 0;
+
+		for (samplecnt_t j = 0; j < n_samples; ++j, p += stride) {
+			const float x = *p - _b1 * z1 - _b2 * z2 + 1e-15f;
+			const float y = _a0 * x + _a1 * z1 + _a2 * z2 - _c3 * z3 - _c4 * z4;
+			z2  = z1;
+			z1  = x;
+			z4 += z3;
+			z3 += y;
+			sj += y * y;
+		}
+
+		si += sj;
+
+		f.z1 = isfinite_local (z1) ? z1 : 0;
+		f.z2 = isfinite_local (z2) ? z2 : 0;
+		f.z3 = isfinite_local (z3) ? z3 : 0;
+		f.z4 = isfinite_local (z4) ? z4 : 0;
+	}
+
+	/* mono is treated as dual-mono */
+	return _filter.size () == 1 ? 2 * si : si;
+}
+
+float
+LoudnessMeter::addfrags (int nfrag) const
+{
+	float s = 0;
+	const int k = (_wrind - nfrag) & 63;
+	for (int i = 0; i < nfrag; ++i) {
+		s += _power[(i + k) & 63];
+	}
+	return -0.6976f + 10 * log10f (s / nfrag);
+}
+
+void
+LoudnessMeter::hist_reset ()
+{
+	memset (_hist_M, 0, sizeof (_hist_M));
+	memset (_hist_S, 0, sizeof (_hist_S));
+	_count_M = 0;
+	_count_S = 0;
+}
+
+void
+LoudnessMeter::hist_addpoint (int* hist, int& count, float v)
+{
+	int k = (int) floorf (10 * v + 700.5f);
+	if (k < 0) {
+		return;
+	}
+	if (k >= histogram_size) {
+		k = histogram_size - 1;
+	}
+	++hist[k];
+	++count;
+}
+
+float
+LoudnessMeter::hist_integrate (int const* hist, int i) const
+{
+	int   j = i % 100;
+	int   n = 0;
+	float s = 0;
+
+	while (i < histogram_size) {
+		const int k = hist[i++];
+		n += k;
+		s += k * _bin_power[j++];
+		if (j == 100) {
+			j = 0;
+			s /= 10.0f;
+		}
+	}
+	return s / n;
+}
+
+void
+LoudnessMeter::calc_integrated ()
+{
+	if (_count_M < 50) {
+		_integrated = -200.0f;
+		return;
+	}
+	/* relative gate, -10 LU below the ungated loudness */
+	float s = hist_integrate (_hist_M, 0);
+	int   k = (int) (floorf (100 * log10f (s) + 0.5f)) + 600;
+	if (k < 0) {
+		k = 0;
+	}
+	s = hist_integrate (_hist_M, k);
+	_integrated = 10 * log10f (s);
+}
+
+void
+LoudnessMeter::calc_range ()
+{
+	int   i, j, k, n;
+	float a, b, s;
+
+	if (_count_S < 20) {
+		_range_min = -200.0f;
+		_range_max = -200.0f;
+		return;
+	}
+	/* relative gate, -20 LU below the ungated loudness */
+	s = hist_integrate (_hist_S, 0);
+	k = (int) (floorf (100 * log10f (s) + 0.5f)) + 500;
+	if (k < 0) {
+		k = 0;
+	}
+	for (i = k, n = 0; i < histogram_size; ++i) {
+		n += _hist_S[i];
+	}
+	a = 0.10f * n;
+	b = 0.95f * n;
+	for (i = k, s = 0; s < a; ++i) {
+		s += _hist_S[i];
+	}
+	for (j = histogram_size - 1, s = n; s > b; --j) {
+		s -= _hist_S[j];
+	}
+	_range_min = (i - 701) / 10.0f;
+	_range_max = (j - 699) / 10.0f;
+}
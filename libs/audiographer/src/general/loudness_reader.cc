@@ -23,7 +23,8 @@
 using namespace AudioGrapher;
 
 LoudnessReader::LoudnessReader (float sample_rate, unsigned int channels, samplecnt_t bufsize)
-	: _ebur_plugin (0)
+	: _ebur (0)
+	, _dbtp (channels)
 	, _sample_rate (sample_rate)
 	, _channels (channels)
 	, _bufsize (bufsize / channels)
@@ -35,59 +36,25 @@ LoudnessReader::LoudnessReader (float sample_rate, unsigned int channels, sample
 	assert (_bufsize > 0);
 
 	if (channels > 0 && channels <= 2) {
-		using namespace Vamp::HostExt;
-		PluginLoader* loader (PluginLoader::getInstance ());
-		_ebur_plugin = loader->loadPlugin ("libardourvampplugins:ebur128", sample_rate, PluginLoader::ADAPT_ALL_SAFE);
-		assert (_ebur_plugin); // should always be available
-		if (_ebur_plugin) {
-			_ebur_plugin->reset ();
-			if (!_ebur_plugin->initialise (channels, _bufsize, _bufsize)) {
-				delete _ebur_plugin;
-				_ebur_plugin = 0;
-			}
-		}
+		_ebur = new LoudnessMeter;
+		_ebur->init (sample_rate, channels);
 	}
-
-	for (unsigned int c = 0; c < _channels; ++c) {
-		using namespace Vamp::HostExt;
-		PluginLoader* loader (PluginLoader::getInstance ());
-		Vamp::Plugin* dbtp_plugin = loader->loadPlugin ("libardourvampplugins:dBTP", sample_rate, PluginLoader::ADAPT_ALL_SAFE);
-		assert (dbtp_plugin); // should always be available
-		if (!dbtp_plugin) {
-			continue;
-		}
-		dbtp_plugin->reset ();
-		if (!dbtp_plugin->initialise (1, _bufsize, _bufsize)) {
-			delete dbtp_plugin;
-		} else {
-			_dbtp_plugins.push_back (dbtp_plugin);
-		}
-	}
-
-	_bufs[0] = (float*) malloc (sizeof (float) * _bufsize);
-	_bufs[1] = (float*) malloc (sizeof (float) * _bufsize);
 }
 
 LoudnessReader::~LoudnessReader ()
 {
-	delete _ebur_plugin;
-	while (!_dbtp_plugins.empty()) {
-		delete _dbtp_plugins.back();
-		_dbtp_plugins.pop_back();
-	}
-	free (_bufs[0]);
-	free (_bufs[1]);
+	delete _ebur;
 }
 
 void
 LoudnessReader::reset ()
 {
-	if (_ebur_plugin) {
-		_ebur_plugin->reset ();
+	if (_ebur) {
+		_ebur->reset ();
 	}
 
-	for (std::vector<Vamp::Plugin*>::iterator it = _dbtp_plugins.begin (); it != _dbtp_plugins.end(); ++it) {
-		(*it)->reset ();
+	for (std::vector<TruePeakMeter>::iterator it = _dbtp.begin (); it != _dbtp.end(); ++it) {
+		it->reset ();
 	}
 }
 
@@ -100,43 +67,12 @@ LoudnessReader::process (ProcessContext<float> const & ctx)
 	assert (n_samples <= _bufsize);
 	//printf ("PROC %p @%ld F: %ld, S: %ld C:%d\n", this, _pos, ctx.samples (), n_samples, ctx.channels ());
 
-	unsigned processed_channels = 0;
-	if (_ebur_plugin) {
-		assert (_channels <= 2);
-		processed_channels = _channels;
-		samplecnt_t s;
-		float const * d = ctx.data ();
-		for (s = 0; s < n_samples; ++s) {
-			for (unsigned int c = 0; c < _channels; ++c, ++d) {
-				_bufs[c][s] = *d;
-			}
-		}
-		for (; s < _bufsize; ++s) {
-			for (unsigned int c = 0; c < _channels; ++c) {
-				_bufs[c][s] = 0.f;
-			}
-		}
-		_ebur_plugin->process (_bufs, Vamp::RealTime::fromSeconds ((double) _pos / _sample_rate));
-
-		if (_dbtp_plugins.size() > 0) {
-			_dbtp_plugins.at(0)->process (&_bufs[0], Vamp::RealTime::fromSeconds ((double) _pos / _sample_rate));
-		}
-		/* combined dBTP for EBU-R128 */
-		if (_channels == 2 && _dbtp_plugins.size() == 2) {
-			_dbtp_plugins.at(0)->process (&_bufs[1], Vamp::RealTime::fromSeconds ((double) _pos / _sample_rate));
-		}
+	if (_ebur) {
+		_ebur->process_interleaved (ctx.data (), n_samples);
 	}
 
-	for (unsigned int c = processed_channels; c < _channels && c < _dbtp_plugins.size (); ++c) {
-		samplecnt_t s;
-		float const * const d = ctx.data ();
-		for (s = 0; s < n_samples; ++s) {
-			_bufs[0][s] = d[s * _channels + c];
-		}
-		for (; s < _bufsize; ++s) {
-			_bufs[0][s] = 0.f;
-		}
-		_dbtp_plugins.at(c)->process (_bufs, Vamp::RealTime::fromSeconds ((double) _pos / _sample_rate));
+	for (unsigned int c = 0; c < _channels; ++c) {
+		_dbtp[c].process (ctx.data () + c, n_samples, _channels);
 	}
 
 	_pos += n_samples;
@@ -151,22 +87,14 @@ LoudnessReader::get_normalize_gain (float target_lufs, float target_dbtp)
 	uint32_t have_lufs = 0;
 	uint32_t have_dbtp = 0;
 
-	if (_ebur_plugin) {
-		Vamp::Plugin::FeatureSet features = _ebur_plugin->getRemainingFeatures ();
-		if (!features.empty () && features.size () == 3) {
-			const float lufs = features[0][0].values[0];
-			LUFS = std::max (LUFS, lufs);
-			++have_lufs;
-		}
+	if (_ebur) {
+		LUFS = std::max (LUFS, _ebur->integrated ());
+		++have_lufs;
 	}
 
-	for (unsigned int c = 0; c < _channels && c < _dbtp_plugins.size(); ++c) {
-		Vamp::Plugin::FeatureSet features = _dbtp_plugins.at(c)->getRemainingFeatures ();
-		if (!features.empty () && features.size () == 2) {
-			const float dbtp = features[0][0].values[0];
-			dBTP = std::max (dBTP, dbtp);
-			++have_dbtp;
-		}
+	for (unsigned int c = 0; c < _channels; ++c) {
+		dBTP = std::max (dBTP, _dbtp[c].peak ());
+		++have_dbtp;
 	}
 
 	float g = 100000.0; // +100dB
@@ -178,7 +106,6 @@ LoudnessReader::get_normalize_gain (float target_lufs, float target_dbtp)
 		set = true;
 	}
 
-	// TODO check that all channels were used.. ? (have_dbtp == _channels)
 	if (have_dbtp && dBTP > 0.f && target_dbtp <= 0.f) {
 		const float ge = pow (10.f, (target_dbtp * 0.05f)) / dBTP;
 		//printf ("TP:(%d chn) %fdBTP -> %f\n", have_dbtp, dBTP, ge);
@@ -22,6 +22,7 @@
 #include "audiographer/general/sample_format_converter.h"
 
 #include "audiographer/exception.h"
+#include "audiographer/routines.h"
 #include "audiographer/type_utils.h"
 #include "private/gdither/gdither.h"
 
@@ -167,13 +168,7 @@ SampleFormatConverter<float>::process (ProcessContext<float> & c_in)
 	float * data = c_in.data();
 
 	if (clip_floats) {
-		for (samplecnt_t x = 0; x < samples; ++x) {
-			if (data[x] > 1.0f) {
-				data[x] = 1.0f;
-			} else if (data[x] < -1.0f) {
-				data[x] = -1.0f;
-			}
-		}
+		Routines::clip_buffer (data, samples, 1.0f);
 	}
 
 	output (c_in);
@@ -0,0 +1,65 @@
+#include "tests/utils.h"
+
+#include <cmath>
+
+#include "audiographer/general/fft_plan_cache.h"
+
+using namespace AudioGrapher;
+
+class FFTPlanCacheTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE (FFTPlanCacheTest);
+  CPPUNIT_TEST (testPlanReuse);
+  CPPUNIT_TEST (testExecuteOnOwnBuffers);
+  CPPUNIT_TEST_SUITE_END ();
+
+  public:
+	void setUp()
+	{
+		size = 64;
+		in   = (float *) fftwf_malloc (sizeof (float) * size);
+		out  = (float *) fftwf_malloc (sizeof (float) * size);
+	}
+
+	void tearDown()
+	{
+		fftwf_free (in);
+		fftwf_free (out);
+		FFTPlanCache::clear ();
+	}
+
+	void testPlanReuse()
+	{
+		fftwf_plan a = FFTPlanCache::r2hc (size);
+		fftwf_plan b = FFTPlanCache::r2hc (size);
+		fftwf_plan c = FFTPlanCache::r2hc (2 * size);
+
+		CPPUNIT_ASSERT (a);
+		CPPUNIT_ASSERT (c);
+		CPPUNIT_ASSERT (a == b);
+		CPPUNIT_ASSERT (a != c);
+	}
+
+	void testExecuteOnOwnBuffers()
+	{
+		/* cosine with a period of 8 samples */
+		for (uint32_t i = 0; i < size; ++i) {
+			in[i] = cosf (2.f * M_PI * i / 8.f);
+		}
+
+		fftwf_execute_r2r (FFTPlanCache::r2hc (size), in, out);
+
+		const uint32_t bin = size / 8;
+		for (uint32_t i = 0; i <= size / 2; ++i) {
+			float expected = (i == bin) ? size / 2.f : 0.f;
+			CPPUNIT_ASSERT_DOUBLES_EQUAL (expected, out[i], 1e-3);
+		}
+	}
+
+  private:
+	uint32_t size;
+	float*   in;
+	float*   out;
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION (FFTPlanCacheTest);
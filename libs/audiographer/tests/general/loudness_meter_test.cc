@@ -0,0 +1,112 @@
+#include "tests/utils.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "audiographer/general/loudness_meter.h"
+
+using namespace AudioGrapher;
+
+class LoudnessMeterTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE (LoudnessMeterTest);
+  CPPUNIT_TEST (testStereoSine);
+  CPPUNIT_TEST (testInterleaved);
+  CPPUNIT_TEST (testTruePeak);
+  CPPUNIT_TEST_SUITE_END ();
+
+  public:
+	void setUp()
+	{
+		rate    = 48000;
+		samples = 10 * rate;
+
+		/* EBU Tech 3341, case 1: 1kHz sine, -23 dBFS in both channels.
+		 * (997Hz avoids a period that is a whole number of samples) */
+		const float amp = powf (10.f, -23.f / 20.f);
+		left  = new float[samples];
+		right = new float[samples];
+		interleaved = new float[2 * samples];
+		for (samplecnt_t i = 0; i < samples; ++i) {
+			left[i] = right[i] = amp * sinf (2.f * M_PI * 997.f * i / rate);
+			interleaved[2 * i] = interleaved[2 * i + 1] = left[i];
+		}
+	}
+
+	void tearDown()
+	{
+		delete [] left;
+		delete [] right;
+		delete [] interleaved;
+	}
+
+	void testStereoSine()
+	{
+		LoudnessMeter meter;
+		meter.init (rate, 2);
+
+		float const* data[2] = { left, right };
+		meter.process (data, samples);
+
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (-23.0, meter.integrated (), 0.1);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (-23.0, meter.max_momentary (), 0.1);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (-23.0, meter.max_short_term (), 0.1);
+
+		meter.reset ();
+		CPPUNIT_ASSERT_EQUAL (-200.f, meter.integrated ());
+	}
+
+	void testInterleaved()
+	{
+		LoudnessMeter a;
+		LoudnessMeter b;
+		a.init (rate, 2);
+		b.init (rate, 2);
+
+		/* arbitrary block sizes, not aligned to the 50ms fragments */
+		float const* data[2];
+		for (samplecnt_t s = 0; s < samples; s += 1000) {
+			const samplecnt_t n = std::min<samplecnt_t> (1000, samples - s);
+			data[0] = &left[s];
+			data[1] = &right[s];
+			a.process (data, n);
+			b.process_interleaved (&interleaved[2 * s], n);
+		}
+
+		CPPUNIT_ASSERT_EQUAL (a.integrated (), b.integrated ());
+		CPPUNIT_ASSERT_EQUAL (a.loudness_range (), b.loudness_range ());
+	}
+
+	void testTruePeak()
+	{
+		/* fs/4 sine with 45 degree phase offset: sample peak is -3dB, true peak 0dB */
+		float* data = new float[4800];
+		float sample_peak = 0;
+		for (int i = 0; i < 4800; ++i) {
+			data[i] = sinf (M_PI / 2 * i + M_PI / 4);
+			sample_peak = std::max (sample_peak, fabsf (data[i]));
+		}
+
+		TruePeakMeter meter;
+		meter.process (data, 4800);
+
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (sqrtf (.5f), sample_peak, 1e-3);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (1.0, meter.peak (), 0.02);
+		CPPUNIT_ASSERT_EQUAL (meter.peak (), meter.read ());
+		CPPUNIT_ASSERT_EQUAL (0.f, meter.read ());
+
+		meter.reset ();
+		CPPUNIT_ASSERT_EQUAL (0.f, meter.peak ());
+
+		delete [] data;
+	}
+
+  private:
+	float       rate;
+	samplecnt_t samples;
+	float*      left;
+	float*      right;
+	float*      interleaved;
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION (LoudnessMeterTest);
@@ -2,7 +2,7 @@
 #include <pangomm/init.h>
 #include "pbd/compose.h"
 #include "pbd/xml++.h"
-#include "canvas/group.h"
+#include "canvas/item.h"
 #include "canvas/canvas.h"
 #include "canvas/root_group.h"
 #include "canvas/rectangle.h"
@@ -23,7 +23,7 @@ public:
 
 	void do_run (ImageCanvas& canvas)
 	{
-		Group::default_items_per_cell = _items_per_cell;
+		Item::default_items_per_cell = _items_per_cell;
 
 		for (int i = 0; i < 1e4; i += 50) {
 			canvas.render_to_image (Rect (i, 0, i + 50, 1024));
@@ -45,6 +45,13 @@ int main (int argc, char* argv[])
 
 	RenderParts render_parts (argv[1]);
 
+	/* without a spatial index */
+	Item::grid_lookup_threshold = 0;
+	cout << "none " << render_parts.run () << "\n";
+
+	/* GridLookupTable for all items with children */
+	Item::grid_lookup_threshold = 1;
+
 	int tests[] = { 16, 32, 64, 128, 256, 512, 1024, 1e4, 1e5, 1e6 };
 
 	for (unsigned int i = 0; i < sizeof (tests) / sizeof (int); ++i) {
@@ -3,6 +3,7 @@
 #include "pbd/xml++.h"
 #include "pbd/compose.h"
 #include "canvas/canvas.h"
+#include "canvas/item.h"
 #include "canvas/types.h"
 #include "benchmark.h"
 
@@ -28,12 +29,17 @@ public:
 int main (int argc, char* argv[])
 {
 	if (argc < 2) {
-		cerr << "Syntax: render_whole <session-name> [<number-of-iterations>]\n";
+		cerr << "Syntax: render_whole <session-name> [<number-of-iterations>] [<grid-lookup-threshold>]\n";
 		exit (EXIT_FAILURE);
 	}
 
 	Pango::init ();
 
+	if (argc > 3) {
+		/* 0 renders without a spatial index */
+		Item::grid_lookup_threshold = atoi (argv[3]);
+	}
+
 	RenderWhole render_whole (argv[1]);
 
 	if (argc > 2) {
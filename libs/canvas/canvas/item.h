@@ -223,6 +223,11 @@ public:
 	void lower_child_to_bottom (Item *);
 	virtual void child_changed ();
 
+	/** items with at least this many children index them using a
+	 *  GridLookupTable with default_items_per_cell items per cell.
+	 *  0 disables the index.
+	 */
+	static int grid_lookup_threshold;
 	static int default_items_per_cell;
 
 
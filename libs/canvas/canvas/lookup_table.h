@@ -57,6 +57,49 @@ public:
     bool has_item_at_point (Duple const & point) const;
 };
 
+/** A lookup table that sorts an item's children into a grid of cells,
+ *  so that area and point queries only need to look at the children
+ *  that overlap the cells concerned, rather than at all of them.
+ *
+ *  The table is built from the children's bounding boxes, and like any
+ *  other LookupTable it is dropped by the item whenever one of them changes.
+ *  Children that extend (practically) infinitely are not put into cells
+ *  and always considered.
+ */
+class LIBCANVAS_API GridLookupTable : public LookupTable
+{
+public:
+	GridLookupTable (Item const &, int items_per_cell);
+
+	std::vector<Item*> get (Rect const &);
+	std::vector<Item*> items_at_point (Duple const &) const;
+	bool has_item_at_point (Duple const & point) const;
+
+private:
+	struct Entry {
+		Entry (Item* i, Rect const & r) : item (i), bbox (r) {}
+		Item* item;
+		Rect  bbox; ///< in the coordinates of our item
+	};
+
+	typedef std::vector<uint32_t> Cell;
+
+	Rect window_to_parent (Rect const &) const;
+	void cell_range (Rect const &, int &, int &, int &, int &) const;
+	void candidates (Rect const &, std::vector<uint32_t>&) const;
+
+	std::vector<Entry>    _entries;   ///< in stacking order
+	std::vector<uint32_t> _unbounded; ///< entries that are not in any cell
+	std::vector<Cell>     _cells;
+	int                   _cols;
+	int                   _rows;
+	Rect                  _extent;
+	Duple                 _cell_size;
+
+	mutable std::vector<uint32_t> _visited;
+	mutable uint32_t              _visit;
+};
+
 class LIBCANVAS_API OptimizingLookupTable : public LookupTable
 {
 public:
@@ -0,0 +1,80 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef __CANVAS_NOTE_ARRAY_H__
+#define __CANVAS_NOTE_ARRAY_H__
+
+#include <vector>
+
+#include "canvas/item.h"
+#include "canvas/visibility.h"
+
+namespace ArdourCanvas {
+
+/** A single item that draws many outlined rectangles (MIDI notes).
+ *
+ * Unlike a Container of Rectangles, the notes are not items themselves:
+ * they are kept in one array sorted by start position, so rendering only
+ * visits the notes that intersect the exposed area, and consecutive notes
+ * of the same color are filled and stroked with a single cairo operation.
+ * There is no per-note event handling; note_at() can be used to find the
+ * note at a given position when needed.
+ */
+class LIBCANVAS_API NoteArray : public Item
+{
+public:
+	NoteArray (Canvas*);
+	NoteArray (Item*);
+
+	struct Entry {
+		Entry (Rect const & r, Gtkmm2ext::Color f, Gtkmm2ext::Color o) : rect (r), fill (f), outline (o) {}
+
+		Rect             rect;
+		Gtkmm2ext::Color fill;
+		Gtkmm2ext::Color outline;
+	};
+
+	typedef std::vector<Entry> Entries;
+
+	void compute_bounding_box () const;
+	void render (Rect const & area, Cairo::RefPtr<Cairo::Context>) const;
+
+	bool covers (Duple const &) const;
+
+	/** replace all notes. The given entries are swapped in and sorted,
+	 * @a entries is left with the previous content.
+	 */
+	void set (Entries& entries);
+	void clear ();
+
+	size_t size () const { return _entries.size (); }
+	Entry const & entry (size_t n) const { return _entries[n]; }
+
+	/** @return index of the last drawn (topmost) note that contains
+	 * the given point in item coordinates, or -1.
+	 */
+	int note_at (Duple const &) const;
+
+private:
+	Entries::const_iterator first_at (Coord x) const;
+
+	Entries  _entries;
+	Distance _max_width;
+};
+
+}
+
+#endif /* __CANVAS_NOTE_ARRAY_H__ */
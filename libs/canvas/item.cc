@@ -32,6 +32,7 @@ using namespace std;
 using namespace PBD;
 using namespace ArdourCanvas;
 
+int Item::grid_lookup_threshold = 256;
 int Item::default_items_per_cell = 64;
 
 Item::Item (Canvas* canvas)
@@ -1049,7 +1050,11 @@ void
 Item::ensure_lut () const
 {
 	if (!_lut) {
-		_lut = new DumbLookupTable (*this);
+		if (grid_lookup_threshold > 0 && _items.size() >= (size_t) grid_lookup_threshold) {
+			_lut = new GridLookupTable (*this, default_items_per_cell);
+		} else {
+			_lut = new DumbLookupTable (*this);
+		}
 	}
 }
 
@@ -18,6 +18,9 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
+#include <cmath>
+
 #include "canvas/item.h"
 #include "canvas/lookup_table.h"
 
@@ -104,6 +107,215 @@ DumbLookupTable::has_item_at_point (Duple const & point) const
 	return false;
 }
 
+/* children whose bounding box is larger than this (in either dimension)
+ * are considered unbounded. They would otherwise stretch the grid so that
+ * all other children end up in the same cell.
+ */
+static const Distance unbounded_size = 1e12;
+
+GridLookupTable::GridLookupTable (Item const & item, int items_per_cell)
+	: LookupTable (item)
+	, _cols (1)
+	, _rows (1)
+	, _visit (0)
+{
+	list<Item*> const & items = _item.items ();
+
+	for (list<Item*>::const_iterator i = items.begin(); i != items.end(); ++i) {
+
+		Rect const item_bbox = (*i)->bounding_box ();
+
+		if (!item_bbox) {
+			/* never rendered nor found by DumbLookupTable */
+			continue;
+		}
+
+		Rect const bbox = (*i)->item_to_parent (item_bbox);
+
+		if (bbox.width() > unbounded_size || bbox.height() > unbounded_size) {
+			_unbounded.push_back (_entries.size ());
+		} else {
+			_extent = _extent ? _extent.extend (bbox) : bbox;
+		}
+
+		_entries.push_back (Entry (*i, bbox));
+	}
+
+	_visited.resize (_entries.size (), 0);
+
+	if (!_extent) {
+		return;
+	}
+
+	/* choose the number of rows and columns so that cells are roughly
+	 * square in shape; timelines tend to be a lot wider than high.
+	 */
+
+	double const cells  = max (1.0, (double) (_entries.size () - _unbounded.size ()) / max (1, items_per_cell));
+	double const aspect = _extent.height() > 0 ? _extent.width() / _extent.height() : cells;
+
+	_cols = max (1, min ((int) cells, (int) rint (sqrt (cells * aspect))));
+	_rows = max (1, min ((int) cells, (int) rint (cells / _cols)));
+
+	_cell_size.x = _extent.width() / _cols;
+	_cell_size.y = _extent.height() / _rows;
+
+	_cells.resize (_cols * _rows);
+
+	vector<uint32_t>::const_iterator u = _unbounded.begin ();
+
+	for (uint32_t n = 0; n < _entries.size (); ++n) {
+
+		if (u != _unbounded.end () && *u == n) {
+			++u;
+			continue;
+		}
+
+		int x0, y0, x1, y1;
+		cell_range (_entries[n].bbox, x0, y0, x1, y1);
+
+		for (int y = y0; y <= y1; ++y) {
+			for (int x = x0; x <= x1; ++x) {
+				_cells[y * _cols + x].push_back (n);
+			}
+		}
+	}
+}
+
+/** Compute the (inclusive) range of cells covered by a rect in our item's
+ *  coordinates, clamped to the grid.
+ */
+void
+GridLookupTable::cell_range (Rect const & r, int& x0, int& y0, int& x1, int& y1) const
+{
+	x0 = _cell_size.x > 0 ? (int) floor ((r.x0 - _extent.x0) / _cell_size.x) : 0;
+	x1 = _cell_size.x > 0 ? (int) floor ((r.x1 - _extent.x0) / _cell_size.x) : 0;
+	y0 = _cell_size.y > 0 ? (int) floor ((r.y0 - _extent.y0) / _cell_size.y) : 0;
+	y1 = _cell_size.y > 0 ? (int) floor ((r.y1 - _extent.y0) / _cell_size.y) : 0;
+
+	x0 = max (0, min (_cols - 1, x0));
+	x1 = max (0, min (_cols - 1, x1));
+	y0 = max (0, min (_rows - 1, y0));
+	y1 = max (0, min (_rows - 1, y1));
+}
+
+/** Convert a rect in window coordinates into the coordinates of our item */
+Rect
+GridLookupTable::window_to_parent (Rect const & r) const
+{
+	/* all children share the same scroll parent, so any of them
+	 * can be used to undo the scroll offset.
+	 */
+	Item const * child = _entries.front().item;
+	return child->item_to_parent (child->window_to_item (r));
+}
+
+/** Find the indices of all entries whose bounding box may intersect
+ *  @a area (in our item's coordinates), in stacking order.
+ */
+void
+GridLookupTable::candidates (Rect const & area, vector<uint32_t>& result) const
+{
+	result = _unbounded;
+
+	/* not Rect::intersection(), area may be a single point */
+	if (!_extent || area.x1 < _extent.x0 || area.x0 > _extent.x1 || area.y1 < _extent.y0 || area.y0 > _extent.y1) {
+		return;
+	}
+
+	if (++_visit == 0) {
+		fill (_visited.begin (), _visited.end (), 0);
+		_visit = 1;
+	}
+
+	int x0, y0, x1, y1;
+	cell_range (area, x0, y0, x1, y1);
+
+	for (int y = y0; y <= y1; ++y) {
+		for (int x = x0; x <= x1; ++x) {
+			Cell const & cell (_cells[y * _cols + x]);
+			for (Cell::const_iterator i = cell.begin(); i != cell.end(); ++i) {
+				if (_visited[*i] != _visit) {
+					_visited[*i] = _visit;
+					result.push_back (*i);
+				}
+			}
+		}
+	}
+
+	sort (result.begin (), result.end ());
+}
+
+vector<Item*>
+GridLookupTable::get (Rect const & area)
+{
+	vector<Item*> vitems;
+
+	if (_entries.empty ()) {
+		return vitems;
+	}
+
+	/* allow for rounding in Item::item_to_window() */
+	vector<uint32_t> c;
+	candidates (window_to_parent (area).expand (1.0), c);
+
+	/* same test as DumbLookupTable::get() */
+	for (vector<uint32_t>::const_iterator n = c.begin(); n != c.end(); ++n) {
+		Item* i = _entries[*n].item;
+		Rect const item = i->item_to_window (i->bounding_box ());
+		if (item.intersection (area)) {
+			vitems.push_back (i);
+		}
+	}
+
+	return vitems;
+}
+
+vector<Item*>
+GridLookupTable::items_at_point (Duple const & point) const
+{
+	/* Point is in window coordinate system */
+
+	vector<Item*> vitems;
+
+	if (_entries.empty ()) {
+		return vitems;
+	}
+
+	vector<uint32_t> c;
+	candidates (window_to_parent (Rect (point.x, point.y, point.x, point.y)), c);
+
+	for (vector<uint32_t>::const_iterator n = c.begin(); n != c.end(); ++n) {
+		if (_entries[*n].item->covers (point)) {
+			vitems.push_back (_entries[*n].item);
+		}
+	}
+
+	return vitems;
+}
+
+bool
+GridLookupTable::has_item_at_point (Duple const & point) const
+{
+	/* Point is in window coordinate system */
+
+	if (_entries.empty ()) {
+		return false;
+	}
+
+	vector<uint32_t> c;
+	candidates (window_to_parent (Rect (point.x, point.y, point.x, point.y)), c);
+
+	for (vector<uint32_t>::const_iterator n = c.begin(); n != c.end(); ++n) {
+		Item const * i = _entries[*n].item;
+		if (i->visible() && i->covers (point)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
 OptimizingLookupTable::OptimizingLookupTable (Item const & item, int items_per_cell)
 	: LookupTable (item)
 	, _items_per_cell (items_per_cell)
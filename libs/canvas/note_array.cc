@@ -0,0 +1,227 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include <cairomm/context.h>
+
+#include "canvas/note_array.h"
+
+using namespace std;
+using namespace ArdourCanvas;
+
+class EntrySorter {
+public:
+	bool operator() (NoteArray::Entry const & a, NoteArray::Entry const & b) const {
+		return a.rect.x0 < b.rect.x0;
+	}
+};
+
+class EntryStartsBefore {
+public:
+	bool operator() (NoteArray::Entry const & a, Coord x) const {
+		return a.rect.x0 < x;
+	}
+};
+
+NoteArray::NoteArray (Canvas* c)
+	: Item (c)
+	, _max_width (0)
+{
+
+}
+
+NoteArray::NoteArray (Item* parent)
+	: Item (parent)
+	, _max_width (0)
+{
+
+}
+
+void
+NoteArray::set (Entries& entries)
+{
+	begin_change ();
+
+	_entries.swap (entries);
+
+	/* keep the given order for notes that start at the same position,
+	 * later notes are drawn on top of earlier ones.
+	 */
+	stable_sort (_entries.begin(), _entries.end(), EntrySorter());
+
+	_max_width = 0;
+	for (Entries::const_iterator i = _entries.begin(); i != _entries.end(); ++i) {
+		_max_width = max (_max_width, i->rect.width());
+	}
+
+	_bounding_box_dirty = true;
+	end_change ();
+}
+
+void
+NoteArray::clear ()
+{
+	if (_entries.empty ()) {
+		return;
+	}
+
+	begin_change ();
+	_entries.clear ();
+	_max_width = 0;
+	_bounding_box_dirty = true;
+	end_change ();
+}
+
+void
+NoteArray::compute_bounding_box () const
+{
+	if (_entries.empty ()) {
+		_bounding_box = Rect ();
+	} else {
+		Rect r = _entries.front().rect;
+
+		for (Entries::const_iterator i = _entries.begin(); i != _entries.end(); ++i) {
+			r = r.extend (i->rect);
+		}
+
+		/* see Rectangle::compute_bounding_box(), outlines are 1 pixel */
+		_bounding_box = r.expand (1.5);
+	}
+
+	_bounding_box_dirty = false;
+}
+
+NoteArray::Entries::const_iterator
+NoteArray::first_at (Coord x) const
+{
+	/* entries are sorted by start, and none is wider than _max_width,
+	 * so nothing before this can reach x.
+	 */
+	return lower_bound (_entries.begin(), _entries.end(), x - _max_width, EntryStartsBefore());
+}
+
+int
+NoteArray::note_at (Duple const & p) const
+{
+	int rv = -1;
+
+	for (Entries::const_iterator i = first_at (p.x); i != _entries.end() && i->rect.x0 <= p.x; ++i) {
+		if (i->rect.contains (p)) {
+			rv = i - _entries.begin();
+		}
+	}
+
+	return rv;
+}
+
+bool
+NoteArray::covers (Duple const & point) const
+{
+	return note_at (window_to_item (point)) >= 0;
+}
+
+static inline Rect
+rounded (Rect const & r, Duple const & offset)
+{
+	/* equivalent to Item::item_to_window (r, true) */
+	return Rect (round (r.x0 + offset.x), round (r.y0 + offset.y),
+	             round (r.x1 + offset.x), round (r.y1 + offset.y));
+}
+
+void
+NoteArray::render (Rect const & area, Cairo::RefPtr<Cairo::Context> context) const
+{
+	if (_entries.empty ()) {
+		return;
+	}
+
+	/* area is in window coordinates, find the notes that it covers.
+	 * Outlines extend up to one pixel beyond the note's rect.
+	 */
+
+	const Rect   visible = window_to_item (area).expand (1.0);
+	const Duple  offset  = item_to_window (Duple (0, 0), false);
+
+	const Entries::const_iterator first = first_at (visible.x0);
+	Entries::const_iterator       i;
+
+	Gtkmm2ext::Color color = 0;
+	bool             pending = false;
+
+	/* fills, one path per run of notes with the same color */
+
+	for (i = first; i != _entries.end() && i->rect.x0 <= visible.x1; ++i) {
+
+		if (i->rect.x1 < visible.x0 || i->rect.y1 < visible.y0 || i->rect.y0 > visible.y1) {
+			continue;
+		}
+
+		const Rect draw = rounded (i->rect, offset).intersection (area);
+
+		if (!draw) {
+			continue;
+		}
+
+		if (pending && i->fill != color) {
+			context->fill ();
+			pending = false;
+		}
+
+		if (!pending) {
+			Gtkmm2ext::set_source_rgba (context, i->fill);
+			color = i->fill;
+			pending = true;
+		}
+
+		context->rectangle (draw.x0, draw.y0, draw.width(), draw.height());
+	}
+
+	if (pending) {
+		context->fill ();
+		pending = false;
+	}
+
+	/* outlines, aligned to pixel centers as in Rectangle::render() */
+
+	context->set_line_width (1.0);
+
+	for (i = first; i != _entries.end() && i->rect.x0 <= visible.x1; ++i) {
+
+		if (i->rect.x1 < visible.x0 || i->rect.y1 < visible.y0 || i->rect.y0 > visible.y1) {
+			continue;
+		}
+
+		if (pending && i->outline != color) {
+			context->stroke ();
+			pending = false;
+		}
+
+		if (!pending) {
+			Gtkmm2ext::set_source_rgba (context, i->outline);
+			color = i->outline;
+			pending = true;
+		}
+
+		const Rect self = rounded (i->rect, offset);
+		context->rectangle (self.x0 + 0.5, self.y0 + 0.5, self.width(), self.height());
+	}
+
+	if (pending) {
+		context->stroke ();
+	}
+}
@@ -35,6 +35,7 @@
 
 #define GUARD_POINT_DELTA 64
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <iostream>
@@ -65,6 +66,9 @@ ControlList::ControlList (const Parameter& id, const ParameterDescriptor& desc)
 	, _desc(desc)
 	, _interpolation (default_interpolation ())
 	, _curve(0)
+	, _rt_events (new RTEvents)
+	, _rt_events_pending (false)
+	, _modification_count (0)
 {
 	_frozen = 0;
 	_changed_when_thawed = false;
@@ -86,6 +90,9 @@ ControlList::ControlList (const ControlList& other)
 	, _desc(other._desc)
 	, _interpolation(other._interpolation)
 	, _curve(0)
+	, _rt_events (new RTEvents)
+	, _rt_events_pending (false)
+	, _modification_count (0)
 {
 	_frozen = 0;
 	_changed_when_thawed = false;
@@ -108,6 +115,9 @@ ControlList::ControlList (const ControlList& other, double start, double end)
 	, _desc(other._desc)
 	, _interpolation(other._interpolation)
 	, _curve(0)
+	, _rt_events (new RTEvents)
+	, _rt_events_pending (false)
+	, _modification_count (0)
 {
 	_frozen = 0;
 	_changed_when_thawed = false;
@@ -482,6 +492,7 @@ ControlList::start_write_pass (double when)
 	if (_in_write_pass && !new_write_pass) {
 #if 1
 		add_guard_point (when, 0); // also sets most_recent_insert_iterator
+		mark_dirty ();
 #else
 		const ControlEvent cp (when, 0.0);
 		most_recent_insert_iterator = lower_bound (_events.begin(), _events.end(), &cp, time_comparator);
@@ -512,6 +523,7 @@ ControlList::set_in_write_pass (bool yn, bool add_point, double when)
 	if (yn && add_point) {
 		Glib::Threads::RWLock::WriterLock lm (_lock);
 		add_guard_point (when, 0);
+		mark_dirty ();
 	}
 }
 
@@ -1132,6 +1144,12 @@ ControlList::thaw ()
 			unlocked_remove_duplicates ();
 			unlocked_invalidate_insert_iterator ();
 			_sort_pending = false;
+			_rt_events_pending = true;
+			++_modification_count;
+		}
+
+		if (_rt_events_pending) {
+			publish_rt_events ();
 		}
 	}
 	maybe_signal_changed ();
@@ -1140,6 +1158,8 @@ ControlList::thaw ()
 void
 ControlList::mark_dirty () const
 {
+	++_modification_count;
+
 	_lookup_cache.left = -1;
 	_lookup_cache.range.first = _events.end();
 	_lookup_cache.range.second = _events.end();
@@ -1149,6 +1169,291 @@ ControlList::mark_dirty () const
 	if (_curve) {
 		_curve->mark_dirty();
 	}
+
+	if (_frozen) {
+		_rt_events_pending = true;
+	} else {
+		publish_rt_events ();
+	}
+}
+
+void
+ControlList::publish_rt_events () const
+{
+	_rt_events_pending = false;
+
+	if (_curve && _interpolation == Curved) {
+		_curve->solve ();
+	}
+
+	RCUWriter<RTEvents>         writer (_rt_events);
+	boost::shared_ptr<RTEvents> rt = writer.get_copy ();
+
+	const size_t n = _events.size ();
+
+	rt->when.resize (n);
+	rt->value.resize (n);
+	rt->coeff.clear ();
+
+	bool have_coeff = _interpolation == Curved && n > 2;
+
+	size_t k = 0;
+	for (const_iterator i = _events.begin (); i != _events.end (); ++i, ++k) {
+		rt->when[k]  = (*i)->when;
+		rt->value[k] = (*i)->value;
+		/* Curve::solve() does not store coefficients for the first point */
+		if (k > 0 && !(*i)->coeff) {
+			have_coeff = false;
+		}
+	}
+
+	if (have_coeff) {
+		rt->coeff.resize (4 * n, 0.0);
+		k = 0;
+		for (const_iterator i = _events.begin (); i != _events.end (); ++i, ++k) {
+			if ((*i)->coeff) {
+				for (size_t c = 0; c < 4; ++c) {
+					rt->coeff[4 * k + c] = (*i)->coeff[c];
+				}
+			}
+		}
+	}
+}
+
+size_t
+ControlList::RTEvents::segment (double x) const
+{
+	return std::lower_bound (when.begin (), when.end (), x) - when.begin ();
+}
+
+double
+ControlList::RTEvents::eval (double x, InterpolationStyle style, ParameterDescriptor const& desc) const
+{
+	const size_t n = size ();
+
+	if (n == 0) {
+		return desc.normal;
+	}
+
+	if (n == 1 || x <= when.front ()) {
+		return value.front ();
+	}
+
+	if (x >= when.back ()) {
+		return value.back ();
+	}
+
+	/* when[i - 1] < x <= when[i] */
+	const size_t i = segment (x);
+	assert (i > 0 && i < n);
+
+	if (when[i] == x) {
+		return value[i];
+	}
+
+	const double lval     = value[i - 1];
+	const double uval     = value[i];
+	const double fraction = (x - when[i - 1]) / (when[i] - when[i - 1]);
+
+	switch (style) {
+		case Discrete:
+			return lval;
+		case Logarithmic:
+			return interpolate_logarithmic (lval, uval, fraction, desc.lower, desc.upper);
+		case Exponential:
+			return interpolate_gain (lval, uval, fraction, desc.upper);
+		case Curved:
+			/* only used x-fade curves, never direct eval */
+			/* fallthrough */
+		default: // Linear
+			return interpolate_linear (lval, uval, fraction);
+	}
+}
+
+void
+ControlList::RTEvents::get_vector (double x0, double x1, float* vec, int32_t veclen, InterpolationStyle style, ParameterDescriptor const& desc) const
+{
+	if (veclen <= 0) {
+		return;
+	}
+
+	const int32_t npoints = size ();
+
+	if (npoints == 0) {
+		std::fill (vec, vec + veclen, (float) desc.normal);
+		return;
+	}
+
+	if (npoints == 1) {
+		std::fill (vec, vec + veclen, (float) value.front ());
+		return;
+	}
+
+	const double max_x = when.back ();
+	const double min_x = when.front ();
+
+	if (x0 > max_x) {
+		std::fill (vec, vec + veclen, (float) value.back ());
+		return;
+	}
+
+	if (x1 < min_x) {
+		std::fill (vec, vec + veclen, (float) value.front ());
+		return;
+	}
+
+	/* same partitioning as Curve::_get_vector () */
+	const int32_t original_veclen = veclen;
+
+	if (x0 < min_x) {
+		double  frac     = (min_x - x0) / (x1 - x0);
+		int64_t fill_len = min ((int64_t) floor (veclen * frac), (int64_t) veclen);
+
+		std::fill (vec, vec + fill_len, (float) value.front ());
+
+		veclen -= fill_len;
+		vec += fill_len;
+	}
+
+	if (veclen && x1 > max_x) {
+		double  frac     = (x1 - max_x) / (x1 - x0);
+		int64_t fill_len = min ((int64_t) floor (original_veclen * frac), (int64_t) veclen);
+
+		std::fill (vec + veclen - fill_len, vec + veclen, (float) value.back ());
+
+		veclen -= fill_len;
+	}
+
+	if (veclen == 0) {
+		return;
+	}
+
+	const double lx = max (min_x, x0);
+	const double hx = min (max_x, x1);
+
+	if (npoints == 2) {
+		const double lpos = when.front ();
+		const double lval = value.front ();
+		const double upos = when.back ();
+		const double uval = value.back ();
+
+		if (veclen == 1) {
+			const double fraction = (lx - lpos) / (upos - lpos);
+			switch (style) {
+				case Logarithmic:
+					vec[0] = interpolate_logarithmic (lval, uval, fraction, desc.lower, desc.upper);
+					break;
+				case Exponential:
+					vec[0] = interpolate_gain (lval, uval, fraction, desc.upper);
+					break;
+				case Discrete:
+					vec[0] = lval;
+					break;
+				default:
+					vec[0] = interpolate_linear (lval, uval, fraction);
+					break;
+			}
+			return;
+		}
+
+		const double dx_num = hx - lx;
+		const double dx_den = veclen - 1;
+		const double m_num  = uval - lval;
+		const double m_den  = upos - lpos;
+		const double c      = uval - (m_num * upos / m_den);
+
+		switch (style) {
+			case Logarithmic:
+				for (int32_t i = 0; i < veclen; ++i) {
+					const double fraction = (lx - lpos + i * dx_num / dx_den) / m_den;
+					vec[i] = interpolate_logarithmic (lval, uval, fraction, desc.lower, desc.upper);
+				}
+				break;
+			case Exponential:
+				for (int32_t i = 0; i < veclen; ++i) {
+					const double fraction = (lx - lpos + i * dx_num / dx_den) / m_den;
+					vec[i] = interpolate_gain (lval, uval, fraction, desc.upper);
+				}
+				break;
+			case Discrete:
+				std::fill (vec, vec + veclen, (float) lval);
+				break;
+			default: // Linear, Curved
+				for (int32_t i = 0; i < veclen; ++i) {
+					vec[i] = (lx * (m_num / m_den) + m_num * i * dx_num / (m_den * dx_den)) + c;
+				}
+				break;
+		}
+		return;
+	}
+
+	/* Positions increase monotonically: rather than searching for every
+	 * sample, walk the segments and fill all samples falling into each
+	 * segment in one go.
+	 */
+	const double dx = veclen > 1 ? (hx - lx) / (veclen - 1) : 0;
+
+	size_t  k = std::upper_bound (when.begin (), when.end (), lx) - when.begin ();
+	int32_t i = 0;
+
+	while (i < veclen) {
+
+		if (k >= (size_t) npoints) {
+			std::fill (vec + i, vec + veclen, (float) value.back ());
+			break;
+		}
+
+		/* samples [i, end) are located before when[k] */
+		int32_t end = veclen;
+		if (dx > 0) {
+			const double e = ceil ((when[k] - lx) / dx);
+			if (e < veclen) {
+				end = max<int32_t> (i, e);
+			}
+		}
+
+		const double lpos   = when[k - 1];
+		const double lval   = value[k - 1];
+		const double uval   = value[k];
+		const double trange = when[k] - lpos;
+
+		if (lval == uval || style == Discrete) {
+			std::fill (vec + i, vec + end, (float) lval);
+		} else {
+			switch (style) {
+				case Logarithmic:
+					for (; i < end; ++i) {
+						vec[i] = interpolate_logarithmic (lval, uval, (lx + i * dx - lpos) / trange, desc.lower, desc.upper);
+					}
+					break;
+				case Exponential:
+					for (; i < end; ++i) {
+						vec[i] = interpolate_gain (lval, uval, (lx + i * dx - lpos) / trange, desc.upper);
+					}
+					break;
+				case Curved:
+					if (!coeff.empty ()) {
+						const double* c = &coeff[4 * k];
+						for (; i < end; ++i) {
+							const double x = lx + i * dx;
+							vec[i] = x == lpos ? lval : c[0] + x * (c[1] + x * (c[2] + x * c[3]));
+						}
+						break;
+					}
+					/* fallthrough */
+				default: { // Linear
+					const double m = (uval - lval) / trange;
+					for (; i < end; ++i) {
+						vec[i] = lval + m * (lx + i * dx - lpos);
+					}
+					break;
+				}
+			}
+		}
+
+		i = end;
+		++k;
+	}
 }
 
 void
@@ -1988,6 +2293,13 @@ ControlList::set_interpolation (InterpolationStyle s)
 	}
 
 	_interpolation = s;
+
+	{
+		Glib::Threads::RWLock::WriterLock lm (_lock);
+		/* spline coefficients are only included for Curved */
+		publish_rt_events ();
+	}
+
 	InterpolationChanged (s); /* EMIT SIGNAL */
 	return true;
 }
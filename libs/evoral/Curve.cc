@@ -176,14 +176,9 @@ Curve::solve () const
 bool
 Curve::rt_safe_get_vector (double x0, double x1, float *vec, int32_t veclen) const
 {
-	Glib::Threads::RWLock::ReaderLock lm(_list.lock(), Glib::Threads::TRY_LOCK);
-
-	if (!lm.locked()) {
-		return false;
-	} else {
-		_get_vector (x0, x1, vec, veclen);
-		return true;
-	}
+	/* evaluate the RCU published snapshot, this never blocks */
+	_list.rt_events ()->get_vector (x0, x1, vec, veclen, _list.interpolation (), _list.descriptor ());
+	return true;
 }
 
 void
@@ -28,6 +28,8 @@
 #include <stdint.h>
 #include <cstdio>
 
+#include <boost/make_shared.hpp>
+
 #if __clang__
 #include "evoral/Note.h"
 #endif
@@ -71,6 +73,7 @@ Sequence<Time>::const_iterator::const_iterator()
 	, _active_patch_change_message (NO_EVENT)
 	, _type(NIL)
 	, _is_end(true)
+	, _note_pos(0)
 	, _control_iter(_control_iters.end())
 	, _force_discrete(false)
 {
@@ -87,7 +90,7 @@ Sequence<Time>::const_iterator::const_iterator(const Sequence<Time>&
 	, _active_patch_change_message (0)
 	, _type(NIL)
 	, _is_end((t == DBL_MAX) || seq.empty())
-	, _note_iter(seq.notes().end())
+	, _note_pos(0)
 	, _sysex_iter(seq.sysexes().end())
 	, _patch_change_iter(seq.patch_changes().end())
 	, _control_iter(_control_iters.end())
@@ -113,7 +116,8 @@ Sequence<Time>::const_iterator::const_iterator(const Sequence<Time>&
 	}
 
 	// Find first note which begins at or after t
-	_note_iter = seq.note_lower_bound(t);
+	_note_index = seq.note_index();
+	_note_pos   = _note_index->lower_bound(t);
 
 	// Find first sysex event at or after t
 	for (typename Sequence<Time>::SysExes::const_iterator i = seq.sysexes().begin();
@@ -225,8 +229,9 @@ Sequence<Time>::const_iterator::invalidate(std::set< boost::weak_ptr< Note<Time>
 	}
 	_type = NIL;
 	_is_end = true;
+	_note_index.reset();
+	_note_pos = 0;
 	if (_seq) {
-		_note_iter = _seq->notes().end();
 		_sysex_iter = _seq->sysexes().end();
 		_patch_change_iter = _seq->patch_changes().end();
 		_active_patch_change_message = 0;
@@ -243,9 +248,9 @@ Sequence<Time>::const_iterator::choose_next(Time earliest_t)
 	_type = NIL;
 
 	// Next earliest note on, if any
-	if (_note_iter != _seq->notes().end()) {
+	if (_note_index && _note_pos < _note_index->size()) {
 		_type      = NOTE_ON;
-		earliest_t = (*_note_iter)->time();
+		earliest_t = _note_index->time(_note_pos);
 	}
 
 	/* Use the next earliest patch change iff it is earlier or coincident with the note-on.
@@ -293,8 +298,8 @@ Sequence<Time>::const_iterator::set_event()
 	switch (_type) {
 	case NOTE_ON:
 		DEBUG_TRACE(DEBUG::Sequence, "iterator = note on\n");
-		_event->assign ((*_note_iter)->on_event());
-		_active_notes.push(*_note_iter);
+		_event->assign (_note_index->note(_note_pos)->on_event());
+		_active_notes.push(_note_index->note(_note_pos));
 		break;
 	case NOTE_OFF:
 		DEBUG_TRACE(DEBUG::Sequence, "iterator = note off\n");
@@ -358,7 +363,7 @@ Sequence<Time>::const_iterator::operator++()
 	// Increment past current event
 	switch (_type) {
 	case NOTE_ON:
-		++_note_iter;
+		++_note_pos;
 		break;
 	case NOTE_OFF:
 		_active_notes.pop();
@@ -440,7 +445,8 @@ Sequence<Time>::const_iterator::operator=(const const_iterator& other)
 	_active_notes  = other._active_notes;
 	_type          = other._type;
 	_is_end        = other._is_end;
-	_note_iter     = other._note_iter;
+	_note_index    = other._note_index;
+	_note_pos      = other._note_pos;
 	_sysex_iter    = other._sysex_iter;
 	_patch_change_iter = other._patch_change_iter;
 	_control_iters = other._control_iters;
@@ -500,8 +506,8 @@ Sequence<Time>::Sequence(const Sequence<Time>& other)
 	, _highest_note(other._highest_note)
 {
 	for (typename Notes::const_iterator i = other._notes.begin(); i != other._notes.end(); ++i) {
-		NotePtr n (new Note<Time> (**i));
-		_notes.insert (n);
+		NotePtr n (boost::make_shared<Note<Time> > (**i));
+		_notes.insert (_notes.end(), n);
 	}
 
 	for (typename SysExes::const_iterator i = other._sysexes.begin(); i != other._sysexes.end(); ++i) {
@@ -619,6 +625,7 @@ Sequence<Time>::clear()
 {
 	WriteLock lock(write_lock());
 	_notes.clear();
+	invalidate_note_index ();
 	for (Controls::iterator li = _controls.begin(); li != _controls.end(); ++li)
 		li->second->list()->clear();
 }
@@ -692,6 +699,7 @@ Sequence<Time>::end_write (StuckNoteOption option, Time when)
 		_write_notes[i].clear();
 	}
 
+	invalidate_note_index ();
 	_writing = false;
 }
 
@@ -719,8 +727,12 @@ Sequence<Time>::add_note_unlocked(const NotePtr note, void* arg)
 	if (note->note() > _highest_note)
 		_highest_note = note->note();
 
-	_notes.insert (note);
+	/* notes are usually appended in time order (e.g. when loading a file),
+	 * in which case hinting at the end makes this amortized constant time.
+	 */
+	_notes.insert (_notes.end(), note);
 	_pitches[note->channel()].insert (note);
+	invalidate_note_index ();
 
 	_edited = true;
 
@@ -814,6 +826,8 @@ Sequence<Time>::remove_note_unlocked(const constNotePtr note)
 
 	if (erased) {
 
+		invalidate_note_index ();
+
 		Pitches& p (pitches (note->channel()));
 
 		typename Pitches::iterator j;
@@ -1000,7 +1014,8 @@ Sequence<Time>::append_note_on_unlocked (const Event<Time>& ev, event_id_t evid)
 	/* nascent (incoming notes without a note-off ...yet) have a duration
 	   that extends to Beats::max()
 	*/
-	NotePtr note(new Note<Time>(ev.channel(), ev.time(), std::numeric_limits<Temporal::Beats>::max() - ev.time(), ev.note(), ev.velocity()));
+	/* note and reference count in a single allocation */
+	NotePtr note (boost::make_shared<Note<Time> > (ev.channel(), ev.time(), std::numeric_limits<Temporal::Beats>::max() - ev.time(), ev.note(), ev.velocity()));
 	assert (note->end_time() == std::numeric_limits<Temporal::Beats>::max());
 	note->set_id (evid);
 
@@ -1008,7 +1023,7 @@ Sequence<Time>::append_note_on_unlocked (const Event<Time>& ev, event_id_t evid)
 
 	DEBUG_TRACE (DEBUG::Sequence, string_compose ("Appending active note on %1 channel %2\n",
 	                                              (unsigned)(uint8_t)note->note(), note->channel()));
-	_write_notes[note->channel()].insert (note);
+	_write_notes[note->channel()].insert (_write_notes[note->channel()].end(), note);
 
 }
 
@@ -1200,6 +1215,82 @@ void
 Sequence<Time>::set_notes (const typename Sequence<Time>::Notes& n)
 {
 	_notes = n;
+	invalidate_note_index ();
+}
+
+// Note index
+
+template<typename Time>
+Sequence<Time>::NoteIndex::NoteIndex (const Notes& notes)
+{
+	_time.reserve (notes.size());
+	_note.reserve (notes.size());
+
+	for (typename Notes::const_iterator i = notes.begin(); i != notes.end(); ++i) {
+		_time.push_back ((*i)->time());
+		_note.push_back (*i);
+	}
+}
+
+template<typename Time>
+size_t
+Sequence<Time>::NoteIndex::lower_bound (Time t) const
+{
+	return std::lower_bound (_time.begin(), _time.end(), t) - _time.begin();
+}
+
+template<typename Time>
+size_t
+Sequence<Time>::NoteIndex::upper_bound (Time t) const
+{
+	return std::upper_bound (_time.begin(), _time.end(), t) - _time.begin();
+}
+
+template<typename Time>
+typename Sequence<Time>::NotePtr
+Sequence<Time>::NoteIndex::find (event_id_t id) const
+{
+	Glib::Threads::Mutex::Lock lm (_by_id_lock);
+
+	if (_by_id.empty () && !_note.empty ()) {
+		/* ID lookups are rare (loading undo history), but then there
+		 * is one per change, so sort once on first use.
+		 */
+		_by_id.reserve (_note.size ());
+		for (size_t n = 0; n < _note.size (); ++n) {
+			_by_id.push_back (IDPosition (_note[n]->id (), n));
+		}
+		std::sort (_by_id.begin (), _by_id.end ());
+	}
+
+	typename std::vector<IDPosition>::const_iterator i = std::lower_bound (_by_id.begin(), _by_id.end(), IDPosition (id, 0));
+	if (i == _by_id.end() || i->first != id) {
+		return NotePtr();
+	}
+	return _note[i->second];
+}
+
+template<typename Time>
+typename Sequence<Time>::NoteIndexPtr
+Sequence<Time>::note_index () const
+{
+	/* concurrent readers may get here at the same time */
+	Glib::Threads::Mutex::Lock lm (_note_index_lock);
+	if (!_note_index) {
+		_note_index.reset (new NoteIndex (_notes));
+	}
+	return _note_index;
+}
+
+/** Called whenever notes are added or removed, with the write lock held.
+ * Readers which still use the previous index keep it alive.
+ */
+template<typename Time>
+void
+Sequence<Time>::invalidate_note_index ()
+{
+	Glib::Threads::Mutex::Lock lm (_note_index_lock);
+	_note_index.reset ();
 }
 
 // CONST iterator implementations (x3)
@@ -25,6 +25,7 @@
 
 #include <cassert>
 #include <list>
+#include <vector>
 #include <stdint.h>
 
 #include <boost/pool/pool.hpp>
@@ -32,6 +33,7 @@
 
 #include <glibmm/threads.h>
 
+#include "pbd/rcu.h"
 #include "pbd/signals.h"
 
 #include "evoral/visibility.h"
@@ -247,22 +249,17 @@ public:
 		return unlocked_eval (where);
 	}
 
-	/** Realtime safe version of eval(). This may fail if a read-lock cannot
-	 * be taken.
+	/** Realtime safe version of eval(). This evaluates the most recently
+	 * published snapshot of the events (see rt_events()), and never blocks
+	 * or fails, even while the list is being modified.
 	 *
 	 * @param where absolute time in samples
-	 * @param ok boolean reference if returned value is valid
+	 * @param ok boolean reference if returned value is valid (always true)
 	 * @returns parameter value
 	 */
 	double rt_safe_eval (double where, bool& ok) const {
-
-		Glib::Threads::RWLock::ReaderLock lm (_lock, Glib::Threads::TRY_LOCK);
-
-		if ((ok = lm.locked())) {
-			return unlocked_eval (where);
-		} else {
-			return 0.0;
-		}
+		ok = true;
+		return _rt_events.reader ()->eval (where, _interpolation, _desc);
 	}
 
 	static inline bool time_comparator (const ControlEvent* a, const ControlEvent* b) {
@@ -309,6 +306,12 @@ public:
 
 	void mark_dirty () const;
 
+	/** @return a counter that changes whenever the events are modified,
+	 * i.e. on every mark_dirty() and when thaw() applies a pending sort.
+	 * Call with _lock held.
+	 */
+	uint32_t modification_count () const { return _modification_count; }
+
 	enum InterpolationStyle {
 		Discrete,
 		Linear,
@@ -325,6 +328,34 @@ public:
 	/** query default interpolation for parameter-descriptor */
 	virtual InterpolationStyle default_interpolation() const;
 
+	/** Immutable copy of the event-list for realtime readers.
+	 *
+	 * A new instance is published via RCU whenever the list is modified
+	 * (or when it is thawed), so realtime threads can evaluate the list
+	 * without taking _lock and without using the shared lookup caches.
+	 */
+	struct LIBEVORAL_API RTEvents {
+		std::vector<double> when;
+		std::vector<double> value;
+		std::vector<double> coeff; ///< 4 spline coefficients per event, empty unless Curved
+
+		size_t size () const { return when.size (); }
+
+		/** evaluate at the given position, see ControlList::unlocked_eval() */
+		double eval (double x, InterpolationStyle, ParameterDescriptor const&) const;
+
+		/** fill \p vec with \p veclen values evenly spaced in [x0, x1],
+		 * see Curve::get_vector()
+		 */
+		void get_vector (double x0, double x1, float* vec, int32_t veclen, InterpolationStyle, ParameterDescriptor const&) const;
+
+	private:
+		size_t segment (double x) const;
+	};
+
+	/** @return the most recent snapshot of the events for use in realtime context */
+	boost::shared_ptr<RTEvents> rt_events () const { return _rt_events.reader (); }
+
 	/** Sets the interpolation style of the automation data.
 	 *
 	 * This will fail when asking for Logarithmic scale and min,max crosses 0
@@ -388,6 +419,14 @@ protected:
 
 	Curve* _curve;
 
+	/** publish a snapshot of the events for realtime readers,
+	 * called with _lock held. */
+	void publish_rt_events () const;
+
+	mutable SerializedRCUManager<RTEvents> _rt_events;
+	mutable bool                           _rt_events_pending;
+	mutable uint32_t                       _modification_count;
+
 private:
 	iterator   most_recent_insert_iterator;
 	double     insert_position;
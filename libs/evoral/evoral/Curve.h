@@ -33,6 +33,7 @@ class LIBEVORAL_API Curve : public boost::noncopyable
 public:
 	Curve (const ControlList& cl);
 
+	/** realtime safe, lock-free version of get_vector(), never fails */
 	bool rt_safe_get_vector (double x0, double x1, float *arg, int32_t veclen) const;
 	void get_vector (double x0, double x1, float *arg, int32_t veclen) const;
 
@@ -159,6 +159,49 @@ public:
 	inline       Notes& notes()       { return _notes; }
 	inline const Notes& notes() const { return _notes; }
 
+	/** A contiguous, time-sorted snapshot of the notes, for readers.
+	 *
+	 * This is an index on top of notes(), which remains the store that is
+	 * edited: it costs memory in addition to the Notes multiset.
+	 * Start times are stored in an array of their own, so that searching
+	 * and walking the notes in time order does not need to chase a pointer
+	 * per note. A snapshot is immutable, the Sequence drops its reference
+	 * when notes are added or removed and creates a new one on demand.
+	 */
+	class LIBEVORAL_API NoteIndex {
+	public:
+		NoteIndex (const Notes&);
+
+		size_t         size ()         const { return _time.size(); }
+		Time           time (size_t n) const { return _time[n]; }
+		const NotePtr& note (size_t n) const { return _note[n]; }
+
+		/** @return position of the first note starting at or after \p t */
+		size_t lower_bound (Time t) const;
+		/** @return position of the first note starting after \p t */
+		size_t upper_bound (Time t) const;
+
+		/** @return the note with the given ID, or an empty pointer */
+		NotePtr find (event_id_t) const;
+
+	private:
+		typedef std::pair<event_id_t, size_t> IDPosition;
+
+		std::vector<Time>    _time;
+		std::vector<NotePtr> _note;
+
+		/* sorted by ID, only built when find() is used */
+		mutable Glib::Threads::Mutex    _by_id_lock;
+		mutable std::vector<IDPosition> _by_id;
+	};
+
+	typedef boost::shared_ptr<const NoteIndex> NoteIndexPtr;
+
+	/** @return an index of the current notes. The caller must hold a read
+	 * or write lock, the index remains valid after the lock is released.
+	 */
+	NoteIndexPtr note_index () const;
+
 	enum NoteOperator {
 		PitchEqual,
 		PitchLessThan,
@@ -265,7 +308,8 @@ public:
 		MIDIMessageType                       _type;
 		bool                                  _is_end;
 		typename Sequence::ReadLock           _lock;
-		typename Notes::const_iterator        _note_iter;
+		NoteIndexPtr                          _note_index;
+		size_t                                _note_pos;
 		typename SysExes::const_iterator      _sysex_iter;
 		typename PatchChanges::const_iterator _patch_change_iter;
 		ControlIterators                      _control_iters;
@@ -364,6 +408,11 @@ private:
 	 */
 	int _bank[16];
 
+	void invalidate_note_index ();
+
+	mutable Glib::Threads::Mutex _note_index_lock;
+	mutable NoteIndexPtr         _note_index;
+
 	const   const_iterator _end_iter;
 	bool                   _percussive;
 
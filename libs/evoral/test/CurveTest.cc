@@ -75,8 +75,11 @@ CurveTest::rtGet ()
 		// Write-lock list
 		Glib::Threads::RWLock::WriterLock lm(cl->lock());
 
-		// Attempt to get vector in RT (expect failure)
-		CPPUNIT_ASSERT (!cl->curve().rt_safe_get_vector (1024.0, 2047.0, vec, 1024));
+		// Attempt to get vector in RT (expect success, the RT snapshot is lock-free)
+		CPPUNIT_ASSERT (cl->curve().rt_safe_get_vector (1024.0, 2047.0, vec, 1024));
+		for (int i = 0; i < 1024; ++i) {
+			CPPUNIT_ASSERT_EQUAL (42.0f, vec[i]);
+		}
 	}
 
 	// Attempt to get vector in RT (expect success)
@@ -474,3 +477,89 @@ CurveTest::constrainedCubic ()
 		CPPUNIT_ASSERT_DOUBLES_EQUAL(v, g[x], 0.000008);
 	}
 }
+
+void
+CurveTest::rtEval ()
+{
+	float vec[1024];
+	float rtv[1024];
+
+	boost::shared_ptr<Evoral::ControlList> cl = TestCtrlList();
+	cl->create_curve ();
+
+	cl->fast_simple_add (   0.0 , 0.5);
+	cl->fast_simple_add ( 100.0 , 1.0);
+	cl->fast_simple_add ( 150.0 , 0.0);
+	cl->fast_simple_add ( 400.0 , 0.25);
+	cl->fast_simple_add ( 900.0 , 0.75);
+
+	const ControlList::InterpolationStyle styles[] = { ControlList::Discrete, ControlList::Linear, ControlList::Exponential, ControlList::Curved };
+
+	for (size_t s = 0; s < sizeof (styles) / sizeof (styles[0]); ++s) {
+		cl->set_interpolation (styles[s]);
+
+		if (styles[s] != ControlList::Curved) {
+			for (double x = -10; x < 1000; x += 12.5) {
+				bool ok = false;
+				double v = cl->rt_safe_eval (x, ok);
+				CPPUNIT_ASSERT (ok);
+				CPPUNIT_ASSERT_DOUBLES_EQUAL (cl->eval (x), v, 1e-9);
+			}
+		}
+
+		if (styles[s] == ControlList::Discrete) {
+			/* steps are sensitive to rounding of the sample position */
+			continue;
+		}
+
+		const double ranges[][2] = { { -100, 1100 }, { 0, 1023 }, { 90, 160 }, { 100, 100 }, { 500, 2000 } };
+		for (size_t r = 0; r < sizeof (ranges) / sizeof (ranges[0]); ++r) {
+			for (int32_t n = 1; n <= 1024; n *= 4) {
+				cl->curve ().get_vector (ranges[r][0], ranges[r][1], vec, n);
+				CPPUNIT_ASSERT (cl->curve ().rt_safe_get_vector (ranges[r][0], ranges[r][1], rtv, n));
+				for (int32_t i = 0; i < n; ++i) {
+					CPPUNIT_ASSERT_DOUBLES_EQUAL (vec[i], rtv[i], 1e-5);
+				}
+			}
+		}
+	}
+
+	/* modifications are visible to realtime readers, even while the list is locked */
+	bool ok;
+	cl->set_interpolation (ControlList::Linear);
+	cl->add (50, 0.0, false, false);
+	{
+		Glib::Threads::RWLock::WriterLock lm (cl->lock());
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (0.0, cl->rt_safe_eval (50, ok), 1e-9);
+		CPPUNIT_ASSERT (ok);
+	}
+}
+
+void
+CurveTest::rtWritePass ()
+{
+	boost::shared_ptr<Evoral::ControlList> cl = TestCtrlList();
+	cl->set_interpolation (ControlList::Linear);
+
+	cl->fast_simple_add (  0.0 , 0.0);
+	cl->fast_simple_add (100.0 , 1.0);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 2, cl->rt_events ()->size ());
+
+	/* guard points added when a write pass starts are visible to realtime readers */
+	cl->set_in_write_pass (true, true, 50.0);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 3, cl->events ().size ());
+	CPPUNIT_ASSERT_EQUAL ((size_t) 3, cl->rt_events ()->size ());
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (50.0, cl->rt_events ()->when[1], 1e-9);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (0.5, cl->rt_events ()->value[1], 1e-9);
+
+	cl->start_write_pass (75.0);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 4, cl->events ().size ());
+	CPPUNIT_ASSERT_EQUAL ((size_t) 4, cl->rt_events ()->size ());
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (75.0, cl->rt_events ()->when[2], 1e-9);
+
+	bool ok = false;
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (0.75, cl->rt_safe_eval (75.0, ok), 1e-9);
+	CPPUNIT_ASSERT (ok);
+
+	cl->write_pass_finished (100.0);
+}
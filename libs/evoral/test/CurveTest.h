@@ -13,6 +13,8 @@ class CurveTest : public CppUnit::TestFixture
 	CPPUNIT_TEST (threePointDiscete);
 	CPPUNIT_TEST (constrainedCubic);
 	CPPUNIT_TEST (ctrlListEval);
+	CPPUNIT_TEST (rtEval);
+	CPPUNIT_TEST (rtWritePass);
 	CPPUNIT_TEST_SUITE_END ();
 
 public:
@@ -23,6 +25,8 @@ public:
 	void threePointDiscete ();
 	void constrainedCubic ();
 	void ctrlListEval ();
+	void rtEval ();
+	void rtWritePass ();
 
 private:
 	boost::shared_ptr<Evoral::ControlList> TestCtrlList() {
@@ -134,6 +134,44 @@ SequenceTest::iteratorSeekTest ()
 	CPPUNIT_ASSERT(i == j);
 }
 
+void
+SequenceTest::noteIndexTest ()
+{
+	seq->clear();
+
+	// Add notes in reverse order
+	for (Notes::const_reverse_iterator i = test_notes.rbegin(); i != test_notes.rend(); ++i) {
+		seq->add_note_unlocked(*i);
+	}
+
+	Sequence<Time>::NoteIndexPtr idx = seq->note_index();
+	CPPUNIT_ASSERT_EQUAL(test_notes.size(), idx->size());
+
+	for (size_t n = 0; n < idx->size(); ++n) {
+		CPPUNIT_ASSERT_EQUAL(Time(n * 100), idx->time(n));
+		CPPUNIT_ASSERT(idx->note(n) == test_notes[n]);
+		CPPUNIT_ASSERT(idx->find(test_notes[n]->id()) == test_notes[n]);
+	}
+
+	CPPUNIT_ASSERT_EQUAL(size_t(6), idx->lower_bound(Time(600)));
+	CPPUNIT_ASSERT_EQUAL(size_t(7), idx->upper_bound(Time(600)));
+	CPPUNIT_ASSERT_EQUAL(size_t(7), idx->lower_bound(Time(601)));
+	CPPUNIT_ASSERT_EQUAL(idx->size(), idx->lower_bound(Time(1200)));
+	CPPUNIT_ASSERT(!idx->find(-1));
+
+	// Removing a note creates a new index, the old one remains unchanged
+	seq->remove_note_unlocked(test_notes[3]);
+	Sequence<Time>::NoteIndexPtr idx2 = seq->note_index();
+	CPPUNIT_ASSERT(idx != idx2);
+	CPPUNIT_ASSERT_EQUAL(test_notes.size() - 1, idx2->size());
+	CPPUNIT_ASSERT_EQUAL(test_notes.size(), idx->size());
+	CPPUNIT_ASSERT(!idx2->find(test_notes[3]->id()));
+	CPPUNIT_ASSERT_EQUAL(Time(400), idx2->time(3));
+
+	// An unmodified sequence re-uses its index
+	CPPUNIT_ASSERT(idx2 == seq->note_index());
+}
+
 void
 SequenceTest::controlInterpolationTest ()
 {
@@ -34,6 +34,46 @@
  * The design consists of two parts: an RCUManager and an RCUWriter.
 */
 
+/** RCUCycle tracks the realtime process cycle, to allow realtime threads to
+ * use SerializedRCUManager::rt_reader() instead of reader().
+ *
+ * The process thread marks each cycle using enter() and leave() (or
+ * RCUCycle::Scope). This increments a global epoch: it is odd while a cycle
+ * is in progress. Values that are replaced while a cycle is in progress
+ * are kept alive until the epoch has changed, i.e. the cycle is over.
+ *
+ * There must only be a single thread that calls enter() and leave(). The
+ * raw pointer returned by rt_reader() is only valid until the end of the
+ * current cycle, and must only be used by threads that run synchronously
+ * with that thread within the cycle (e.g. process-graph threads).
+ */
+class LIBPBD_API RCUCycle
+{
+public:
+	static void enter () { g_atomic_int_inc (&_epoch); }
+	static void leave () { g_atomic_int_inc (&_epoch); }
+
+	static guint epoch () { return g_atomic_int_get (&_epoch); }
+
+	/** @return true while a cycle is in progress. This is only meaningful
+	 * for the thread that calls enter() and leave(), and threads that run
+	 * synchronously with it.
+	 */
+	static bool active () { return epoch () & 1; }
+
+	/** @return true if a cycle that was active at epoch \p e can no longer be in progress */
+	static bool passed (guint e) { return !(e & 1) || epoch () != e; }
+
+	class Scope {
+	public:
+		Scope () { RCUCycle::enter (); }
+		~Scope () { RCUCycle::leave (); }
+	};
+
+private:
+	static volatile gint _epoch;
+};
+
 /** An RCUManager is an object which takes over management of a pointer to another object.
  *
  * It provides three key methods:
@@ -135,9 +175,11 @@ private:
  *
  * For extremely well defined circumstances (i.e. it is known that there are no
  * other writer objects in existence), SerializedRCUManager also provides a
- * flush() method that will unconditionally clear out the "dead wood" list. It
- * must be used with significant caution, although the use of shared_ptr<T>
- * means that no actual objects will be deleted incorrectly if this is misused.
+ * flush() method that will unconditionally clear out the "dead wood" list,
+ * after waiting for a process cycle that may still use an old value to end
+ * (see RCUCycle). It must be used with significant caution, although the use
+ * of shared_ptr<T> means that no actual objects will be deleted incorrectly
+ * if this is misused.
  */
 template <class T>
 class /*LIBPBD_API*/ SerializedRCUManager : public RCUManager<T>
@@ -145,7 +187,17 @@ class /*LIBPBD_API*/ SerializedRCUManager : public RCUManager<T>
 public:
 	SerializedRCUManager (T* new_rcu_value)
 	    : RCUManager<T> (new_rcu_value)
+	    , _rt_value (new_rcu_value)
+	{
+	}
+
+	/** Realtime alternative to reader(): returns the current value without
+	 * any reference counting. The pointer is valid until the end of the
+	 * current process cycle, see RCUCycle.
+	 */
+	T* rt_reader () const
 	{
+		return (T*) g_atomic_pointer_get (&_rt_value);
 	}
 
 	boost::shared_ptr<T> write_copy ()
@@ -154,15 +206,7 @@ public:
 
 		// clean out any dead wood
 
-		typename std::list<boost::shared_ptr<T> >::iterator i;
-
-		for (i = _dead_wood.begin (); i != _dead_wood.end ();) {
-			if ((*i).unique ()) {
-				i = _dead_wood.erase (i);
-			} else {
-				++i;
-			}
-		}
+		cleanup ();
 
 		/* store the current so that we can do compare and exchange
 		 * when someone calls update(). Notice that we hold
@@ -197,6 +241,13 @@ public:
 		                                                  (gpointer)new_spp);
 
 		if (ret) {
+			g_atomic_pointer_set (&_rt_value, new_value.get ());
+
+			/* rt_reader() users may still be using the old value
+			 * until the end of the cycle that is in progress now.
+			 */
+			guint const epoch = RCUCycle::epoch ();
+
 			/* successful update
 			 *
 			 * wait until there are no active readers. This ensures that any
@@ -209,12 +260,13 @@ public:
 				boost::detail::yield (i);
 			}
 
-			/* if we are not the only user, put the old value into dead_wood.
-			 * if we are the only user, then it is safe to drop it here.
+			/* if we are not the only user, or a realtime reader may
+			 * still use it, put the old value into dead_wood.
+			 * Otherwise it is safe to drop it here.
 			 */
 
-			if (!_current_write_old->unique ()) {
-				_dead_wood.push_back (*_current_write_old);
+			if (!_current_write_old->unique () || !RCUCycle::passed (epoch)) {
+				_dead_wood.push_back (DeadWood (*_current_write_old, epoch));
 			}
 
 			/* now delete it - if we are the only user, this deletes the
@@ -237,13 +289,38 @@ public:
 	void flush ()
 	{
 		Glib::Threads::Mutex::Lock lm (_lock);
+		/* realtime readers may still use values that were replaced
+		 * during the current cycle, wait for it to end (at most one cycle).
+		 */
+		typename std::list<DeadWood>::const_iterator i;
+		for (i = _dead_wood.begin (); i != _dead_wood.end (); ++i) {
+			for (unsigned n = 0; !RCUCycle::passed (i->second); ++n) {
+				boost::detail::yield (n);
+			}
+		}
 		_dead_wood.clear ();
 	}
 
 private:
-	Glib::Threads::Mutex             _lock;
-	boost::shared_ptr<T>*            _current_write_old;
-	std::list<boost::shared_ptr<T> > _dead_wood;
+	typedef std::pair<boost::shared_ptr<T>, guint> DeadWood;
+
+	/* called with _lock held */
+	void cleanup ()
+	{
+		typename std::list<DeadWood>::iterator i;
+		for (i = _dead_wood.begin (); i != _dead_wood.end ();) {
+			if (i->first.unique () && RCUCycle::passed (i->second)) {
+				i = _dead_wood.erase (i);
+			} else {
+				++i;
+			}
+		}
+	}
+
+	Glib::Threads::Mutex     _lock;
+	boost::shared_ptr<T>*    _current_write_old;
+	std::list<DeadWood>      _dead_wood;
+	mutable volatile gpointer _rt_value;
 };
 
 /** RCUWriter is a convenience object that implements write_copy/update via
@@ -0,0 +1,155 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _pbd_work_stealing_deque_h_
+#define _pbd_work_stealing_deque_h_
+
+#include <cassert>
+#include <cstddef>
+#include <glib.h>
+#include <stdint.h>
+
+namespace PBD {
+
+/** Lock free, bounded work-stealing deque of pointers.
+ *
+ * A single owner thread pushes and pops at the bottom (LIFO),
+ * any number of other threads may steal from the top (FIFO).
+ *
+ * This is the array based variant of the Chase-Lev deque
+ * ("Dynamic Circular Work-Stealing Deque", SPAA 2005) with a
+ * fixed capacity: push() fails when the deque is full, and the
+ * caller is expected to fall back to some other queue.
+ *
+ * glib's atomic operations imply a full memory barrier, which is
+ * what the algorithm requires between publishing bottom and reading top.
+ */
+template <typename T>
+class /*LIBPBD_API*/ WorkStealingDeque
+{
+public:
+	WorkStealingDeque (size_t capacity = 256)
+		: _buffer (0)
+		, _buffer_mask (0)
+	{
+		size_t sz;
+		for (sz = 2; sz < capacity; sz <<= 1) ;
+		_buffer      = new gpointer[sz];
+		_buffer_mask = sz - 1;
+		clear ();
+	}
+
+	~WorkStealingDeque ()
+	{
+		delete[] _buffer;
+	}
+
+	size_t capacity () const { return _buffer_mask + 1; }
+
+	/** Reset the deque. Must not be called concurrently with any other method. */
+	void
+	clear ()
+	{
+		g_atomic_int_set (&_top, 0);
+		g_atomic_int_set (&_bottom, 0);
+	}
+
+	/** Approximate number of entries, may be used as a hint by thieves */
+	gint
+	size () const
+	{
+		gint b = g_atomic_int_get (&_bottom);
+		gint t = g_atomic_int_get (&_top);
+		return b > t ? b - t : 0;
+	}
+
+	/** Add an entry at the bottom. Owner thread only.
+	 * @return false if the deque is full.
+	 */
+	bool
+	push (T* data)
+	{
+		gint b = g_atomic_int_get (&_bottom);
+		gint t = g_atomic_int_get (&_top);
+		if ((size_t)(b - t) > _buffer_mask) {
+			return false;
+		}
+		g_atomic_pointer_set (&_buffer[b & _buffer_mask], data);
+		g_atomic_int_set (&_bottom, b + 1);
+		return true;
+	}
+
+	/** Take the most recently pushed entry. Owner thread only. */
+	bool
+	pop (T*& data)
+	{
+		gint b = g_atomic_int_get (&_bottom) - 1;
+		g_atomic_int_set (&_bottom, b);
+		gint t = g_atomic_int_get (&_top);
+
+		if (t > b) {
+			/* empty */
+			g_atomic_int_set (&_bottom, b + 1);
+			return false;
+		}
+
+		data = static_cast<T*> (g_atomic_pointer_get (&_buffer[b & _buffer_mask]));
+
+		if (t == b) {
+			/* last entry, race against thieves */
+			bool won = g_atomic_int_compare_and_exchange (&_top, t, t + 1);
+			g_atomic_int_set (&_bottom, b + 1);
+			return won;
+		}
+		return true;
+	}
+
+	/** Take the oldest entry. May be called from any thread. */
+	bool
+	steal (T*& data)
+	{
+		gint t = g_atomic_int_get (&_top);
+		gint b = g_atomic_int_get (&_bottom);
+
+		if (t >= b) {
+			return false;
+		}
+
+		/* The slot can only be re-used by the owner once _top has
+		 * moved past t, in which case the CAS below fails.
+		 */
+		T* d = static_cast<T*> (g_atomic_pointer_get (&_buffer[t & _buffer_mask]));
+		if (!g_atomic_int_compare_and_exchange (&_top, t, t + 1)) {
+			return false;
+		}
+		data = d;
+		return true;
+	}
+
+private:
+	WorkStealingDeque (WorkStealingDeque const&);
+	WorkStealingDeque& operator= (WorkStealingDeque const&);
+
+	gpointer* _buffer;
+	size_t    _buffer_mask;
+
+	volatile gint _top;
+	volatile gint _bottom;
+};
+
+} /* end namespace */
+
+#endif
@@ -1,4 +1,5 @@
 #include <glibmm.h>
+#include <boost/weak_ptr.hpp>
 
 #include "rcu_test.h"
 
@@ -36,8 +37,64 @@ launch_writer(void* self)
 	return NULL;
 }
 
+static void*
+launch_rt_reader(void* self)
+{
+	RCUTest* r = static_cast<RCUTest *>(self);
+	r->rt_read_thread ();
+	return NULL;
+}
+
 void
 RCUTest::race ()
+{
+	run (launch_reader);
+}
+
+void
+RCUTest::rt_race ()
+{
+	run (launch_rt_reader);
+}
+
+static void*
+leave_cycle (void*)
+{
+	Glib::usleep (20000);
+	RCUCycle::leave ();
+	return NULL;
+}
+
+void
+RCUTest::flush_in_cycle ()
+{
+	SerializedRCUManager<Values> values (new Values);
+	boost::weak_ptr<Values> old (values.reader ());
+
+	/* replace the value while a process cycle is in progress */
+	RCUCycle::enter ();
+	{
+		RCUWriter<Values> writer (values);
+		writer.get_copy ()->insert (make_pair ("foo", new Value ("foo")));
+	}
+
+	/* kept for rt_reader() users of the current cycle */
+	CPPUNIT_ASSERT (!old.expired ());
+
+	pthread_t process_thread;
+	CPPUNIT_ASSERT (pthread_create (&process_thread, NULL, leave_cycle, NULL) == 0);
+
+	/* waits for the cycle to end, then drops the old value */
+	values.flush ();
+	CPPUNIT_ASSERT (old.expired ());
+	CPPUNIT_ASSERT (RCUCycle::passed (RCUCycle::epoch ()));
+
+	void* return_value;
+	CPPUNIT_ASSERT (pthread_join (process_thread, &return_value) == 0);
+}
+
+void
+RCUTest::run (void* (*reader)(void*))
 {
 #ifdef __APPLE__
 	pthread_mutex_init (&_mutex, NULL);
@@ -51,7 +108,7 @@ RCUTest::race ()
 	pthread_t writer_thread;
 
 	CPPUNIT_ASSERT (pthread_create (&writer_thread, NULL, launch_writer, this) == 0);
-	CPPUNIT_ASSERT (pthread_create (&reader_thread, NULL, launch_reader, this) == 0);
+	CPPUNIT_ASSERT (pthread_create (&reader_thread, NULL, reader, this) == 0);
 
 	void* return_value;
 	CPPUNIT_ASSERT (pthread_join (writer_thread, &return_value) == 0);
@@ -68,7 +125,7 @@ RCUTest::race ()
 /* ****************************************************************************/
 
 void
-RCUTest::read_thread ()
+RCUTest::sync_threads ()
 {
 #ifdef __APPLE__
 	pthread_mutex_lock (&_mutex);
@@ -82,6 +139,12 @@ RCUTest::read_thread ()
 #else
 	pthread_barrier_wait (&_barrier);
 #endif
+}
+
+void
+RCUTest::read_thread ()
+{
+	sync_threads ();
 
 	for (int i = 0; i < 15000; ++i) {
 		boost::shared_ptr<Values> reader  = _values.reader ();
@@ -92,20 +155,24 @@ RCUTest::read_thread ()
 }
 
 void
-RCUTest::write_thread ()
+RCUTest::rt_read_thread ()
 {
-#ifdef __APPLE__
-	pthread_mutex_lock (&_mutex);
-	if (++_cnt == 2) {
-		pthread_cond_broadcast (&_cond);
-		pthread_mutex_unlock (&_mutex);
-	} else {
-		pthread_cond_wait (&_cond, &_mutex);
+	sync_threads ();
+
+	for (int i = 0; i < 15000; ++i) {
+		/* emulate a process cycle */
+		RCUCycle::Scope cycle;
+		Values* reader = _values.rt_reader ();
+		for (Values::const_iterator i = reader->begin (); i != reader->end(); ++i) {
+			CPPUNIT_ASSERT (i->first == i->second->val);
+		}
 	}
-	pthread_mutex_unlock (&_mutex);
-#else
-	pthread_barrier_wait (&_barrier);
-#endif
+}
+
+void
+RCUTest::write_thread ()
+{
+	sync_threads ();
 
 	for (int i = 0; i < 10000; ++i) {
 		RCUWriter<Values> writer (_values);
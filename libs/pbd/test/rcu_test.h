@@ -9,17 +9,25 @@ class RCUTest : public CppUnit::TestFixture
 {
 	CPPUNIT_TEST_SUITE (RCUTest);
 	CPPUNIT_TEST (race);
+	CPPUNIT_TEST (rt_race);
+	CPPUNIT_TEST (flush_in_cycle);
 	CPPUNIT_TEST_SUITE_END ();
 
 public:
 	RCUTest ();
 	void setUp ();
 	void race ();
+	void rt_race ();
+	void flush_in_cycle ();
 
 	void read_thread ();
+	void rt_read_thread ();
 	void write_thread ();
 
 private:
+	void run (void* (*reader)(void*));
+	void sync_threads ();
+
 	class Value {
 		public:
 			Value (std::string const& v)
@@ -51,6 +51,7 @@
 #include "ardour/vca.h"
 #include "ardour/monitor_control.h"
 #include "ardour/dB.h"
+#include "ardour/dsp_stats.h"
 #include "ardour/filesystem_paths.h"
 #include "ardour/panner.h"
 #include "ardour/panner_shell.h"
@@ -609,6 +610,8 @@ OSC::register_callbacks()
 		REGISTER_CALLBACK (serv, X_("/strip/plugin/list"), "i", route_plugin_list);
 		REGISTER_CALLBACK (serv, X_("/strip/plugin/descriptor"), "ii", route_plugin_descriptor);
 		REGISTER_CALLBACK (serv, X_("/strip/plugin/reset"), "ii", route_plugin_reset);
+		REGISTER_CALLBACK (serv, X_("/strip/dsp_stats"), "i", route_dsp_stats);
+		REGISTER_CALLBACK (serv, X_("/dsp_stats/enable"), "i", dsp_stats_enable);
 
 		/* this is a special catchall handler,
 		 * register at the end so this is only called if no
@@ -5381,6 +5384,73 @@ OSC::route_plugin_reset (int ssid, int piid, lo_message msg) {
 	return 0;
 }
 
+int
+OSC::dsp_stats_enable (int yn, lo_message msg)
+{
+	DSPStats::set_enabled (yn);
+	return 0;
+}
+
+static void
+add_dsp_stats (lo_message reply, std::string const& name, bool ok, uint64_t min, uint64_t max, double avg, uint64_t p50, uint64_t p95, uint64_t p99)
+{
+	if (!ok) {
+		return;
+	}
+	lo_message_add_string (reply, name.c_str ());
+	lo_message_add_int32 (reply, min);
+	lo_message_add_int32 (reply, max);
+	lo_message_add_float (reply, avg);
+	lo_message_add_int32 (reply, p50);
+	lo_message_add_int32 (reply, p95);
+	lo_message_add_int32 (reply, p99);
+}
+
+/* reply: ssid, followed by (name, min, max, avg, p50, p95, p99) [usec]
+ * for the route ("route"), the time it waited for the process graph
+ * ("graph-wait") and each processor that has statistics.
+ */
+int
+OSC::route_dsp_stats (int ssid, lo_message msg)
+{
+	if (!session) {
+		return -1;
+	}
+
+	boost::shared_ptr<Route> r = boost::dynamic_pointer_cast<Route>(get_strip (ssid, get_address (msg)));
+
+	if (!r) {
+		PBD::error << "OSC: Invalid Remote Control ID '" << ssid << "'" << endmsg;
+		return -1;
+	}
+
+	uint64_t min, max, p50, p95, p99;
+	double   avg;
+	bool     ok;
+
+	lo_message reply = lo_message_new ();
+	lo_message_add_int32 (reply, ssid);
+
+	ok = r->get_dsp_stats (min, max, avg, p50, p95, p99);
+	add_dsp_stats (reply, X_("route"), ok, min, max, avg, p50, p95, p99);
+
+	ok = r->get_graph_wait_stats (min, max, avg, p50, p95, p99);
+	add_dsp_stats (reply, X_("graph-wait"), ok, min, max, avg, p50, p95, p99);
+
+	for (uint32_t n = 0;; ++n) {
+		boost::shared_ptr<Processor> proc = r->nth_processor (n);
+		if (!proc) {
+			break;
+		}
+		ok = proc->get_dsp_stats (min, max, avg, p50, p95, p99);
+		add_dsp_stats (reply, proc->name (), ok, min, max, avg, p50, p95, p99);
+	}
+
+	lo_send_message (get_address (msg), X_("/strip/dsp_stats"), reply);
+	lo_message_free (reply);
+	return 0;
+}
+
 int
 OSC::route_plugin_parameter (int ssid, int piid, int par, float val, lo_message msg)
 {
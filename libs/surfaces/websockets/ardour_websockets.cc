@@ -42,6 +42,8 @@ ArdourWebsockets::ArdourWebsockets (Session& s)
     , _feedback (*this)
     , _server (*this)
     , _dispatcher (*this)
+    , _feedback_interval (DEFAULT_FEEDBACK_INTERVAL_MS)
+    , _meter_interval (DEFAULT_METER_INTERVAL_MS)
 {
 	_components.push_back (&_mixer);
 	_components.push_back (&_transport);
@@ -84,6 +86,28 @@ ArdourWebsockets::set_active (bool yn)
 	return ControlProtocol::set_active (yn);
 }
 
+XMLNode&
+ArdourWebsockets::get_state ()
+{
+	XMLNode& node (ControlProtocol::get_state ());
+	node.set_property (X_("feedback-interval"), _feedback_interval);
+	node.set_property (X_("meter-interval"), _meter_interval);
+	return node;
+}
+
+int
+ArdourWebsockets::set_state (const XMLNode& node, int version)
+{
+	if (ControlProtocol::set_state (node, version)) {
+		return -1;
+	}
+
+	node.get_property (X_("feedback-interval"), _feedback_interval);
+	node.get_property (X_("meter-interval"), _meter_interval);
+
+	return 0;
+}
+
 void
 ArdourWebsockets::thread_init ()
 {
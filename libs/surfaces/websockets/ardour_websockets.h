@@ -61,6 +61,19 @@ public:
 
 	int set_active (bool);
 
+	XMLNode& get_state ();
+	int      set_state (const XMLNode&, int version);
+
+	/* in milliseconds, take effect when the surface is started */
+	uint32_t feedback_interval () const
+	{
+		return _feedback_interval;
+	}
+	uint32_t meter_interval () const
+	{
+		return _meter_interval;
+	}
+
 	ARDOUR::Session& ardour_session ()
 	{
 		return *session;
@@ -100,6 +113,9 @@ private:
 	WebsocketsDispatcher           _dispatcher;
 	std::vector<SurfaceComponent*> _components;
 
+	uint32_t _feedback_interval;
+	uint32_t _meter_interval;
+
 	int start ();
 	int stop ();
 };
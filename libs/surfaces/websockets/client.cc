@@ -58,6 +58,28 @@ ClientContext::update_state (const NodeState& node_state)
 	_state.insert (node_state);
 }
 
+void
+ClientChangeSet::add (const NodeState& node_state)
+{
+	ChangeIndex::iterator it = _index.find (node_state);
+
+	if (it != _index.end ()) {
+		*it->second = node_state;
+		return;
+	}
+
+	_index.insert (std::make_pair (node_state, _changes.insert (_changes.end (), node_state)));
+}
+
+NodeState
+ClientChangeSet::pop_front ()
+{
+	NodeState node_state = _changes.front ();
+	_changes.pop_front ();
+	_index.erase (node_state);
+	return node_state;
+}
+
 std::string
 ClientContext::debug_str ()
 {
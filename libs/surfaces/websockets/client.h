@@ -19,6 +19,7 @@
 #ifndef _ardour_surface_websockets_client_h_
 #define _ardour_surface_websockets_client_h_
 
+#include <boost/unordered_map.hpp>
 #include <set>
 #include <list>
 
@@ -29,13 +30,41 @@ typedef struct lws* Client;
 
 namespace ArdourSurface {
 
-typedef std::list<NodeStateMessage> ClientOutputBuffer;
+/* states waiting to be sent, at most one per node and address */
+class ClientChangeSet
+{
+public:
+	bool empty () const
+	{
+		return _changes.empty ();
+	}
+
+	size_t size () const
+	{
+		return _changes.size ();
+	}
+
+	/* add a change or replace the value of a pending one, keeping
+	 * its position so that changes are sent in the order they first
+	 * occurred */
+	void add (const NodeState&);
+
+	NodeState pop_front ();
+
+private:
+	typedef std::list<NodeState> ChangeList;
+	typedef boost::unordered_map<NodeState, ChangeList::iterator> ChangeIndex;
+
+	ChangeList  _changes;
+	ChangeIndex _index;
+};
 
 class ClientContext
 {
 public:
-	ClientContext (Client wsi)
-	    : _wsi (wsi){};
+	ClientContext (Client wsi, bool binary = false)
+	    : _wsi (wsi)
+	    , _binary (binary){};
 	virtual ~ClientContext (){};
 
 	Client wsi () const
@@ -43,23 +72,30 @@ public:
 		return _wsi;
 	}
 
+	/* client accepts coalesced binary frames, see NodeStateMessage::serialize_binary () */
+	bool binary () const
+	{
+		return _binary;
+	}
+
 	bool has_state (const NodeState&);
 	void update_state (const NodeState&);
 
-	ClientOutputBuffer& output_buf ()
+	ClientChangeSet& changes ()
 	{
-		return _output_buf;
+		return _changes;
 	}
 
 	std::string debug_str ();
 
 private:
 	Client _wsi;
+	bool   _binary;
 
 	typedef std::set<NodeState> ClientState;
 	ClientState                 _state;
 
-	ClientOutputBuffer _output_buf;
+	ClientChangeSet _changes;
 };
 
 } // namespace ArdourSurface
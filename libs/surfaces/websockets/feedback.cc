@@ -16,18 +16,18 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
+
 #include "ardour/plugin_insert.h"
 #include "ardour/session.h"
 #include "ardour/tempo.h"
 
+#include "ardour_websockets.h"
 #include "feedback.h"
 #include "transport.h"
 #include "server.h"
 #include "state.h"
 
-// TO DO: make this configurable
-#define POLL_INTERVAL_MS 100
-
 using namespace ARDOUR;
 using namespace ArdourSurface;
 
@@ -55,7 +55,8 @@ struct TempoObserver {
 struct StripGainObserver {
 	void operator() (ArdourFeedback* p, uint32_t strip_id)
 	{
-		// fires multiple times (4x as of ardour 6.0)
+		// fires multiple times (4x as of ardour 6.0), clients
+		// receive only the last value with the next poll
 		p->update_all (Node::strip_gain, strip_id, p->mixer ().strip (strip_id).gain ());
 	}
 };
@@ -103,8 +104,14 @@ ArdourFeedback::start ()
 	observe_transport ();
 	observe_mixer ();
 
-	// some values need polling like the strip meters
-	Glib::RefPtr<Glib::TimeoutSource> periodic_timeout = Glib::TimeoutSource::create (POLL_INTERVAL_MS);
+	// some values need polling like the strip meters, all other
+	// changes are coalesced and sent to clients with each poll
+	uint32_t interval = std::max<uint32_t> (10, _surface.feedback_interval ());
+
+	_meter_divider = std::max<uint32_t> (1, (_surface.meter_interval () + interval / 2) / interval);
+	_poll_count    = 0;
+
+	Glib::RefPtr<Glib::TimeoutSource> periodic_timeout = Glib::TimeoutSource::create (interval);
 	_periodic_connection                               = periodic_timeout->connect (sigc::mem_fun (*this,
                                                                          &ArdourFeedback::poll));
 	periodic_timeout->attach (main_loop ()->get_context ());
@@ -165,17 +172,23 @@ ArdourFeedback::update_all (std::string node, uint32_t strip_id, uint32_t plugin
 }
 
 bool
-ArdourFeedback::poll () const
+ArdourFeedback::poll ()
 {
 	update_all (Node::transport_time, transport ().time ());
 
-	Glib::Threads::Mutex::Lock lock (mixer ().mutex ());
+	if (++_poll_count >= _meter_divider) {
+		_poll_count = 0;
 
-	for (ArdourMixer::StripMap::iterator it = mixer ().strips ().begin (); it != mixer ().strips ().end (); ++it) {
-		double db = it->second->meter_level_db ();
-		update_all (Node::strip_meter, it->first, db);
+		Glib::Threads::Mutex::Lock lock (mixer ().mutex ());
+
+		for (ArdourMixer::StripMap::iterator it = mixer ().strips ().begin (); it != mixer ().strips ().end (); ++it) {
+			double db = it->second->meter_level_db ();
+			update_all (Node::strip_meter, it->first, db);
+		}
 	}
 
+	server ().flush_clients ();
+
 	return true;
 }
 
@@ -27,13 +27,18 @@
 #include "typed_value.h"
 #include "mixer.h"
 
+#define DEFAULT_FEEDBACK_INTERVAL_MS 100
+#define DEFAULT_METER_INTERVAL_MS    100
+
 namespace ArdourSurface {
 
 class ArdourFeedback : public SurfaceComponent
 {
 public:
 	ArdourFeedback (ArdourSurface::ArdourWebsockets& surface)
-	    : SurfaceComponent (surface){};
+	    : SurfaceComponent (surface)
+	    , _meter_divider (1)
+	    , _poll_count (0){};
 	virtual ~ArdourFeedback (){};
 
 	int start ();
@@ -48,8 +53,10 @@ private:
 	Glib::Threads::Mutex      _client_state_lock;
 	PBD::ScopedConnectionList _transport_connections;
 	sigc::connection          _periodic_connection;
+	uint32_t                  _meter_divider;
+	uint32_t                  _poll_count;
 
-	bool poll () const;
+	bool poll ();
 
 	void observe_transport ();
 	void observe_mixer ();
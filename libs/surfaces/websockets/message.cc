@@ -20,6 +20,9 @@
 #include <iostream>
 #endif
 
+#include <algorithm>
+#include <cassert>
+
 #include <boost/lexical_cast.hpp>
 #include <boost/property_tree/json_parser.hpp>
 #include <boost/property_tree/ptree.hpp>
@@ -193,3 +196,111 @@ NodeStateMessage::serialize (void* buf, size_t len) const
 
 	return cs_sz;
 }
+
+/* Binary frames carry any number of states, all integers are little endian:
+ *
+ *   frame := count:u16 state[count]
+ *   state := node:u8 n_addr:u8 addr:u32[n_addr] n_val:u8 val[n_val]
+ *   val   := type:u8 (0 empty, 1 bool:u8, 2 int:i32, 3 double:f64, 4 string:u16 len, bytes)
+ *
+ * node is the index into binary_nodes below, which must be kept in sync
+ * with StateNodeIndex in share/web_surfaces/shared/base/protocol.js
+ */
+
+static const std::string* binary_nodes[] = {
+	&Node::strip_description,
+	&Node::strip_meter,
+	&Node::strip_gain,
+	&Node::strip_pan,
+	&Node::strip_mute,
+	&Node::strip_plugin_description,
+	&Node::strip_plugin_enable,
+	&Node::strip_plugin_param_description,
+	&Node::strip_plugin_param_value,
+	&Node::transport_tempo,
+	&Node::transport_time,
+	&Node::transport_roll,
+	&Node::transport_record
+};
+
+static void
+put_u8 (std::vector<uint8_t>& out, uint8_t v)
+{
+	out.push_back (v);
+}
+
+static void
+put_u16 (std::vector<uint8_t>& out, uint16_t v)
+{
+	out.push_back (v & 0xff);
+	out.push_back (v >> 8);
+}
+
+static void
+put_u32 (std::vector<uint8_t>& out, uint32_t v)
+{
+	for (int i = 0; i < 4; ++i) {
+		out.push_back ((v >> (8 * i)) & 0xff);
+	}
+}
+
+static void
+put_f64 (std::vector<uint8_t>& out, double d)
+{
+	uint64_t v;
+	memcpy (&v, &d, sizeof (v));
+	for (int i = 0; i < 8; ++i) {
+		out.push_back ((v >> (8 * i)) & 0xff);
+	}
+}
+
+void
+NodeStateMessage::serialize_binary (std::vector<uint8_t>& out) const
+{
+	const size_t n_nodes = sizeof (binary_nodes) / sizeof (binary_nodes[0]);
+
+	size_t node = 0;
+	while (node < n_nodes && *binary_nodes[node] != _state.node ()) {
+		++node;
+	}
+	assert (node < n_nodes);
+
+	put_u8 (out, node);
+
+	int n_addr = _state.n_addr ();
+	put_u8 (out, n_addr);
+
+	for (int i = 0; i < n_addr; i++) {
+		put_u32 (out, _state.nth_addr (i));
+	}
+
+	int n_val = _state.n_val ();
+	put_u8 (out, n_val);
+
+	for (int i = 0; i < n_val; i++) {
+		TypedValue val = _state.nth_val (i);
+
+		put_u8 (out, val.type ());
+
+		switch (val.type ()) {
+			case TypedValue::Bool:
+				put_u8 (out, static_cast<bool> (val) ? 1 : 0);
+				break;
+			case TypedValue::Int:
+				put_u32 (out, static_cast<uint32_t> (static_cast<int> (val)));
+				break;
+			case TypedValue::Double:
+				put_f64 (out, static_cast<double> (val));
+				break;
+			case TypedValue::String: {
+				std::string s = static_cast<std::string> (val);
+				size_t      n = std::min<size_t> (s.size (), 0xffff);
+				put_u16 (out, n);
+				out.insert (out.end (), s.begin (), s.begin () + n);
+				break;
+			}
+			default:
+				break;
+		}
+	}
+}
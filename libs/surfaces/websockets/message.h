@@ -19,6 +19,9 @@
 #ifndef _ardour_surface_websockets_message_h_
 #define _ardour_surface_websockets_message_h_
 
+#include <stdint.h>
+#include <vector>
+
 #include "state.h"
 
 namespace ArdourSurface {
@@ -31,6 +34,9 @@ public:
 
 	size_t serialize (void*, size_t) const;
 
+	/* append the state in binary form to a frame, see message.cc */
+	void serialize_binary (std::vector<uint8_t>&) const;
+
 	bool is_valid () const
 	{
 		return _valid;
@@ -20,6 +20,8 @@
 #include <iostream>
 #endif
 
+#include <algorithm>
+
 #include "dispatcher.h"
 #include "server.h"
 
@@ -45,6 +47,7 @@
 								(LWS_LIBRARY_VERSION_MINOR * 1000)
 
 #define MAX_INDEX_SIZE	65536
+#define MAX_BINARY_FRAME_STATES 1024
 
 using namespace Glib;
 using namespace ArdourSurface;
@@ -66,7 +69,12 @@ WebsocketsServer::WebsocketsServer (ArdourSurface::ArdourWebsockets& surface)
 #endif
 	
 	_lws_proto[0] = proto;
-	memset (&_lws_proto[1], 0, sizeof (lws_protocols));
+
+	proto.name = WEBSOCKET_BINARY_PROTOCOL;
+	proto.id   = 1;
+
+	_lws_proto[1] = proto;
+	memset (&_lws_proto[2], 0, sizeof (lws_protocols));
 
 	/* '/' is served by a static index.html file in the surface data directory
 	 * inside it there is a 'builtin' subdirectory that contains all built-in
@@ -192,10 +200,15 @@ WebsocketsServer::update_client (Client wsi, const NodeState& state, bool force)
 	}
 
 	if (force || !it->second.has_state (state)) {
-		/* write to client only if state was updated */
+		/* write to client only if state was updated, feedback is
+		 * coalesced until the next flush_clients ()
+		 */
 		it->second.update_state (state);
-		it->second.output_buf ().push_back (NodeStateMessage (state));
-		lws_callback_on_writable (wsi);
+		it->second.changes ().add (state);
+
+		if (force) {
+			lws_callback_on_writable (wsi);
+		}
 	}
 }
 
@@ -207,10 +220,23 @@ WebsocketsServer::update_all_clients (const NodeState& state, bool force)
 	}
 }
 
+void
+WebsocketsServer::flush_clients ()
+{
+	for (ClientContextMap::iterator it = _client_ctx.begin (); it != _client_ctx.end (); ++it) {
+		if (!it->second.changes ().empty ()) {
+			lws_callback_on_writable (it->second.wsi ());
+		}
+	}
+}
+
 int
 WebsocketsServer::add_client (Client wsi)
 {
-	_client_ctx.emplace (wsi, ClientContext (wsi));
+	const struct lws_protocols* proto = lws_get_protocol (wsi);
+	bool binary = proto && proto->id == 1;
+
+	_client_ctx.emplace (wsi, ClientContext (wsi, binary));
 	dispatcher ().update_all_nodes (wsi); // send all state
 	return 0;
 }
@@ -260,15 +286,32 @@ WebsocketsServer::write_client (Client wsi)
 		return 1;
 	}
 
-	ClientOutputBuffer& pending = it->second.output_buf ();
+	ClientChangeSet& pending = it->second.changes ();
 	if (pending.empty ()) {
 		return 0;
 	}
 
 	/* one lws_write() call per LWS_CALLBACK_SERVER_WRITEABLE callback */
 
-	NodeStateMessage msg = pending.front ();
-	pending.pop_front ();
+	int rc;
+
+	if (it->second.binary ()) {
+		rc = write_client_binary (wsi, pending);
+	} else {
+		rc = write_client_text (wsi, pending);
+	}
+
+	if (rc == 0 && !pending.empty ()) {
+		lws_callback_on_writable (wsi);
+	}
+
+	return rc;
+}
+
+int
+WebsocketsServer::write_client_text (Client wsi, ClientChangeSet& pending)
+{
+	NodeStateMessage msg (pending.pop_front ());
 
 	unsigned char out_buf[1024];
 	int len = msg.serialize (out_buf + LWS_PRE, 1024 - LWS_PRE);
@@ -284,8 +327,33 @@ WebsocketsServer::write_client (Client wsi)
 		PBD::error << "ArdourWebsockets: cannot serialize message" << endmsg;
 	}
 
-	if (!pending.empty ()) {
-		lws_callback_on_writable (wsi);
+	return 0;
+}
+
+int
+WebsocketsServer::write_client_binary (Client wsi, ClientChangeSet& pending)
+{
+	/* all pending changes in a single frame, up to a limit to keep
+	 * the initial state of large sessions from making huge frames */
+	uint16_t count = std::min<size_t> (pending.size (), MAX_BINARY_FRAME_STATES);
+
+	_binary_buf.resize (LWS_PRE);
+	_binary_buf.push_back (count & 0xff);
+	_binary_buf.push_back (count >> 8);
+
+	for (uint16_t i = 0; i < count; ++i) {
+		NodeStateMessage msg (pending.pop_front ());
+		msg.serialize_binary (_binary_buf);
+	}
+
+	int len = _binary_buf.size () - LWS_PRE;
+
+#ifndef NDEBUG
+	std::cerr << "TX " << count << " states, " << len << " bytes" << std::endl;
+#endif
+
+	if (lws_write (wsi, &_binary_buf[LWS_PRE], len, LWS_WRITE_BINARY) != len) {
+		return 1;
 	}
 
 	return 0;
@@ -39,6 +39,9 @@
 // TO DO: make this configurable
 #define WEBSOCKET_LISTEN_PORT 3818
 
+// clients requesting this subprotocol receive coalesced binary frames
+#define WEBSOCKET_BINARY_PROTOCOL "ardour-binary"
+
 // lws includes integration with the glib event loop starting from v4
 #ifndef LWS_WITH_GLIB
 struct LwsPollFdGlibSource {
@@ -63,11 +66,14 @@ public:
 	void update_client (Client, const NodeState&, bool);
 	void update_all_clients (const NodeState&, bool);
 
+	/* send all pending changes */
+	void flush_clients ();
+
 private:
 #if LWS_LIBRARY_VERSION_MAJOR < 3
 	struct lws_protocol_vhost_options _lws_vhost_opt;
 #endif
-	struct lws_protocols              _lws_proto[2];
+	struct lws_protocols              _lws_proto[3];
 	struct lws_http_mount             _lws_mnt_root;
 	struct lws_http_mount             _lws_mnt_user;
 	struct lws_context_creation_info  _lws_info;
@@ -78,10 +84,14 @@ private:
 
 	ServerResources _resources;
 
+	std::vector<uint8_t> _binary_buf;
+
 	int add_client (Client);
 	int del_client (Client);
 	int recv_client (Client, void*, size_t);
 	int write_client (Client);
+	int write_client_text (Client, ClientChangeSet&);
+	int write_client_binary (Client, ClientChangeSet&);
 	int send_availsurf_hdr (Client);
 	int send_availsurf_body (Client);
 
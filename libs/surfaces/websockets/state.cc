@@ -123,7 +123,7 @@ NodeState::operator< (const NodeState& other) const
 
 
 std::size_t
-hash_value (const NodeState& state)
+ArdourSurface::hash_value (const NodeState& state)
 {
 	return state.node_addr_hash ();
 }
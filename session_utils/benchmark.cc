@@ -0,0 +1,584 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <getopt.h>
+#include <inttypes.h>
+#include <glibmm.h>
+
+#include "common.h"
+
+#include "pbd/compose.h"
+
+#include "ardour/audio_track.h"
+#include "ardour/audiofilesource.h"
+#include "ardour/audioengine.h"
+#include "ardour/audioregion.h"
+#include "ardour/butler.h"
+#include "ardour/dsp_stats.h"
+#include "ardour/graph.h"
+#include "ardour/io.h"
+#include "ardour/lua_api.h"
+#include "ardour/playlist.h"
+#include "ardour/rc_configuration.h"
+#include "ardour/region_factory.h"
+#include "ardour/route.h"
+
+using namespace std;
+using namespace ARDOUR;
+using namespace SessionUtils;
+
+/* ****************************************************************************
+ * synthetic session generator
+ */
+
+struct GenerateSettings
+{
+	GenerateSettings ()
+		: tracks (16)
+		, plugins (0)
+		, regions (0)
+		, bus_depth (0)
+		, bus_fanout (4)
+		, plugin ("ACE Amplifier")
+	{}
+
+	uint32_t    tracks;
+	uint32_t    plugins;    ///< per track
+	uint32_t    regions;    ///< per track
+	uint32_t    bus_depth;  ///< levels of busses between tracks and master
+	uint32_t    bus_fanout; ///< inputs per bus
+	std::string plugin;     ///< name of Lua DSP to add
+};
+
+static bool
+generate_preset (std::string const& name, GenerateSettings& g)
+{
+	if (name == "tracks") {
+		g.tracks = 256;
+	} else if (name == "plugins") {
+		g.tracks  = 32;
+		g.plugins = 16;
+	} else if (name == "regions") {
+		g.tracks  = 16;
+		g.regions = 2000;
+	} else if (name == "bustree") {
+		g.tracks     = 256;
+		g.bus_depth  = 4;
+		g.bus_fanout = 4;
+	} else if (name == "mix") {
+		g.tracks     = 64;
+		g.plugins    = 4;
+		g.regions    = 200;
+		g.bus_depth  = 2;
+		g.bus_fanout = 8;
+	} else {
+		return false;
+	}
+	return true;
+}
+
+static boost::shared_ptr<AudioFileSource>
+create_source (Session* s, std::string const& name, samplecnt_t len, float freq)
+{
+	boost::shared_ptr<AudioFileSource> afs = s->create_audio_source_for_session (1, name, 0);
+	if (!afs) {
+		return afs;
+	}
+
+	afs->prepare_for_peakfile_writes ();
+
+	const samplecnt_t chunk = 8192;
+	const double      w     = 2.0 * M_PI * freq / s->nominal_sample_rate ();
+	Sample            buf[chunk];
+
+	for (samplecnt_t pos = 0; pos < len; pos += chunk) {
+		const samplecnt_t n = std::min (chunk, len - pos);
+		for (samplecnt_t i = 0; i < n; ++i) {
+			buf[i] = .25f * sinf (w * (pos + i));
+		}
+		if (afs->write (buf, n) != n) {
+			cerr << "Error: cannot write audio data\n";
+			return boost::shared_ptr<AudioFileSource> ();
+		}
+	}
+
+	time_t now;
+	time (&now);
+	afs->update_header (0, *localtime (&now), now);
+	afs->flush_header ();
+	afs->done_with_peakfile_writes ();
+	return afs;
+}
+
+static bool
+add_regions (Session* s, boost::shared_ptr<AudioTrack> t, uint32_t n_regions, uint32_t id)
+{
+	const samplecnt_t src_len = 10 * s->nominal_sample_rate ();
+	const samplecnt_t reg_len = src_len / 4;
+
+	boost::shared_ptr<AudioFileSource> afs = create_source (s, string_compose ("bench-%1", id), src_len, 110.f * (1 + id % 8));
+	if (!afs) {
+		return false;
+	}
+
+	SourceList srcs;
+	srcs.push_back (afs);
+
+	boost::shared_ptr<Playlist> pl = t->playlist ();
+	pl->freeze ();
+
+	for (uint32_t r = 0; r < n_regions; ++r) {
+		PBD::PropertyList plist;
+		plist.add (ARDOUR::Properties::start, (r * 4801) % (src_len - reg_len));
+		plist.add (ARDOUR::Properties::length, reg_len);
+		plist.add (ARDOUR::Properties::name, string_compose ("bench-%1.%2", id, r));
+
+		boost::shared_ptr<Region> region = RegionFactory::create (srcs, plist);
+		/* overlap consecutive regions by a quarter */
+		pl->add_region (region, r * (reg_len * 3 / 4));
+	}
+
+	pl->thaw ();
+	return true;
+}
+
+static void
+connect_output (boost::shared_ptr<Route> from, boost::shared_ptr<Route> to)
+{
+	from->output ()->disconnect (0);
+	const uint32_t n = std::min (from->output ()->n_ports ().n_audio (), to->input ()->n_ports ().n_audio ());
+	for (uint32_t i = 0; i < n; ++i) {
+		from->output ()->connect (from->output ()->audio (i), to->input ()->audio (i)->name (), 0);
+	}
+}
+
+static bool
+generate_session (Session* s, GenerateSettings const& g)
+{
+	std::list<boost::shared_ptr<AudioTrack> > tracks = s->new_audio_track (1, 2, 0, g.tracks, "Track", PresentationInfo::max_order, Normal, false);
+	if (tracks.size () != g.tracks) {
+		cerr << "Error: cannot create tracks\n";
+		return false;
+	}
+
+	RouteList level;
+	uint32_t  id = 0;
+
+	for (std::list<boost::shared_ptr<AudioTrack> >::const_iterator t = tracks.begin (); t != tracks.end (); ++t, ++id) {
+		for (uint32_t p = 0; p < g.plugins; ++p) {
+			boost::shared_ptr<Processor> proc = LuaAPI::new_luaproc (s, g.plugin);
+			if (!proc || (*t)->add_processor_by_index (proc, -1, 0, true)) {
+				cerr << "Error: cannot add plugin '" << g.plugin << "'\n";
+				return false;
+			}
+		}
+		if (g.regions > 0 && !add_regions (s, *t, g.regions, id)) {
+			return false;
+		}
+		level.push_back (*t);
+	}
+
+	/* build a tree of busses: each level has 1/fanout as many busses
+	 * as the level below, the top-most level is connected to the master-bus.
+	 */
+	const uint32_t fanout = std::max<uint32_t> (2, g.bus_fanout);
+
+	for (uint32_t d = 0; d < g.bus_depth && level.size () > 1; ++d) {
+		const uint32_t n_busses = (level.size () + fanout - 1) / fanout;
+
+		RouteList busses = s->new_audio_route (2, 2, 0, n_busses, string_compose ("Bus L%1", d + 1), PresentationInfo::AudioBus, PresentationInfo::max_order);
+		if (busses.size () != n_busses) {
+			cerr << "Error: cannot create busses\n";
+			return false;
+		}
+
+		RouteList::const_iterator b = busses.begin ();
+		uint32_t                  n = 0;
+		for (RouteList::const_iterator r = level.begin (); r != level.end (); ++r) {
+			connect_output (*r, *b);
+			if (++n == fanout) {
+				n = 0;
+				++b;
+			}
+		}
+		level = busses;
+	}
+
+	return s->save_state ("") == 0;
+}
+
+/* ****************************************************************************
+ * benchmark
+ */
+
+class Benchmark
+{
+public:
+	Benchmark (Session* s, uint32_t n_cycles)
+		: _session (s)
+		, _n_cycles (n_cycles)
+	{
+		_cycle_usecs.resize (n_cycles);
+		g_atomic_int_set (&_count, 0);
+	}
+
+	/* called from the process thread instead of Session::process while freewheeling */
+	void process (pframes_t nframes)
+	{
+		guint n = g_atomic_int_get (&_count);
+		if (n >= _n_cycles) {
+			return;
+		}
+		const int64_t t0 = g_get_monotonic_time ();
+		_session->process (nframes);
+		_cycle_usecs[n] = g_get_monotonic_time () - t0;
+		g_atomic_int_set (&_count, n + 1);
+	}
+
+	bool done () const { return (guint) g_atomic_int_get (&_count) >= _n_cycles; }
+
+	std::vector<int64_t> const& cycle_usecs () const { return _cycle_usecs; }
+
+private:
+	Session*             _session;
+	guint                _n_cycles;
+	volatile gint        _count;
+	std::vector<int64_t> _cycle_usecs;
+};
+
+static int64_t
+percentile (std::vector<int64_t> const& sorted, double pct)
+{
+	if (sorted.empty ()) {
+		return 0;
+	}
+	size_t i = ceil (sorted.size () * pct / 100.0);
+	return sorted[std::min (sorted.size (), std::max<size_t> (1, i)) - 1];
+}
+
+static bool
+run_benchmark (Session* s, uint32_t n_cycles, bool per_route)
+{
+	AudioEngine* engine = AudioEngine::instance ();
+
+	/* start the transport, in realtime, so that disk-buffers are filled */
+	s->request_transport_speed (1.0);
+	for (int timeout = 0; !s->transport_rolling (); ++timeout) {
+		if (timeout > 500) {
+			cerr << "Error: transport does not start\n";
+			return false;
+		}
+		Glib::usleep (10000);
+	}
+
+	DSPStats::set_enabled (true);
+	DSPStats::set_window (n_cycles);
+
+	boost::shared_ptr<Graph> graph = s->process_graph ();
+	if (graph) {
+		graph->reset_worker_stats ();
+	}
+	s->butler ()->reset_disk_stats ();
+
+	Benchmark bench (s, n_cycles);
+	PBD::ScopedConnection c;
+	engine->Freewheel.connect_same_thread (c, boost::bind (&Benchmark::process, &bench, _1));
+
+	const int64_t t0 = g_get_monotonic_time ();
+
+	if (engine->freewheel (true)) {
+		cerr << "Error: cannot start freewheeling\n";
+		return false;
+	}
+
+	while (!bench.done ()) {
+		Glib::usleep (1000);
+	}
+
+	const int64_t wall = g_get_monotonic_time () - t0;
+
+	engine->freewheel (false);
+	c.disconnect ();
+	DSPStats::set_enabled (false);
+
+	/* per cycle statistics */
+	std::vector<int64_t> cycles (bench.cycle_usecs ());
+	std::sort (cycles.begin (), cycles.end ());
+
+	int64_t sum = 0;
+	for (std::vector<int64_t>::const_iterator i = cycles.begin (); i != cycles.end (); ++i) {
+		sum += *i;
+	}
+
+	const pframes_t nframes  = engine->samples_per_cycle ();
+	const double    nominal  = 1e6 * nframes / (double) engine->sample_rate ();
+	const double    avg      = sum / (double) cycles.size ();
+	const double    realtime = n_cycles * nominal / (double) wall;
+
+	printf ("Session:        %s, %u routes\n", s->name ().c_str (), (unsigned) s->get_routes ()->size ());
+	printf ("Cycles:         %u x %u samples @ %u Hz (%.1f us/cycle nominal)\n", n_cycles, (unsigned) nframes, (unsigned) engine->sample_rate (), nominal);
+	printf ("Wall time:      %.3f s, %.2fx realtime\n", wall / 1e6, realtime);
+	printf ("Cycle [us]:     min %" PRId64 " avg %.1f p50 %" PRId64 " p90 %" PRId64 " p99 %" PRId64 " p99.9 %" PRId64 " max %" PRId64 "\n",
+	        cycles.front (), avg,
+	        percentile (cycles, 50), percentile (cycles, 90), percentile (cycles, 99), percentile (cycles, 99.9),
+	        cycles.back ());
+	printf ("Cycle [%% DSP]:  avg %.1f p99 %.1f max %.1f\n",
+	        100. * avg / nominal, 100. * percentile (cycles, 99) / nominal, 100. * cycles.back () / nominal);
+
+	/* graph thread utilisation */
+	if (graph) {
+		std::vector<Graph::WorkerStats> ws;
+		graph->worker_stats (ws);
+		printf ("Graph threads:  %u%s\n", (unsigned) ws.size (), Config->get_graph_work_stealing () ? " (work stealing)" : "");
+		for (size_t i = 0; i < ws.size (); ++i) {
+			printf ("  thread %2u:    %5.1f%% busy, %" PRIu64 " routes (%" PRIu64 " stolen), %" PRIu64 " sleeps\n",
+			        (unsigned) i, 100. * ws[i].busy_usecs / (double) sum,
+			        ws[i].nodes_run, ws[i].nodes_stolen, ws[i].sleeps);
+		}
+	} else {
+		printf ("Graph threads:  none (single threaded processing)\n");
+	}
+
+	/* butler */
+	Butler::DiskStats ds = s->butler ()->disk_stats ();
+	printf ("Butler:         %" PRIu64 " passes, %" PRIu64 " track refills, %.1f%% busy, %.0f refills/s\n",
+	        ds.passes, ds.tracks, 100. * ds.usecs / (double) wall, ds.tracks * 1e6 / (double) wall);
+
+	if (per_route) {
+		boost::shared_ptr<RouteList> rl = s->get_routes ();
+		printf ("Routes [us]:    %-24s %8s %8s %8s %8s\n", "name", "avg", "p99", "max", "wait-p99");
+		for (RouteList::const_iterator r = rl->begin (); r != rl->end (); ++r) {
+			uint64_t min, max, p50, p95, p99;
+			uint64_t wmin, wmax, w50, w95, w99;
+			double   avg, wavg;
+			if (!(*r)->get_dsp_stats (min, max, avg, p50, p95, p99)) {
+				continue;
+			}
+			if (!(*r)->get_graph_wait_stats (wmin, wmax, wavg, w50, w95, w99)) {
+				w99 = 0;
+			}
+			printf ("                %-24s %8.1f %8" PRIu64 " %8" PRIu64 " %8" PRIu64 "\n",
+			        (*r)->name ().substr (0, 24).c_str (), avg, p99, max, w99);
+		}
+	}
+
+	s->request_stop ();
+	return true;
+}
+
+static void usage ()
+{
+	// help2man compatible format (standard GNU help-text)
+	printf (UTILNAME " - measure session processing performance.\n\n");
+	printf ("Usage: " UTILNAME " [ OPTIONS ] <session-dir> <session-name>\n\n");
+	printf ("Options:\n\
+  -c, --cycles <num>         number of process cycles to run (default 10000)\n\
+  -g, --generate <preset>    create a synthetic session, see below\n\
+  -h, --help                 display this help and exit\n\
+  -j, --threads <num>        number of DSP threads (default: processor-usage preference)\n\
+  -p, --plugins <num>        generate: plugins per track\n\
+  -P, --plugin <name>        generate: Lua DSP to use (default \"ACE Amplifier\")\n\
+  -r, --regions <num>        generate: regions per track\n\
+  -R, --routes               print per route statistics\n\
+  -s, --samplerate <rate>    generate: samplerate to use (default 48000)\n\
+  -t, --tracks <num>         generate: number of tracks\n\
+  -T, --bus-tree <depth>     generate: levels of busses between tracks and master\n\
+  -V, --version              print version information and exit\n\
+  -w, --work-stealing        use per-thread work queues for the process graph\n\
+\n");
+
+	printf ("\n\
+This tool runs the given session as fast as possible (freewheeling, using\n\
+the dummy backend) with the transport rolling, and reports the distribution\n\
+of the time spent per process cycle, the utilisation of the process graph\n\
+threads and butler disk I/O throughput.\n\
+\n\
+With --generate a new session is created first. The preset defines the\n\
+initial settings which can be modified by the other generate options:\n\
+  tracks   256 tracks\n\
+  plugins  32 tracks with 16 plugins each\n\
+  regions  16 tracks with 2000 overlapping regions each\n\
+  bustree  256 tracks feeding a tree of busses, 4 levels deep\n\
+  mix      64 tracks with 4 plugins and 200 regions, 2 levels of busses\n\
+\n\
+Note: the tool expects a session-name without .ardour file-name extension.\n\
+\n");
+
+	printf ("\n\
+Examples:\n\
+" UTILNAME " -g plugins -t 64 /tmp/bench-plugins bench-plugins\n\
+" UTILNAME " -c 50000 -j 4 -w /tmp/bench-plugins bench-plugins\n\
+\n");
+
+	printf ("Report bugs to <http://tracker.ardour.org/>\n"
+	        "Website: <http://ardour.org/>\n");
+	::exit (EXIT_SUCCESS);
+}
+
+int main (int argc, char* argv[])
+{
+	GenerateSettings gen;
+	std::string      preset;
+	uint32_t         n_cycles      = 10000;
+	int              n_threads     = 0;
+	int              sample_rate   = 48000;
+	bool             work_stealing = false;
+	bool             per_route     = false;
+
+	const char *optstring = "c:g:hj:p:P:r:Rs:t:T:Vw";
+
+	const struct option longopts[] = {
+		{ "cycles",        1, 0, 'c' },
+		{ "generate",      1, 0, 'g' },
+		{ "help",          0, 0, 'h' },
+		{ "threads",       1, 0, 'j' },
+		{ "plugins",       1, 0, 'p' },
+		{ "plugin",        1, 0, 'P' },
+		{ "regions",       1, 0, 'r' },
+		{ "routes",        0, 0, 'R' },
+		{ "samplerate",    1, 0, 's' },
+		{ "tracks",        1, 0, 't' },
+		{ "bus-tree",      1, 0, 'T' },
+		{ "version",       0, 0, 'V' },
+		{ "work-stealing", 0, 0, 'w' },
+	};
+
+	/* preset first, other generate options modify it */
+	for (int i = 1; i < argc - 1; ++i) {
+		if (!strcmp (argv[i], "-g") || !strcmp (argv[i], "--generate")) {
+			preset = argv[i + 1];
+		}
+	}
+	if (!preset.empty () && !generate_preset (preset, gen)) {
+		cerr << "Error: unknown preset '" << preset << "'. See --help for usage information.\n";
+		::exit (EXIT_FAILURE);
+	}
+
+	int c = 0;
+	while (EOF != (c = getopt_long (argc, argv,
+					optstring, longopts, (int *) 0))) {
+		switch (c) {
+			case 'c':
+				n_cycles = std::max (1, atoi (optarg));
+				break;
+
+			case 'g':
+				/* handled above */
+				break;
+
+			case 'j':
+				n_threads = std::max (1, atoi (optarg));
+				break;
+
+			case 'p':
+				gen.plugins = std::max (0, atoi (optarg));
+				break;
+
+			case 'P':
+				gen.plugin = optarg;
+				break;
+
+			case 'r':
+				gen.regions = std::max (0, atoi (optarg));
+				break;
+
+			case 'R':
+				per_route = true;
+				break;
+
+			case 's':
+				{
+					const int sr = atoi (optarg);
+					if (sr >= 8000 && sr <= 192000) {
+						sample_rate = sr;
+					} else {
+						fprintf(stderr, "Invalid Samplerate\n");
+					}
+				}
+				break;
+
+			case 't':
+				gen.tracks = std::max (1, atoi (optarg));
+				break;
+
+			case 'T':
+				gen.bus_depth = std::max (0, atoi (optarg));
+				break;
+
+			case 'V':
+				printf ("ardour-utils version %s\n\n", VERSIONSTRING);
+				printf ("Copyright (C) GPL 2020\n");
+				exit (EXIT_SUCCESS);
+				break;
+
+			case 'w':
+				work_stealing = true;
+				break;
+
+			case 'h':
+				usage ();
+				break;
+
+			default:
+				cerr << "Error: unrecognized option. See --help for usage information.\n";
+				::exit (EXIT_FAILURE);
+				break;
+		}
+	}
+
+	if (optind + 2 > argc) {
+		cerr << "Error: Missing parameter. See --help for usage information.\n";
+		::exit (EXIT_FAILURE);
+	}
+
+	SessionUtils::init (false);
+
+	if (n_threads > 0) {
+		Config->set_processor_usage (n_threads);
+	}
+	Config->set_graph_work_stealing (work_stealing);
+
+	Session* s = 0;
+
+	if (!preset.empty ()) {
+		s = SessionUtils::create_session (argv[optind], argv[optind+1], sample_rate);
+		if (!s) {
+			::exit (EXIT_FAILURE);
+		}
+		if (!generate_session (s, gen)) {
+			SessionUtils::unload_session (s);
+			SessionUtils::cleanup ();
+			::exit (EXIT_FAILURE);
+		}
+		std::cout << "Created session in '" << s->path () << "'" << std::endl;
+		/* reload, so that the benchmark runs on a session just like it would be loaded */
+		SessionUtils::unload_session (s);
+	}
+
+	s = SessionUtils::load_session (argv[optind], argv[optind+1]);
+
+	bool ok = run_benchmark (s, n_cycles, per_route);
+
+	SessionUtils::unload_session (s);
+	SessionUtils::cleanup ();
+
+	return ok ? 0 : 1;
+}
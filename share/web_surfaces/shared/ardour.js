@@ -29,7 +29,8 @@ function getOption (options, key, defaultValue) {
 export default class ArdourClient extends Component {
 
 	constructor (options) {
-		super(new MessageChannel(getOption(options, 'host', location.host)));
+		super(new MessageChannel(getOption(options, 'host', location.host),
+			getOption(options, 'binary', true)));
 
 		if (getOption(options, 'components', true)) {
 			this._mixer = new Mixer(this);
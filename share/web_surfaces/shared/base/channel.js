@@ -16,32 +16,37 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
-import { Message } from './protocol.js';
+import { BINARY_PROTOCOL, Message } from './protocol.js';
 
 export default class MessageChannel {
 
-	constructor (host) {
+	constructor (host, binary) {
 		// https://developer.mozilla.org/en-US/docs/Web/API/URL/host
 		this._host = host;
+		this._binary = binary;
 		this._pending = null;
 	}
 
 	async open () {
 		return new Promise((resolve, reject) => {
-			this._socket = new WebSocket(`ws://${this._host}`);
+			if (this._binary) {
+				this._socket = new WebSocket(`ws://${this._host}`, BINARY_PROTOCOL);
+				this._socket.binaryType = 'arraybuffer';
+			} else {
+				this._socket = new WebSocket(`ws://${this._host}`);
+			}
 
 			this._socket.onclose = () => this.onClose();
 
 			this._socket.onerror = (error) => this.onError(error);
 
 			this._socket.onmessage = (event) => {
-				const msg = Message.fromJsonText(event.data);
-
-				if (this._pending && (this._pending.nodeAddrId == msg.nodeAddrId)) {
-					this._pending.resolve(msg);
-					this._pending = null;
+				if (typeof event.data === 'string') {
+					this._receive(Message.fromJsonText(event.data));
 				} else {
-					this.onMessage(msg, true);
+					for (const msg of Message.fromBinaryFrame(event.data)) {
+						this._receive(msg);
+					}
 				}
 			};
 
@@ -74,6 +79,15 @@ export default class MessageChannel {
 		});
 	}
 
+	_receive (msg) {
+		if (this._pending && (this._pending.nodeAddrId == msg.nodeAddrId)) {
+			this._pending.resolve(msg);
+			this._pending = null;
+		} else {
+			this.onMessage(msg, true);
+		}
+	}
+
 	onClose () {}
 	onError (error) {}
 	onMessage (msg, inbound) {}
@@ -34,6 +34,27 @@ export const StateNode = Object.freeze({
 	TRANSPORT_RECORD               : 'transport_record'
 });
 
+// Clients requesting this WebSocket subprotocol receive coalesced binary
+// frames, see libs/surfaces/websockets/message.cc for the format
+export const BINARY_PROTOCOL = 'ardour-binary';
+
+// Node indexes used by the binary format
+export const StateNodeIndex = Object.freeze([
+	StateNode.STRIP_DESCRIPTION,
+	StateNode.STRIP_METER,
+	StateNode.STRIP_GAIN,
+	StateNode.STRIP_PAN,
+	StateNode.STRIP_MUTE,
+	StateNode.STRIP_PLUGIN_DESCRIPTION,
+	StateNode.STRIP_PLUGIN_ENABLE,
+	StateNode.STRIP_PLUGIN_PARAM_DESCRIPTION,
+	StateNode.STRIP_PLUGIN_PARAM_VALUE,
+	StateNode.TRANSPORT_TEMPO,
+	StateNode.TRANSPORT_TIME,
+	StateNode.TRANSPORT_ROLL,
+	StateNode.TRANSPORT_RECORD
+]);
+
 export class Message {
 
 	constructor (node, addr, val) {
@@ -61,6 +82,59 @@ export class Message {
 		return new Message(rawMsg.node, rawMsg.addr || [], rawMsg.val);
 	}
 
+	static fromBinaryFrame (buffer) {
+		const view = new DataView(buffer);
+		const decoder = new TextDecoder();
+		const messages = [];
+		let offset = 0;
+
+		const count = view.getUint16(offset, true); offset += 2;
+
+		for (let i = 0; i < count; i++) {
+			const node = StateNodeIndex[view.getUint8(offset++)];
+
+			const addr = [];
+			const nAddr = view.getUint8(offset++);
+
+			for (let j = 0; j < nAddr; j++) {
+				addr.push(view.getUint32(offset, true));
+				offset += 4;
+			}
+
+			const val = [];
+			const nVal = view.getUint8(offset++);
+
+			for (let j = 0; j < nVal; j++) {
+				switch (view.getUint8(offset++)) {
+					case 1:
+						val.push(view.getUint8(offset++) != 0);
+						break;
+					case 2:
+						val.push(view.getInt32(offset, true));
+						offset += 4;
+						break;
+					case 3:
+						val.push(view.getFloat64(offset, true));
+						offset += 8;
+						break;
+					case 4: {
+						const len = view.getUint16(offset, true); offset += 2;
+						val.push(decoder.decode(new Uint8Array(buffer, offset, len)));
+						offset += len;
+						break;
+					}
+					default:
+						val.push(null);
+						break;
+				}
+			}
+
+			messages.push(new Message(node, addr, val));
+		}
+
+		return messages;
+	}
+
 	toJsonText () {
 		let val = [];
 